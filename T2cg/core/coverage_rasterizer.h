@@ -0,0 +1,339 @@
+/**
+ * @file coverage_rasterizer.h
+ * @brief Preenchimento antisserrilhado por cobertura analítica de área
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef COVERAGE_RASTERIZER_H
+#define COVERAGE_RASTERIZER_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "cpu_framebuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CoverageRasterizer
+ * @brief Calcula a fração exata de cada pixel coberta pelo polígono
+ *
+ * Cada aresta deposita, em um buffer de acumulação da linha, a área com
+ * sinal que ela varre em cada célula (pixel [x, x + 1] x [y, y + 1]); a soma
+ * prefixada ao longo da linha dá a cobertura. Só as células tocadas por
+ * arestas são percorridas pixel a pixel: entre elas a soma é constante e o
+ * trecho vira um span sólido (cobertura 1) ou é pulado (cobertura 0).
+ * Pixels parcialmente cobertos são misturados com o conteúdo do framebuffer.
+ * A opacidade da cor (alphaComponent) multiplica a cobertura; com cor
+ * translúcida os spans sólidos são compostos pelo kernel blendSpan.
+ * Em polígonos que se autointerceptam a cobertura dos pixels onde duas
+ * arestas se cruzam é aproximada (soma das áreas, não área da união).
+ */
+class CoverageRasterizer {
+private:
+    PolygonFillAlgorithm edgeTableBuilder;
+    CompactEdgeTable edgeTable;
+    std::vector<float> coverageAccumulator;              // Largura + 2 células
+    std::vector<std::pair<int, int> > touchedCells;      // Intervalos [início, fim] da linha atual
+
+    /**
+     * @brief Deposita a área de um trecho de aresta dentro da linha (0 <= x <= largura)
+     * @param y0 Início do trecho em Y relativo à linha, y0 < y1, ambos em [0, 1]
+     * @param windingDirection +1 se a aresta desce, -1 se sobe
+     */
+    void accumulateSegment(double x0, double y0, double x1, double y1, int windingDirection) {
+        float* accumulator = coverageAccumulator.data();
+        double signedHeight = (y1 - y0) * windingDirection;
+        double leftX = std::min(x0, x1);
+        double rightX = std::max(x0, x1);
+        
+        double leftFloor = std::floor(leftX);
+        int leftCell = static_cast<int>(leftFloor);
+        double rightCeil = std::ceil(rightX);
+        int rightCell = static_cast<int>(rightCeil);
+        
+        if (rightCell <= leftCell + 1) {
+            // Trecho dentro de uma célula: a área à direita vai para a célula seguinte
+            double middleFraction = 0.5 * (x0 + x1) - leftFloor;
+            accumulator[leftCell] += static_cast<float>(signedHeight * (1.0 - middleFraction));
+            accumulator[leftCell + 1] += static_cast<float>(signedHeight * middleFraction);
+            touchedCells.push_back(std::make_pair(leftCell, leftCell + 1));
+            return;
+        }
+        
+        double inverseWidth = 1.0 / (rightX - leftX);
+        double leftFraction = leftX - leftFloor;
+        double firstArea = 0.5 * inverseWidth * (1.0 - leftFraction) * (1.0 - leftFraction);
+        double rightFraction = rightX - rightCeil + 1.0;
+        double lastArea = 0.5 * inverseWidth * rightFraction * rightFraction;
+        
+        accumulator[leftCell] += static_cast<float>(signedHeight * firstArea);
+        if (rightCell == leftCell + 2) {
+            accumulator[leftCell + 1] += static_cast<float>(signedHeight * (1.0 - firstArea - lastArea));
+        } else {
+            double secondArea = inverseWidth * (1.5 - leftFraction);
+            accumulator[leftCell + 1] += static_cast<float>(signedHeight * (secondArea - firstArea));
+            for (int cell = leftCell + 2; cell < rightCell - 1; ++cell) {
+                accumulator[cell] += static_cast<float>(signedHeight * inverseWidth);
+            }
+            double coveredBeforeLast = secondArea + (rightCell - leftCell - 3) * inverseWidth;
+            accumulator[rightCell - 1] += static_cast<float>(signedHeight * (1.0 - coveredBeforeLast - lastArea));
+        }
+        accumulator[rightCell] += static_cast<float>(signedHeight * lastArea);
+        touchedCells.push_back(std::make_pair(leftCell, rightCell));
+    }
+
+    /**
+     * @brief Recorta o trecho em [0, largura] antes de acumular
+     *
+     * A parte à esquerda da janela vira um trecho vertical em x = 0 (mesma
+     * contribuição para todos os pixels visíveis); a parte à direita não
+     * afeta nenhum pixel visível e é descartada.
+     */
+    void accumulateClippedSegment(double topX, double bottomX, int windingDirection, int width) {
+        if (topX >= 0.0 && bottomX >= 0.0 && topX <= width && bottomX <= width) {
+            accumulateSegment(topX, 0.0, bottomX, 1.0, windingDirection);
+            return;
+        }
+        
+        double breakParameters[4] = { 0.0, 0.0, 0.0, 1.0 };
+        int breakCount = 1;
+        double deltaX = bottomX - topX;
+        
+        if (deltaX != 0.0) {
+            double leftCrossing = (0.0 - topX) / deltaX;
+            double rightCrossing = (width - topX) / deltaX;
+            if (leftCrossing > 0.0 && leftCrossing < 1.0) breakParameters[breakCount++] = leftCrossing;
+            if (rightCrossing > 0.0 && rightCrossing < 1.0) breakParameters[breakCount++] = rightCrossing;
+        }
+        breakParameters[breakCount++] = 1.0;
+        if (breakCount == 4 && breakParameters[1] > breakParameters[2]) {
+            std::swap(breakParameters[1], breakParameters[2]);
+        }
+        
+        for (int piece = 0; piece + 1 < breakCount; ++piece) {
+            double pieceTop = breakParameters[piece];
+            double pieceBottom = breakParameters[piece + 1];
+            double middleX = topX + deltaX * 0.5 * (pieceTop + pieceBottom);
+            
+            if (middleX >= width) {
+                continue;
+            }
+            
+            double pieceTopX = 0.0;
+            double pieceBottomX = 0.0;
+            if (middleX > 0.0) {
+                pieceTopX = std::min(std::max(topX + deltaX * pieceTop, 0.0), static_cast<double>(width));
+                pieceBottomX = std::min(std::max(topX + deltaX * pieceBottom, 0.0), static_cast<double>(width));
+            }
+            accumulateSegment(pieceTopX, pieceTop, pieceBottomX, pieceBottom, windingDirection);
+        }
+    }
+
+    /**
+     * @brief Converte a soma acumulada em cobertura conforme a regra de preenchimento
+     */
+    static float coverageFromWinding(float accumulatedWinding, FillRule fillRule) {
+        float magnitude = std::fabs(accumulatedWinding);
+        if (magnitude <= 1.0f || fillRule == FillRule::NONZERO) {
+            return std::min(magnitude, 1.0f);
+        }
+        
+        float folded = std::fmod(magnitude, 2.0f);
+        return (folded > 1.0f) ? 2.0f - folded : folded;
+    }
+
+    /**
+     * @brief Mistura a cor com o pixel existente na proporção da cobertura
+     */
+    template <typename PixelFormat>
+    static typename PixelFormat::PixelType blendPixel(typename PixelFormat::PixelType destinationPixel,
+                                                      const ColorRGB& fillColor, 
+                                                      float coverage) {
+        unsigned char destinationRGB[3];
+        PixelFormat::unpackRGB8(destinationPixel, destinationRGB);
+        
+        const float inverseScale = 1.0f / 255.0f;
+        float remaining = 1.0f - coverage;
+        ColorRGB blendedColor(fillColor.redComponent * coverage + destinationRGB[0] * inverseScale * remaining,
+                              fillColor.greenComponent * coverage + destinationRGB[1] * inverseScale * remaining,
+                              fillColor.blueComponent * coverage + destinationRGB[2] * inverseScale * remaining);
+        return PixelFormat::pack(blendedColor);
+    }
+
+    /**
+     * @brief Resolve a linha: spans sólidos entre arestas, mistura nas células tocadas
+     */
+    template <typename PixelFormat>
+    void resolveScanLine(int scanLine, 
+                         const ColorRGB& fillColor,
+                         typename PixelFormat::PixelType packedColor,
+                         const PremultipliedColor& premultipliedColor,
+                         FillRule fillRule,
+                         BasicCpuFramebuffer<PixelFormat>& framebuffer) {
+        const int width = framebuffer.getWidth();
+        const float opaqueThreshold = 1.0f - 1.0f / 512.0f;
+        const float emptyThreshold = 1.0f / 512.0f;
+        const float opacity = premultipliedColor.alphaComponent / 255.0f;
+        
+        // A AET é mantida ordenada, então os intervalos chegam quase em ordem
+        for (size_t cellIndex = 1; cellIndex < touchedCells.size(); ++cellIndex) {
+            std::pair<int, int> displacedCells = touchedCells[cellIndex];
+            size_t targetIndex = cellIndex;
+            while (targetIndex > 0 && displacedCells.first < touchedCells[targetIndex - 1].first) {
+                touchedCells[targetIndex] = touchedCells[targetIndex - 1];
+                targetIndex--;
+            }
+            touchedCells[targetIndex] = displacedCells;
+        }
+        
+        typename PixelFormat::PixelType* row = framebuffer.getRow(scanLine);
+        float* accumulator = coverageAccumulator.data();
+        float accumulatedWinding = 0.0f;
+        int nextPixel = 0;
+        size_t intervalIndex = 0;
+        
+        while (nextPixel < width) {
+            int intervalStart = width;
+            int intervalEnd = width;
+            if (intervalIndex < touchedCells.size()) {
+                intervalStart = touchedCells[intervalIndex].first;
+                intervalEnd = touchedCells[intervalIndex].second;
+                for (++intervalIndex; intervalIndex < touchedCells.size() && 
+                                      touchedCells[intervalIndex].first <= intervalEnd + 1; ++intervalIndex) {
+                    intervalEnd = std::max(intervalEnd, touchedCells[intervalIndex].second);
+                }
+            }
+            
+            // Entre arestas a cobertura é constante: interior vira um span sólido
+            int runEnd = std::min(intervalStart, width) - 1;
+            if (nextPixel <= runEnd && coverageFromWinding(accumulatedWinding, fillRule) >= opaqueThreshold) {
+                if (premultipliedColor.isOpaque()) {
+                    framebuffer.fillSpan(scanLine, nextPixel, runEnd, packedColor);
+                } else {
+                    framebuffer.blendSpan(scanLine, nextPixel, runEnd, premultipliedColor);
+                }
+            }
+            
+            for (int cell = intervalStart; cell <= intervalEnd && cell < width; ++cell) {
+                accumulatedWinding += accumulator[cell];
+                accumulator[cell] = 0.0f;
+                
+                float coverage = coverageFromWinding(accumulatedWinding, fillRule) * opacity;
+                if (coverage >= opaqueThreshold) {
+                    row[cell] = packedColor;
+                } else if (coverage > emptyThreshold) {
+                    row[cell] = blendPixel<PixelFormat>(row[cell], fillColor, coverage);
+                }
+            }
+            nextPixel = intervalEnd + 1;
+        }
+        
+        // Células além da última coluna só recebem depósitos descartáveis
+        accumulator[width] = 0.0f;
+        accumulator[width + 1] = 0.0f;
+        touchedCells.clear();
+    }
+
+public:
+    CoverageRasterizer() {}
+
+    /**
+     * @brief Preenche o polígono com antisserrilhamento no framebuffer
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param fillColor Cor do preenchimento (alphaComponent = opacidade)
+     * @param fillRule Regra de preenchimento (a cobertura é dobrada em EVEN_ODD)
+     * @param framebuffer Framebuffer de destino (pixels parciais são misturados)
+     */
+    template <typename PixelFormat>
+    void fillPolygon(const std::vector<Point2D>& polygonVertices, 
+                     const ColorRGB& fillColor,
+                     FillRule fillRule,
+                     BasicCpuFramebuffer<PixelFormat>& framebuffer) {
+        const int width = framebuffer.getWidth();
+        const int height = framebuffer.getHeight();
+        PremultipliedColor premultipliedColor = PremultipliedColor::fromColor(fillColor);
+        if (polygonVertices.size() < 3 || width <= 0 || height <= 0 || premultipliedColor.isTransparent()) {
+            return;
+        }
+        
+        edgeTable.clear();
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            if (currentVertex.coordinateY == nextVertex.coordinateY) {
+                continue;
+            }
+            
+            bool isDescending = currentVertex.coordinateY < nextVertex.coordinateY;
+            const Point2D& topVertex = isDescending ? currentVertex : nextVertex;
+            const Point2D& bottomVertex = isDescending ? nextVertex : currentVertex;
+            
+            int startScanLine = std::max(topVertex.coordinateY, 0);
+            if (startScanLine >= bottomVertex.coordinateY || startScanLine >= height) {
+                continue;
+            }
+            
+            // Vértices inteiros: cada aresta atravessa linhas inteiras, de y a y + 1
+            double inverseSlope = static_cast<double>(bottomVertex.coordinateX - topVertex.coordinateX) /
+                                  static_cast<double>(bottomVertex.coordinateY - topVertex.coordinateY);
+            double startX = topVertex.coordinateX + inverseSlope * (startScanLine - topVertex.coordinateY);
+            PolygonFillAlgorithm::appendCompactEdge(edgeTable, 
+                EdgeData(bottomVertex.coordinateY, startX, inverseSlope, startScanLine, isDescending ? 1 : -1));
+        }
+        
+        if (edgeTable.edges.empty()) {
+            return;
+        }
+        edgeTableBuilder.radixSortByMinimumY(edgeTable);
+        
+        coverageAccumulator.assign(static_cast<size_t>(width) + 2, 0.0f);
+        touchedCells.clear();
+        
+        typename PixelFormat::PixelType packedColor = BasicCpuFramebuffer<PixelFormat>::packColor(fillColor);
+        std::vector<EdgeData>& activeEdgeTable = edgeTable.activeEdges;
+        activeEdgeTable.clear();
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= height) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                edgeTableBuilder.insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                nextEdgeIndex++;
+            }
+            
+            for (EdgeData& edge : activeEdgeTable) {
+                double bottomX = edge.currentX + edge.inverseSlope;
+                accumulateClippedSegment(edge.currentX, bottomX, edge.windingDirection, width);
+                edge.currentX = bottomX;
+            }
+            edgeTableBuilder.restoreActiveEdgeOrder(activeEdgeTable);
+            
+            resolveScanLine(currentScanLine, fillColor, packedColor, premultipliedColor, fillRule, framebuffer);
+            
+            currentScanLine++;
+            
+            activeEdgeTable.erase(
+                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [currentScanLine](const EdgeData& edge) { 
+                        return edge.maximumY <= currentScanLine; 
+                    }),
+                activeEdgeTable.end()
+            );
+        }
+    }
+};
+
+#endif // COVERAGE_RASTERIZER_H
@@ -0,0 +1,257 @@
+/**
+ * @file cpu_framebuffer.h
+ * @brief Framebuffer em memória para rasterização sem contexto OpenGL
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef CPU_FRAMEBUFFER_H
+#define CPU_FRAMEBUFFER_H
+
+#include "data_structures.h"
+#include "pixel_formats.h"
+#include "span_fill_kernels.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class BasicCpuFramebuffer
+ * @brief Buffer de pixels no formato PixelFormat (ver pixel_formats.h)
+ *
+ * A linha 0 corresponde à scanline 0, a mesma convenção da projeção 2D
+ * usada no editor (origem no canto superior esquerdo).
+ */
+template <typename PixelFormat>
+class BasicCpuFramebuffer {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+
+private:
+    int bufferWidth;
+    int bufferHeight;
+    std::vector<PixelType> pixels;
+
+public:
+    BasicCpuFramebuffer(int width = 0, int height = 0) : bufferWidth(0), bufferHeight(0) {
+        resize(width, height);
+    }
+
+    /**
+     * @brief Converte uma cor (componentes de 0.0 a 1.0) para o formato do buffer
+     * @param color Cor a ser convertida
+     * @return Pixel empacotado
+     */
+    static PixelType packColor(const ColorRGB& color) {
+        return PixelFormat::pack(color);
+    }
+
+    /**
+     * @brief Redimensiona o buffer (o conteúdo é descartado)
+     */
+    void resize(int width, int height) {
+        bufferWidth = std::max(0, width);
+        bufferHeight = std::max(0, height);
+        pixels.assign(static_cast<size_t>(bufferWidth) * bufferHeight, PixelType(0));
+    }
+
+    /**
+     * @brief Preenche todo o buffer com uma cor
+     */
+    void clear(const ColorRGB& color) {
+        SpanFillKernels::fill(pixels.data(), pixels.size(), packColor(color));
+    }
+
+    int getWidth() const {
+        return bufferWidth;
+    }
+
+    int getHeight() const {
+        return bufferHeight;
+    }
+
+    PixelType* getRow(int scanLine) {
+        return pixels.data() + static_cast<size_t>(scanLine) * bufferWidth;
+    }
+
+    const PixelType* getRow(int scanLine) const {
+        return pixels.data() + static_cast<size_t>(scanLine) * bufferWidth;
+    }
+
+    PixelType getPixel(int x, int y) const {
+        return pixels[static_cast<size_t>(y) * bufferWidth + x];
+    }
+
+    const std::vector<PixelType>& getPixels() const {
+        return pixels;
+    }
+
+    /**
+     * @brief Componente 0.0 - 1.0 em ponto fixo 16.16 na escala 0 - 255 (já com o +0.5 do arredondamento)
+     */
+    static std::int32_t toFixedChannel(float component) {
+        float clamped = std::min(1.0f, std::max(0.0f, component));
+        return std::min(static_cast<std::int32_t>((clamped * 255.0f + 0.5f) * 65536.0f), (256 << 16) - 1);
+    }
+
+    /**
+     * @brief Preenche o intervalo [startX, endX] de uma scanline com um pixel já empacotado
+     */
+    void fillSpan(int scanLine, int startX, int endX, PixelType packedColor) {
+        SpanFillKernels::fill(getRow(scanLine) + startX, static_cast<size_t>(endX - startX + 1), packedColor);
+    }
+
+    /**
+     * @brief Compõe uma cor translúcida pré-multiplicada sobre o intervalo [startX, endX] de uma scanline
+     */
+    void blendSpan(int scanLine, int startX, int endX, const PremultipliedColor& color) {
+        PixelFormat::blendSpan(getRow(scanLine) + startX, static_cast<size_t>(endX - startX + 1), color);
+    }
+
+    /**
+     * @brief Preenche [startX, endX] interpolando linearmente de startColor (em startX) até endColor (em endX)
+     *
+     * As cores das pontas são convertidas para ponto fixo 16.16 e o passo por
+     * pixel é calculado uma vez; a escrita é feita pelo kernel do formato.
+     */
+    void fillInterpolatedSpan(int scanLine, int startX, int endX, 
+                              const ColorRGB& startColor, const ColorRGB& endColor) {
+        const float startComponents[3] = { startColor.redComponent, startColor.greenComponent, startColor.blueComponent };
+        const float endComponents[3] = { endColor.redComponent, endColor.greenComponent, endColor.blueComponent };
+        std::int32_t startRGB[3];
+        std::int32_t stepRGB[3];
+        size_t pixelCount = static_cast<size_t>(endX - startX + 1);
+        
+        for (int channel = 0; channel < 3; ++channel) {
+            std::int32_t startValue = toFixedChannel(startComponents[channel]);
+            std::int32_t endValue = toFixedChannel(endComponents[channel]);
+            startRGB[channel] = startValue;
+            // Truncar o passo mantém todos os valores entre as duas pontas
+            stepRGB[channel] = pixelCount > 1 
+                ? static_cast<std::int32_t>((static_cast<std::int64_t>(endValue) - startValue) / 
+                                            static_cast<std::int64_t>(pixelCount - 1))
+                : 0;
+        }
+        
+        PixelFormat::fillInterpolated(getRow(scanLine) + startX, pixelCount, startRGB, stepRGB);
+    }
+
+    /**
+     * @brief Salva o buffer em formato PPM binário (P6), útil para inspeção headless
+     * @param filePath Caminho do arquivo de saída
+     * @return true se o arquivo foi escrito
+     */
+    bool writePPM(const std::string& filePath) const {
+        std::ofstream output(filePath, std::ios::binary);
+        if (!output) {
+            return false;
+        }
+        
+        output << "P6\n" << bufferWidth << " " << bufferHeight << "\n255\n";
+        for (PixelType pixel : pixels) {
+            unsigned char rgb[3];
+            PixelFormat::unpackRGB8(pixel, rgb);
+            output.write(reinterpret_cast<const char*>(rgb), 3);
+        }
+        
+        return static_cast<bool>(output);
+    }
+};
+
+typedef BasicCpuFramebuffer<PixelFormatRGBA8> CpuFramebuffer;
+typedef BasicCpuFramebuffer<PixelFormatBGRA8> CpuFramebufferBGRA8;
+typedef BasicCpuFramebuffer<PixelFormatRGB565> CpuFramebufferRGB565;
+typedef BasicCpuFramebuffer<PixelFormatIndexed8> CpuFramebufferIndexed8;
+
+/**
+ * @class BasicFramebufferSpanSink
+ * @brief Destino de spans que escreve em um BasicCpuFramebuffer
+ *
+ * A conversão ColorRGB -> PixelType é feita apenas quando a cor muda, ou seja,
+ * uma vez por polígono na prática; cada span vira uma chamada ao kernel de
+ * preenchimento do formato.
+ *
+ * Cores translúcidas (alphaComponent < 1) são compostas em alpha
+ * pré-multiplicado pelo kernel blendSpan do formato; spans opacos continuam
+ * no preenchimento direto, sem ler o destino, e alpha 0 não escreve nada.
+ */
+template <typename PixelFormat>
+class BasicFramebufferSpanSink {
+private:
+    BasicCpuFramebuffer<PixelFormat>& framebuffer;
+    ColorRGB currentColor;
+    typename PixelFormat::PixelType packedColor;
+    PremultipliedColor premultipliedColor;
+    bool hasCurrentColor;
+
+public:
+    explicit BasicFramebufferSpanSink(BasicCpuFramebuffer<PixelFormat>& target)
+        : framebuffer(target), packedColor(0), premultipliedColor(PremultipliedColor::fromColor(ColorRGB())),
+          hasCurrentColor(false) {}
+
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB& color) {
+        if (scanLine < 0 || scanLine >= framebuffer.getHeight()) {
+            return;
+        }
+        
+        startX = std::max(startX, 0);
+        endX = std::min(endX, framebuffer.getWidth() - 1);
+        if (startX > endX) {
+            return;
+        }
+        
+        if (!hasCurrentColor || color != currentColor) {
+            packedColor = PixelFormat::pack(color);
+            premultipliedColor = PremultipliedColor::fromColor(color);
+            currentColor = color;
+            hasCurrentColor = true;
+        }
+        
+        if (premultipliedColor.isOpaque()) {
+            framebuffer.fillSpan(scanLine, startX, endX, packedColor);
+        } else if (!premultipliedColor.isTransparent()) {
+            framebuffer.blendSpan(scanLine, startX, endX, premultipliedColor);
+        }
+    }
+
+    /**
+     * @brief Span com cor interpolada (Gouraud) de startColor em startX até endColor em endX
+     *
+     * Sempre opaco: o alpha das cores de vértice é ignorado neste caminho.
+     */
+    void emitShadedSpan(int scanLine, int startX, int endX, 
+                        const ColorRGB& startColor, const ColorRGB& endColor) {
+        if (scanLine < 0 || scanLine >= framebuffer.getHeight()) {
+            return;
+        }
+        
+        int clippedStartX = std::max(startX, 0);
+        int clippedEndX = std::min(endX, framebuffer.getWidth() - 1);
+        if (clippedStartX > clippedEndX) {
+            return;
+        }
+        
+        if (clippedStartX == startX && clippedEndX == endX) {
+            framebuffer.fillInterpolatedSpan(scanLine, startX, endX, startColor, endColor);
+            return;
+        }
+        
+        // Recorte: reamostra as cores nas novas pontas
+        float spanLength = static_cast<float>(std::max(endX - startX, 1));
+        float startWeight = (clippedStartX - startX) / spanLength;
+        float endWeight = (clippedEndX - startX) / spanLength;
+        framebuffer.fillInterpolatedSpan(scanLine, clippedStartX, clippedEndX,
+            ColorRGB(startColor.redComponent + (endColor.redComponent - startColor.redComponent) * startWeight,
+                     startColor.greenComponent + (endColor.greenComponent - startColor.greenComponent) * startWeight,
+                     startColor.blueComponent + (endColor.blueComponent - startColor.blueComponent) * startWeight),
+            ColorRGB(startColor.redComponent + (endColor.redComponent - startColor.redComponent) * endWeight,
+                     startColor.greenComponent + (endColor.greenComponent - startColor.greenComponent) * endWeight,
+                     startColor.blueComponent + (endColor.blueComponent - startColor.blueComponent) * endWeight));
+    }
+};
+
+typedef BasicFramebufferSpanSink<PixelFormatRGBA8> FramebufferSpanSink;
+
+#endif // CPU_FRAMEBUFFER_H
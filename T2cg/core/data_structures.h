@@ -9,8 +9,17 @@
 #define DATA_STRUCTURES_H
 
 #include <vector>
+#include <string>
 #include <iostream>
+#include <cmath>
+
+#ifdef _WIN32
 #include <windows.h>
+#else
+// Fora do Windows (render headless) emulamos o COLORREF da WinAPI
+typedef unsigned long COLORREF;
+#define RGB(r, g, b) ((COLORREF)(((unsigned char)(r)) | (((unsigned long)(unsigned char)(g)) << 8) | (((unsigned long)(unsigned char)(b)) << 16)))
+#endif
 
 const int WINDOW_WIDTH = 1000;
 const int WINDOW_HEIGHT = 700;
@@ -112,6 +121,47 @@ struct Point2D {
     }
 };
 
+/**
+ * @struct SubpixelPoint2D
+ * @brief Ponto 2D em ponto fixo 24.8 (coordenadas em 1/256 de pixel)
+ *
+ * Guarda geometria importada sem arredondá-la para o pixel. O ponto inteiro
+ * (x, y) vale (x * 256, y * 256), então um polígono de Point2D convertido
+ * gera exatamente os mesmos spans no modo INTEGER_DDA.
+ */
+struct SubpixelPoint2D {
+    static const int FRACTION_BITS = 8;
+    static const int ONE_PIXEL = 1 << FRACTION_BITS;
+
+    int fixedX;
+    int fixedY;
+
+    SubpixelPoint2D(int x = 0, int y = 0) : fixedX(x), fixedY(y) {}
+
+    static SubpixelPoint2D fromPixel(const Point2D& point) {
+        return SubpixelPoint2D(point.coordinateX * ONE_PIXEL, point.coordinateY * ONE_PIXEL);
+    }
+
+    /**
+     * @brief Converte coordenadas em pixels, arredondando para o 1/256 mais próximo
+     */
+    static SubpixelPoint2D fromCoordinates(double x, double y) {
+        return SubpixelPoint2D(static_cast<int>(std::lround(x * ONE_PIXEL)),
+                               static_cast<int>(std::lround(y * ONE_PIXEL)));
+    }
+
+    /**
+     * @brief Pixel inteiro mais próximo (para contorno, seleção e operações em Point2D)
+     */
+    Point2D toNearestPixel() const {
+        return Point2D((fixedX + ONE_PIXEL / 2) >> FRACTION_BITS, (fixedY + ONE_PIXEL / 2) >> FRACTION_BITS);
+    }
+
+    bool operator==(const SubpixelPoint2D& other) const {
+        return fixedX == other.fixedX && fixedY == other.fixedY;
+    }
+};
+
 /**
  * @struct EdgeData
  * @brief Dados de uma aresta para o algoritmo de preenchimento ET/AET
@@ -121,25 +171,224 @@ struct EdgeData {
     double currentX;
     double inverseSlope;
     int minimumY;
+    int windingDirection;    // +1 se a aresta desce na ordem dos vértices, -1 se sobe, 0 se horizontal
+
+    EdgeData(int maxY, double currentXPos, double invSlope, int minY, int winding = 1) 
+        : maximumY(maxY), currentX(currentXPos), inverseSlope(invSlope), minimumY(minY), windingDirection(winding) {}
+};
+
+/**
+ * @struct ShadedEdgeData
+ * @brief Aresta com cor interpolada (Gouraud 2D): a cor avança junto com currentX
+ *
+ * As componentes são guardadas na escala 0.0 - 1.0, com o incremento por
+ * scanline calculado uma vez na construção da ET.
+ */
+struct ShadedEdgeData : public EdgeData {
+    double currentRed;
+    double currentGreen;
+    double currentBlue;
+    double redStep;
+    double greenStep;
+    double blueStep;
+
+    ShadedEdgeData(const EdgeData& edge, double red, double green, double blue,
+                   double redIncrement, double greenIncrement, double blueIncrement)
+        : EdgeData(edge), currentRed(red), currentGreen(green), currentBlue(blue),
+          redStep(redIncrement), greenStep(greenIncrement), blueStep(blueIncrement) {}
 
-    EdgeData(int maxY, double currentXPos, double invSlope, int minY) 
-        : maximumY(maxY), currentX(currentXPos), inverseSlope(invSlope), minimumY(minY) {}
+    /**
+     * @brief Avança x e a cor para a próxima scanline
+     */
+    void advance() {
+        currentX += inverseSlope;
+        currentRed += redStep;
+        currentGreen += greenStep;
+        currentBlue += blueStep;
+    }
 };
 
 typedef std::vector<std::vector<EdgeData>> EdgeTable;
 
+/**
+ * @struct EdgeSegment
+ * @brief Aresta não horizontal orientada de cima para baixo (topVertex.y < bottomVertex.y)
+ */
+struct EdgeSegment {
+    Point2D topVertex;
+    Point2D bottomVertex;
+    int windingDirection;    // +1 se o polígono percorre a aresta de cima para baixo, -1 caso contrário
+
+    EdgeSegment(const Point2D& top, const Point2D& bottom, int winding = 1) 
+        : topVertex(top), bottomVertex(bottom), windingDirection(winding) {}
+};
+
+/**
+ * @struct SubpixelEdgeSegment
+ * @brief Versão 24.8 de EdgeSegment (topVertex.fixedY < bottomVertex.fixedY)
+ */
+struct SubpixelEdgeSegment {
+    SubpixelPoint2D topVertex;
+    SubpixelPoint2D bottomVertex;
+    int windingDirection;
+
+    SubpixelEdgeSegment(const SubpixelPoint2D& top, const SubpixelPoint2D& bottom, int winding = 1) 
+        : topVertex(top), bottomVertex(bottom), windingDirection(winding) {}
+};
+
+/**
+ * @struct FixedEdgeData
+ * @brief Aresta com avanço inteiro (DDA de Bresenham: parte inteira + acumulador de erro)
+ *
+ * A interseção exata da aresta com o centro da scanline (y + 0.5), deslocada
+ * de meio pixel, vale N / D com D = 2 * dy. Guardamos currentX = ceil(N / D)
+ * (o primeiro centro de pixel à direita da aresta, inclusive) e a folga
+ * errorTerm = currentX * D - N, sempre em [0, D). Todo o avanço é inteiro,
+ * portanto os spans são reproduzíveis em qualquer compilador.
+ */
+struct FixedEdgeData {
+    int maximumY;
+    int currentX;
+    int errorTerm;
+    int stepWhole;
+    int stepError;
+    int errorDenominator;
+    int minimumY;
+    int windingDirection;    // +1 se a aresta desce na ordem dos vértices, -1 se sobe
+
+    FixedEdgeData(int maxY, int startX, int error, int whole, int stepErr, int denominator, int minY, int winding = 1)
+        : maximumY(maxY), currentX(startX), errorTerm(error), stepWhole(whole),
+          stepError(stepErr), errorDenominator(denominator), minimumY(minY), windingDirection(winding) {}
+
+    /**
+     * @brief Avança a aresta para a próxima scanline
+     */
+    void advance() {
+        currentX += stepWhole;
+        errorTerm -= stepError;
+        
+        // Sem desvio: borrow = -1 quando o erro ficou negativo, 0 caso contrário
+        int borrow = errorTerm >> 31;
+        currentX -= borrow;
+        errorTerm += errorDenominator & borrow;
+    }
+};
+
+/**
+ * @enum ActiveEdgeOrdering
+ * @brief Estratégia para manter a AET ordenada por currentX
+ */
+enum class ActiveEdgeOrdering {
+    FULL_SORT,              // std::sort completo a cada scanline
+    INCREMENTAL_INSERTION   // Inserção ordenada + passada de bolha local após o avanço
+};
+
+/**
+ * @enum FillRule
+ * @brief Regra que decide quais regiões entre arestas são interiores
+ */
+enum class FillRule {
+    EVEN_ODD,   // Interior quando o número de arestas cruzadas é ímpar
+    NONZERO     // Interior quando a soma das direções (+1/-1) das arestas cruzadas é diferente de zero
+};
+
+/**
+ * @enum EdgeSteppingMode
+ * @brief Representação usada para avançar as arestas entre scanlines
+ */
+enum class EdgeSteppingMode {
+    FLOATING_POINT,   // EdgeData: currentX/inverseSlope em double, arredondamento +0.5
+    INTEGER_DDA       // FixedEdgeData: amostragem exata no centro do pixel
+};
+
+/**
+ * @enum ActiveEdgeLayout
+ * @brief Organização da AET na memória
+ */
+enum class ActiveEdgeLayout {
+    ARRAY_OF_STRUCTURES,    // std::vector<EdgeData>
+    STRUCTURE_OF_ARRAYS     // Faixas separadas x / inclinação / maximumY, avanço em SIMD
+};
+
+/**
+ * @enum BooleanOperation
+ * @brief Operação booleana entre dois polígonos (regiões pela regra par-ímpar)
+ */
+enum class BooleanOperation {
+    UNION,          // A ou B
+    INTERSECTION,   // A e B
+    DIFFERENCE,     // A e não B
+    XOR             // Exatamente um dos dois
+};
+
+/**
+ * @enum SimplificationMethod
+ * @brief Algoritmo que ordena os vértices por importância nos níveis de detalhe
+ */
+enum class SimplificationMethod {
+    DOUGLAS_PEUCKER,      // Distância ao segmento que o vértice divide (tolerância em pixels)
+    VISVALINGAM_WHYATT    // Área efetiva do triângulo com os vizinhos (tolerância^2 em pixels^2)
+};
+
+/**
+ * @struct BasicCompactEdgeTable
+ * @brief ET contígua: arestas em um único vetor, ordenadas por minimumY
+ *
+ * Cobre apenas a extensão Y do polígono ([firstScanLine, lastScanLine]),
+ * em vez de um vetor por scanline da janela como EdgeTable.
+ */
+template <typename Edge>
+struct BasicCompactEdgeTable {
+    std::vector<Edge> edges;
+    std::vector<Edge> sortScratch;
+    std::vector<Edge> activeEdges;    // Armazenamento da AET, reaproveitado entre varreduras
+    int firstScanLine;
+    int lastScanLine;
+
+    BasicCompactEdgeTable() : firstScanLine(0), lastScanLine(-1) {}
+
+    void clear() {
+        edges.clear();
+        firstScanLine = 0;
+        lastScanLine = -1;
+    }
+};
+
+typedef BasicCompactEdgeTable<EdgeData> CompactEdgeTable;
+typedef BasicCompactEdgeTable<FixedEdgeData> FixedCompactEdgeTable;
+
 /**
  * @struct ColorRGB
  * @brief Representa uma cor RGB com componentes de 0.0 a 1.0
+ *
+ * alphaComponent é a opacidade (1.0 = opaco, o padrão). As componentes RGB
+ * não são pré-multiplicadas; a pré-multiplicação é feita na composição.
  */
 struct ColorRGB {
     float redComponent;
     float greenComponent;
     float blueComponent;
+    float alphaComponent;
     
-    ColorRGB() : redComponent(1.0f), greenComponent(1.0f), blueComponent(1.0f) {}
+    ColorRGB() : redComponent(1.0f), greenComponent(1.0f), blueComponent(1.0f), alphaComponent(1.0f) {}
     
-    ColorRGB(float r, float g, float b) : redComponent(r), greenComponent(g), blueComponent(b) {}
+    ColorRGB(float r, float g, float b, float a = 1.0f) 
+        : redComponent(r), greenComponent(g), blueComponent(b), alphaComponent(a) {}
+    
+    bool isOpaque() const {
+        return alphaComponent >= 1.0f;
+    }
+    
+    bool operator==(const ColorRGB& other) const {
+        return redComponent == other.redComponent &&
+               greenComponent == other.greenComponent &&
+               blueComponent == other.blueComponent &&
+               alphaComponent == other.alphaComponent;
+    }
+    
+    bool operator!=(const ColorRGB& other) const {
+        return !(*this == other);
+    }
 };
 
 /**
@@ -181,6 +430,17 @@ struct PolygonConfiguration {
           lineThickness(2.0f),
           showVertices(true),
           selectedColorIndex(12) {}
+    
+    /**
+     * @brief Opacidade do preenchimento (0.0 - 1.0), guardada no alpha de fillColor
+     */
+    float getFillOpacity() const {
+        return fillColor.alphaComponent;
+    }
+    
+    void setFillOpacity(float opacity) {
+        fillColor.alphaComponent = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
+    }
 };
 
 #endif // DATA_STRUCTURES_H
\ No newline at end of file
@@ -66,7 +66,11 @@ public:
         
         // Área de desenho
         if (mouseX < windowDimensions->drawingAreaWidth && mouseY < windowDimensions->drawingAreaHeight) {
-            if (!isRightButton) {
+            if (!isRightButton && (glutGetModifiers() & GLUT_ACTIVE_CTRL)) {
+                // Ctrl + clique seleciona o polígono salvo preenchido sob o cursor
+                polygonManager->selectSavedPolygon(
+                    graphicsRenderer->findSavedPolygonAt(polygonManager->getSavedPolygons(), mouseX, mouseY));
+            } else if (!isRightButton) {
                 Point2D newVertex(mouseX, mouseY);
                 polygonManager->addVertex(newVertex);
                 *currentApplicationState = ApplicationState::DRAWING_POLYGON;
@@ -107,6 +111,12 @@ public:
             case '-':
                 polygonManager->adjustLineThickness(false);
                 break;
+            case ']':
+                polygonManager->adjustFillOpacity(true);
+                break;
+            case '[':
+                polygonManager->adjustFillOpacity(false);
+                break;
             case '1': case '2': case '3': case '4': case '5': case '6':
                 polygonManager->applyPresetFillColor(keyCode - '0');
                 break;
@@ -119,11 +129,55 @@ public:
                 } else {
                 }
                 break;
+            case 'k': case 'K':
+                // Salva o polígono dividido nas peças simples da sua região
+                if (polygonManager->canBeFilled()) {
+                    bool isFilled = (*currentApplicationState == ApplicationState::POLYGON_FILLED);
+                    polygonManager->saveCurrentPolygonAsSimplePieces(isFilled);
+                    polygonManager->clearPolygon();
+                    *currentApplicationState = ApplicationState::DRAWING_POLYGON;
+                }
+                break;
+            case 'l': case 'L':
+                cycleOutlineSimplification();
+                break;
+            case 'u': case 'U':
+                combineLastSavedPolygons(BooleanOperation::UNION);
+                break;
+            case 'i': case 'I':
+                combineLastSavedPolygons(BooleanOperation::INTERSECTION);
+                break;
+            case 'd': case 'D':
+                combineLastSavedPolygons(BooleanOperation::DIFFERENCE);
+                break;
+            case 'x': case 'X':
+                combineLastSavedPolygons(BooleanOperation::XOR);
+                break;
         }
         
         glutPostRedisplay();
     }
 
+    /**
+     * @brief Aplica a operação aos dois últimos polígonos salvos (penúltimo op último)
+     */
+    void combineLastSavedPolygons(BooleanOperation booleanOperation) {
+        size_t savedCount = polygonManager->getSavedPolygonCount();
+        if (savedCount >= 2) {
+            polygonManager->combineSavedPolygons(savedCount - 2, savedCount - 1, booleanOperation);
+        }
+    }
+
+    /**
+     * @brief Alterna a tolerância dos contornos salvos: 0.5 px, 2 px, 8 px, desligada
+     */
+    void cycleOutlineSimplification() {
+        double tolerance = graphicsRenderer->getOutlineTolerance();
+        double nextTolerance = (tolerance <= 0.0) ? 0.5 : (tolerance >= 8.0 ? 0.0 : tolerance * 4.0);
+        graphicsRenderer->setSimplification(graphicsRenderer->getSimplificationMethod(), nextTolerance,
+                                            graphicsRenderer->getFillTolerance());
+    }
+
     void renderInterface() {
         // Interface removida - agora usamos apenas controles do teclado
     }
@@ -0,0 +1,1662 @@
+/**
+ * @file fill_benchmark.h
+ * @brief Benchmarks do preenchimento ET/AET (executados sem contexto OpenGL)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef FILL_BENCHMARK_H
+#define FILL_BENCHMARK_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "cpu_framebuffer.h"
+#include "graphics_renderer.h"
+#include "parallel_fill.h"
+#include "polygon_boolean.h"
+#include "self_intersection.h"
+#include "polygon_simplification.h"
+#include "polygon_manager.h"
+#include "polygon_raster_cache.h"
+#include "polygon_span_mask.h"
+#include "software_renderer.h"
+#include "span_shaders.h"
+#include "sweep_renderer.h"
+#include "tile_rasterizer.h"
+#include "trapezoid_sweep.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class SpanCountingSink
+ * @brief Destino de spans que apenas contabiliza spans e pixels
+ *
+ * Isola o custo da ET/AET do custo de escrita dos pixels.
+ */
+class SpanCountingSink {
+public:
+    std::uint64_t spanCount;
+    std::uint64_t pixelCount;
+
+    SpanCountingSink() : spanCount(0), pixelCount(0) {}
+
+    void emitSpan(int, int startX, int endX, const ColorRGB&) {
+        spanCount++;
+        pixelCount += static_cast<std::uint64_t>(endX - startX + 1);
+    }
+};
+
+/**
+ * @class SpanChecksumSink
+ * @brief Destino de spans que resume a sequência emitida em um hash (para comparar saídas)
+ */
+class SpanChecksumSink {
+public:
+    std::uint64_t checksum;
+
+    SpanChecksumSink() : checksum(1469598103934665603ULL) {}
+
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+        for (int value : {scanLine, startX, endX}) {
+            checksum = (checksum ^ static_cast<std::uint32_t>(value)) * 1099511628211ULL;
+        }
+    }
+};
+
+/**
+ * @class TrapezoidCountingSink
+ * @brief Destino de trapézios que apenas contabiliza trapézios e scanlines cobertas
+ */
+class TrapezoidCountingSink {
+public:
+    std::uint64_t trapezoidCount;
+    std::uint64_t scanLineCount;
+
+    TrapezoidCountingSink() : trapezoidCount(0), scanLineCount(0) {}
+
+    void emitTrapezoid(const ScanlineTrapezoid& trapezoid, const ColorRGB&) {
+        trapezoidCount++;
+        scanLineCount += static_cast<std::uint64_t>(trapezoid.getScanLineCount());
+    }
+};
+
+/**
+ * @class CoverageMaskSink
+ * @brief Destino de spans que liga um bit em uma máscara de um byte por pixel (referência para comparar saídas)
+ */
+class CoverageMaskSink {
+public:
+    std::vector<unsigned char>& mask;
+    int width;
+    unsigned char bit;
+
+    CoverageMaskSink(std::vector<unsigned char>& target, int maskWidth, unsigned char maskBit)
+        : mask(target), width(maskWidth), bit(maskBit) {}
+
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+        unsigned char* rowPixels = mask.data() + static_cast<size_t>(scanLine) * width;
+        for (int x = startX; x <= endX; ++x) {
+            rowPixels[x] |= bit;
+        }
+    }
+};
+
+/**
+ * @class PolygonFillBenchmark
+ * @brief Gera polígonos de teste (estrela, espiral) e mede variantes do preenchimento
+ */
+class PolygonFillBenchmark {
+private:
+    int canvasWidth;
+    int canvasHeight;
+    int iterations;
+
+public:
+    PolygonFillBenchmark(int width = 4096, int height = 4096, int repeatCount = 20)
+        : canvasWidth(width), canvasHeight(height), iterations(repeatCount) {}
+
+    /**
+     * @brief Estrela com pontas alternando entre dois raios
+     * @param pointCount Número de pontas (o polígono terá 2 * pointCount vértices)
+     */
+    static std::vector<Point2D> makeStarPolygon(int pointCount, int centerX, int centerY,
+                                                int outerRadius, int innerRadius) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(pointCount) * 2);
+        
+        const double pi = 3.14159265358979323846;
+        for (int vertexIndex = 0; vertexIndex < pointCount * 2; ++vertexIndex) {
+            double angle = pi * vertexIndex / pointCount;
+            int radius = (vertexIndex % 2 == 0) ? outerRadius : innerRadius;
+            vertices.push_back(Point2D(centerX + static_cast<int>(std::lround(radius * std::cos(angle))),
+                                       centerY + static_cast<int>(std::lround(radius * std::sin(angle)))));
+        }
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Faixa em espiral (borda externa seguida da interna em ordem reversa)
+     * @param vertexCount Número total de vértices
+     * @param turns Número de voltas da espiral
+     */
+    static std::vector<Point2D> makeSpiralPolygon(int vertexCount, int centerX, int centerY,
+                                                  int maxRadius, int turns) {
+        std::vector<Point2D> vertices;
+        int samplesPerSide = std::max(2, vertexCount / 2);
+        vertices.reserve(static_cast<size_t>(samplesPerSide) * 2);
+        
+        const double pi = 3.14159265358979323846;
+        double totalAngle = 2.0 * pi * turns;
+        double bandWidth = 0.4 * maxRadius / turns;
+        
+        for (int side = 0; side < 2; ++side) {
+            for (int sampleIndex = 0; sampleIndex < samplesPerSide; ++sampleIndex) {
+                int step = (side == 0) ? sampleIndex : samplesPerSide - 1 - sampleIndex;
+                double t = static_cast<double>(step) / (samplesPerSide - 1);
+                double angle = t * totalAngle;
+                double radius = t * maxRadius - (side == 0 ? 0.0 : bandWidth);
+                radius = std::max(radius, 0.0);
+                vertices.push_back(Point2D(centerX + static_cast<int>(std::lround(radius * std::cos(angle))),
+                                           centerY + static_cast<int>(std::lround(radius * std::sin(angle)))));
+            }
+        }
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Pente inclinado: toothCount dentes, com 2 * toothCount arestas ativas ao mesmo tempo
+     *
+     * Simula as formas de hachura e contorno com centenas de arestas ativas.
+     */
+    static std::vector<Point2D> makeHatchPolygon(int toothCount, int left, int top, int width, int height) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(toothCount) * 4 + 2);
+        
+        int bottom = top + height;
+        int baseTop = bottom - std::max(2, height / 20);
+        double toothPitch = static_cast<double>(width) / toothCount;
+        int slant = std::max(1, static_cast<int>(toothPitch));
+        
+        vertices.push_back(Point2D(left, bottom));
+        for (int toothIndex = 0; toothIndex < toothCount; ++toothIndex) {
+            int toothLeft = left + static_cast<int>(toothIndex * toothPitch);
+            int toothRight = left + static_cast<int>((toothIndex + 0.5) * toothPitch);
+            vertices.push_back(Point2D(toothLeft, baseTop));
+            vertices.push_back(Point2D(toothLeft + slant, top));
+            vertices.push_back(Point2D(toothRight + slant, top));
+            vertices.push_back(Point2D(toothRight, baseTop));
+        }
+        vertices.push_back(Point2D(left + width, bottom));
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Contorno irregular estilo SIG: raio modulado por uma soma de senoides
+     * @param vertexCount Número de vértices
+     */
+    static std::vector<Point2D> makeCoastlinePolygon(int vertexCount, int centerX, int centerY,
+                                                     int radiusX, int radiusY) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(vertexCount));
+        
+        const double pi = 3.14159265358979323846;
+        for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+            double angle = 2.0 * pi * vertexIndex / vertexCount;
+            double modulation = 0.75 + 0.12 * std::sin(7.0 * angle) + 0.08 * std::sin(53.0 * angle + 1.3) +
+                                0.002 * std::sin(vertexIndex * 2.399963);
+            vertices.push_back(Point2D(centerX + static_cast<int>(std::lround(radiusX * modulation * std::cos(angle))),
+                                       centerY + static_cast<int>(std::lround(radiusY * modulation * std::sin(angle)))));
+        }
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Cena com muitos polígonos salvos (estrelas pequenas sobrepostas, cores variadas)
+     */
+    static std::vector<PolygonManager::SavedPolygon> makeSavedPolygonScene(int polygonCount, int width, int height) {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons;
+        savedPolygons.reserve(static_cast<size_t>(polygonCount));
+        
+        unsigned int seed = 12345u;
+        auto nextRandom = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int>(seed >> 8);
+        };
+        
+        for (int polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex) {
+            int radius = 20 + nextRandom() % 120;
+            PolygonConfiguration configuration;
+            configuration.fillColor = ColorRGB((nextRandom() % 256) / 255.0f, (nextRandom() % 256) / 255.0f,
+                                               (nextRandom() % 256) / 255.0f);
+            savedPolygons.push_back(PolygonManager::SavedPolygon(
+                makeStarPolygon(5 + nextRandom() % 20, nextRandom() % width, nextRandom() % height, radius, radius / 2),
+                configuration, true));
+        }
+        
+        return savedPolygons;
+    }
+
+    /**
+     * @brief Mede o tempo médio (ms) de uma operação repetida
+     */
+    template <typename Operation>
+    static double measureMilliseconds(int repeatCount, Operation&& operation) {
+        auto startTime = std::chrono::steady_clock::now();
+        for (int repetition = 0; repetition < repeatCount; ++repetition) {
+            operation();
+        }
+        auto endTime = std::chrono::steady_clock::now();
+        
+        return std::chrono::duration<double, std::milli>(endTime - startTime).count() / repeatCount;
+    }
+
+    /**
+     * @brief Compara FULL_SORT e INCREMENTAL_INSERTION para um polígono
+     */
+    void compareActiveEdgeOrdering(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        PolygonFillAlgorithm fillAlgorithm;
+        ColorRGB fillColor;
+        SpanCountingSink spanSink;
+        
+        fillAlgorithm.setActiveEdgeOrdering(ActiveEdgeOrdering::FULL_SORT);
+        double fullSortTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        
+        fillAlgorithm.setActiveEdgeOrdering(ActiveEdgeOrdering::INCREMENTAL_INSERTION);
+        double incrementalTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(8) << polygonVertices.size() << " vertices | "
+                  << "sort: " << std::fixed << std::setprecision(3) << fullSortTime << " ms | "
+                  << "incremental: " << incrementalTime << " ms | "
+                  << "speedup: " << std::setprecision(2) << (fullSortTime / incrementalTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Constrói o polígono vértice a vértice pelo GraphicsRenderer, como no editor, e confere com a varredura completa
+     *
+     * A cada vértice acrescentado (e depois a cada um removido) o
+     * preenchimento incremental do renderer é comparado com fillPolygon no
+     * modo INTEGER_DDA e as scanlines revarridas são somadas.
+     */
+    void compareEditedPolygonFill(const std::string& shapeName, const std::vector<Point2D>& polygonVertices,
+                                  int width, int height) const {
+        GraphicsRenderer graphicsRenderer;
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        
+        // Sequência de edições: acrescenta todos os vértices e remove um quarto deles
+        std::vector<std::vector<Point2D> > editSteps;
+        std::vector<Point2D> editedVertices;
+        for (const Point2D& vertex : polygonVertices) {
+            editedVertices.push_back(vertex);
+            editSteps.push_back(editedVertices);
+        }
+        for (size_t removalIndex = 0; removalIndex < polygonVertices.size() / 4; ++removalIndex) {
+            editedVertices.pop_back();
+            editSteps.push_back(editedVertices);
+        }
+        
+        size_t mismatchCount = 0;
+        size_t rescannedRowCount = 0;
+        for (const std::vector<Point2D>& stepVertices : editSteps) {
+            SpanChecksumSink editedSink;
+            graphicsRenderer.fillEditedPolygon(stepVertices, fillColor, height, width, editedSink);
+            rescannedRowCount += graphicsRenderer.getEditedPolygonRescannedRowCount();
+            SpanChecksumSink fullSink;
+            fillAlgorithm.fillPolygon(stepVertices, fillColor, height, width, fullSink);
+            mismatchCount += (editedSink.checksum != fullSink.checksum) ? 1 : 0;
+        }
+        
+        GraphicsRenderer timedRenderer;
+        SpanCountingSink spanSink;
+        double incrementalTime = measureMilliseconds(1, [&]() {
+            for (const std::vector<Point2D>& stepVertices : editSteps) {
+                timedRenderer.fillEditedPolygon(stepVertices, fillColor, height, width, spanSink);
+            }
+        });
+        double fullTime = measureMilliseconds(1, [&]() {
+            for (const std::vector<Point2D>& stepVertices : editSteps) {
+                fillAlgorithm.fillPolygon(stepVertices, fillColor, height, width, spanSink);
+            }
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName << std::right << std::setw(8) << editSteps.size()
+                  << " edicoes | completo: " << std::fixed << std::setprecision(2) << fullTime << " ms | incremental: "
+                  << incrementalTime << " ms | " << std::setprecision(1) << (incrementalTime > 0.0 ? fullTime / incrementalTime : 0.0)
+                  << "x | linhas revarridas/edicao: " << rescannedRowCount / editSteps.size()
+                  << " | diferentes: " << mismatchCount << (mismatchCount == 0 ? "" : " DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Compara o avanço em double (EdgeData) com o DDA inteiro (FixedEdgeData)
+     */
+    void compareEdgeStepping(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        PolygonFillAlgorithm fillAlgorithm;
+        ColorRGB fillColor;
+        SpanCountingSink spanSink;
+        
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::FLOATING_POINT);
+        double floatingPointTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double integerTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(8) << polygonVertices.size() << " vertices | "
+                  << "double: " << std::fixed << std::setprecision(3) << floatingPointTime << " ms | "
+                  << "dda: " << integerTime << " ms | "
+                  << "speedup: " << std::setprecision(2) << (floatingPointTime / integerTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Compara a AET em AoS (vetor de EdgeData) com a AET SoA vetorizada
+     */
+    void compareActiveEdgeLayout(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        PolygonFillAlgorithm fillAlgorithm;
+        ColorRGB fillColor;
+        SpanCountingSink spanSink;
+        
+        fillAlgorithm.setActiveEdgeLayout(ActiveEdgeLayout::ARRAY_OF_STRUCTURES);
+        double structuresTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        
+        SpanChecksumSink structuresChecksum;
+        fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, structuresChecksum);
+        
+        fillAlgorithm.setActiveEdgeLayout(ActiveEdgeLayout::STRUCTURE_OF_ARRAYS);
+        double arraysTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        // Depois das repetições: a ET e a AET reaproveitadas não podem carregar estado
+        SpanChecksumSink arraysChecksum;
+        fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, arraysChecksum);
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(8) << polygonVertices.size() << " vertices | "
+                  << "aos: " << std::fixed << std::setprecision(3) << structuresTime << " ms | "
+                  << "soa: " << arraysTime << " ms | "
+                  << "speedup: " << std::setprecision(2) << (structuresTime / arraysTime) << "x"
+                  << (structuresChecksum.checksum == arraysChecksum.checksum ? "" : " | DIVERGENCIA")
+                  << std::endl;
+    }
+
+    /**
+     * @brief Mede a vazão de escrita de spans largos (canvas 8K) para um formato de pixel, opacos e translúcidos
+     */
+    template <typename PixelFormat>
+    void measureSpanWriteThroughput(const std::string& formatName) const {
+        const int canvasWidth8K = 7680;
+        const int rowCount = 512;
+        BasicCpuFramebuffer<PixelFormat> framebuffer(canvasWidth8K, rowCount);
+        typename PixelFormat::PixelType packedColor = PixelFormat::pack(ColorRGB(0.2f, 0.6f, 0.9f));
+        
+        double frameTime = measureMilliseconds(iterations, [&]() {
+            for (int scanLine = 0; scanLine < rowCount; ++scanLine) {
+                framebuffer.fillSpan(scanLine, scanLine % 7, canvasWidth8K - 1 - scanLine % 5, packedColor);
+            }
+        });
+        
+        PremultipliedColor translucentColor = PremultipliedColor::fromColor(ColorRGB(0.2f, 0.6f, 0.9f, 0.5f));
+        double blendTime = measureMilliseconds(iterations, [&]() {
+            for (int scanLine = 0; scanLine < rowCount; ++scanLine) {
+                framebuffer.blendSpan(scanLine, scanLine % 7, canvasWidth8K - 1 - scanLine % 5, translucentColor);
+            }
+        });
+        
+        double bytesWritten = static_cast<double>(canvasWidth8K) * rowCount * sizeof(typename PixelFormat::PixelType);
+        std::cout << std::left << std::setw(28) << formatName
+                  << std::right << std::fixed << std::setprecision(3) << frameTime << " ms | "
+                  << std::setprecision(2) << (bytesWritten / (frameTime * 1.0e6)) << " GB/s | "
+                  << "alpha 50%: " << std::setprecision(3) << blendTime << " ms | "
+                  << std::setprecision(2) << (bytesWritten / (blendTime * 1.0e6)) << " GB/s"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Mede o preenchimento de um polígono grande com cada shader de span
+     */
+    void compareSpanShaders(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        CpuFramebuffer framebuffer(canvasWidth, canvasHeight);
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB firstColor(0.1f, 0.3f, 0.8f);
+        ColorRGB secondColor(0.9f, 0.9f, 0.2f);
+        Point2D center(canvasWidth / 2, canvasHeight / 2);
+        
+        std::vector<ColorRGB> patternTexels;
+        for (int texelIndex = 0; texelIndex < 16 * 16; ++texelIndex) {
+            patternTexels.push_back(((texelIndex / 16) ^ (texelIndex % 16)) & 4 ? firstColor : secondColor);
+        }
+        
+        double colorTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygon(polygonVertices, firstColor, framebuffer);
+        });
+        
+        FlatColorShader<PixelFormatRGBA8> flatShader(firstColor);
+        double flatTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonShaded(polygonVertices, flatShader, framebuffer);
+        });
+        
+        LinearGradientShader<PixelFormatRGBA8> linearShader(Point2D(0, 0), Point2D(canvasWidth, canvasHeight),
+                                                            firstColor, secondColor);
+        double linearTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonShaded(polygonVertices, linearShader, framebuffer);
+        });
+        
+        RadialGradientShader<PixelFormatRGBA8> radialShader(center, std::min(canvasWidth, canvasHeight) / 2,
+                                                            firstColor, secondColor);
+        double radialTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonShaded(polygonVertices, radialShader, framebuffer);
+        });
+        
+        TiledPatternShader<PixelFormatRGBA8> patternShader(16, 16, patternTexels);
+        double patternTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonShaded(polygonVertices, patternShader, framebuffer);
+        });
+        
+        CheckerboardShader<PixelFormatRGBA8> checkerboardShader(32, firstColor, secondColor);
+        double checkerboardTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonShaded(polygonVertices, checkerboardShader, framebuffer);
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::fixed << std::setprecision(3)
+                  << "cor: " << colorTime << " ms | "
+                  << "solido: " << flatTime << " ms | "
+                  << "linear: " << linearTime << " ms | "
+                  << "radial: " << radialTime << " ms | "
+                  << "padrao: " << patternTime << " ms | "
+                  << "xadrez: " << checkerboardTime << " ms"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Compara o preenchimento de cor sólida com o Gouraud (cor por vértice) no mesmo polígono
+     */
+    template <typename PixelFormat>
+    void compareGouraudFill(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        BasicCpuFramebuffer<PixelFormat> framebuffer(canvasWidth, canvasHeight);
+        SoftwareRenderer softwareRenderer;
+        ColorRGB fillColor(0.2f, 0.6f, 0.9f);
+        
+        std::vector<ColorRGB> vertexColors;
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            float hue = static_cast<float>(vertexIndex % 7) / 6.0f;
+            vertexColors.push_back(ColorRGB(hue, 1.0f - hue, 0.5f));
+        }
+        
+        double flatTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygon(polygonVertices, fillColor, framebuffer);
+        });
+        
+        double gouraudTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygonGouraud(polygonVertices, vertexColors, framebuffer);
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::fixed << std::setprecision(3)
+                  << "cor solida: " << flatTime << " ms | "
+                  << "gouraud: " << gouraudTime << " ms | "
+                  << "custo: " << std::setprecision(2) << (gouraudTime / flatTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Mede a escalabilidade do preenchimento em faixas com o número de threads
+     */
+    void measureBandParallelScaling(const std::string& shapeName, const std::vector<Point2D>& polygonVertices,
+                                    int width, int height) const {
+        CpuFramebufferIndexed8 framebuffer(width, height);
+        ColorRGB fillColor(0.0f, 0.5f, 1.0f);
+        unsigned int coreCount = std::max(1u, std::thread::hardware_concurrency());
+        
+        std::cout << shapeName << " (" << polygonVertices.size() << " vertices, "
+                  << width << "x" << height << ")" << std::endl;
+        
+        std::vector<unsigned int> threadCounts;
+        for (unsigned int threadCount = 1; threadCount < coreCount; threadCount *= 2) {
+            threadCounts.push_back(threadCount);
+        }
+        threadCounts.push_back(coreCount);
+        
+        double singleThreadTime = 0.0;
+        for (unsigned int threadCount : threadCounts) {
+            ParallelPolygonFill parallelFill(threadCount);
+            double fillTime = measureMilliseconds(iterations, [&]() {
+                parallelFill.fillPolygon(polygonVertices, fillColor, framebuffer);
+            });
+            if (threadCount == 1) {
+                singleThreadTime = fillTime;
+            }
+            
+            std::cout << "  " << std::setw(3) << threadCount << " threads: "
+                      << std::fixed << std::setprecision(3) << fillTime << " ms | "
+                      << "speedup: " << std::setprecision(2) << (singleThreadTime / fillTime) << "x"
+                      << std::endl;
+        }
+    }
+
+    /**
+     * @brief Compara o preenchimento sequencial dos polígonos salvos com o rasterizador em tiles
+     */
+    void compareSavedPolygonRasterizers(int polygonCount, int width, int height) const {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons = makeSavedPolygonScene(polygonCount, width, height);
+        CpuFramebuffer framebuffer(width, height);
+        
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double sequentialTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.renderSavedPolygons(savedPolygons, framebuffer);
+        });
+        
+        TileBinnedRasterizer tileRasterizer;
+        double tiledTime = measureMilliseconds(iterations, [&]() {
+            tileRasterizer.renderSavedPolygons(savedPolygons, framebuffer);
+        });
+        
+        ScanlineSweepRenderer sweepRenderer;
+        double sweepTime = measureMilliseconds(iterations, [&]() {
+            sweepRenderer.renderSavedPolygons(savedPolygons, framebuffer);
+        });
+        
+        PolygonRasterCache rasterCache;
+        FramebufferSpanSink framebufferSink(framebuffer);
+        rasterCache.renderSavedPolygons(savedPolygons, softwareRenderer.getFillAlgorithm(), height, width, framebufferSink);
+        double cachedTime = measureMilliseconds(iterations, [&]() {
+            rasterCache.renderSavedPolygons(savedPolygons, softwareRenderer.getFillAlgorithm(), height, width, framebufferSink);
+        });
+        
+        std::cout << std::setw(6) << polygonCount << " poligonos salvos | "
+                  << "sequencial: " << std::fixed << std::setprecision(3) << sequentialTime << " ms | "
+                  << "tiles 64x64: " << tiledTime << " ms | "
+                  << "varredura unica: " << sweepTime << " ms | "
+                  << "cache de spans: " << cachedTime << " ms | "
+                  << "speedup tiles: " << std::setprecision(2) << (sequentialTime / tiledTime) << "x | "
+                  << "overdraw: " << sweepRenderer.getStatistics().overdrawFactor() << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Varredura única x preenchimento sequencial com pentagramas sobrepostos, nas duas regras de preenchimento
+     *
+     * O centro de um pentagrama tem winding 2, então EVEN_ODD e NONZERO pintam
+     * pixels diferentes; parte dos polígonos é translúcida e parte sai da janela.
+     */
+    void compareSweepFillRules(int polygonCount, int width, int height) const {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons;
+        unsigned int seed = 4242u;
+        auto nextRandom = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int>(seed >> 8);
+        };
+        const double pi = 3.14159265358979323846;
+        for (int polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex) {
+            int radius = 20 + nextRandom() % 200;
+            int centerX = nextRandom() % (width + 200) - 100;
+            int centerY = nextRandom() % (height + 200) - 100;
+            std::vector<Point2D> pentagram;
+            for (int vertexIndex = 0; vertexIndex < 5; ++vertexIndex) {
+                double angle = 4.0 * pi * vertexIndex / 5.0;
+                pentagram.push_back(Point2D(centerX + static_cast<int>(std::lround(radius * std::cos(angle))),
+                                            centerY + static_cast<int>(std::lround(radius * std::sin(angle)))));
+            }
+            PolygonConfiguration configuration;
+            configuration.fillColor = ColorRGB((nextRandom() % 256) / 255.0f, (nextRandom() % 256) / 255.0f,
+                                               (nextRandom() % 256) / 255.0f, (polygonIndex % 3 == 0) ? 0.5f : 1.0f);
+            savedPolygons.push_back(PolygonManager::SavedPolygon(pentagram, configuration, true));
+        }
+        
+        std::cout << std::setw(6) << polygonCount << " pentagramas |";
+        bool isConsistent = true;
+        for (FillRule fillRule : {FillRule::EVEN_ODD, FillRule::NONZERO}) {
+            CpuFramebuffer sequentialFramebuffer(width, height);
+            SoftwareRenderer softwareRenderer;
+            softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+            softwareRenderer.getFillAlgorithm().setFillRule(fillRule);
+            softwareRenderer.renderSavedPolygons(savedPolygons, sequentialFramebuffer);
+            
+            CpuFramebuffer sweepFramebuffer(width, height);
+            ScanlineSweepRenderer sweepRenderer;
+            sweepRenderer.getFillAlgorithm().setFillRule(fillRule);
+            sweepRenderer.renderSavedPolygons(savedPolygons, sweepFramebuffer);
+            
+            size_t differenceCount = 0;
+            for (size_t pixelIndex = 0; pixelIndex < sweepFramebuffer.getPixels().size(); ++pixelIndex) {
+                differenceCount += (sweepFramebuffer.getPixels()[pixelIndex] != 
+                                    sequentialFramebuffer.getPixels()[pixelIndex]) ? 1 : 0;
+            }
+            isConsistent = isConsistent && differenceCount == 0;
+            std::cout << " " << (fillRule == FillRule::EVEN_ODD ? "par-impar" : "nao-zero") 
+                      << ": " << differenceCount << " pixels diferentes, overdraw " << std::fixed << std::setprecision(2)
+                      << sweepRenderer.getStatistics().overdrawFactor() << "x |";
+        }
+        std::cout << (isConsistent ? "" : " DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Reenvio do cache ao lote GL: spans reemitidos x vertex array guardado; conversões após recolorir e remover
+     */
+    void compareRasterCacheReplay(int polygonCount, int width, int height) const {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons = makeSavedPolygonScene(polygonCount, width, height);
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        PolygonRasterCache rasterCache;
+        GLSpanBatcher spanBatcher;
+        rasterCache.renderSavedPolygons(savedPolygons, fillAlgorithm, height, width, spanBatcher);
+        size_t batchedSpanCount = spanBatcher.getPendingSpanCount();
+        spanBatcher.clear();
+        
+        double spanReplayTime = measureMilliseconds(iterations, [&]() {
+            rasterCache.renderSavedPolygons<GLSpanBatcher>(savedPolygons, fillAlgorithm, height, width, spanBatcher);
+            spanBatcher.clear();
+        });
+        double vertexReplayTime = measureMilliseconds(iterations, [&]() {
+            rasterCache.renderSavedPolygons(savedPolygons, fillAlgorithm, height, width, spanBatcher);
+            spanBatcher.clear();
+        });
+        
+        // Trocar uma cor e remover o primeiro polígono não exige nova conversão
+        size_t rebuildCount = rasterCache.getRebuildCount();
+        savedPolygons[savedPolygons.size() / 2].configuration.fillColor = ColorRGB(0.0f, 1.0f, 0.0f);
+        savedPolygons.erase(savedPolygons.begin());
+        rasterCache.renderSavedPolygons(savedPolygons, fillAlgorithm, height, width, spanBatcher);
+        size_t editRebuildCount = rasterCache.getRebuildCount() - rebuildCount;
+        bool isConsistent = editRebuildCount == 0 && spanBatcher.getPendingSpanCount() == rasterCache.getCachedSpanCount() &&
+                            batchedSpanCount > 0;
+        spanBatcher.clear();
+        
+        std::cout << std::setw(6) << polygonCount << " poligonos salvos | lote GL por spans: " << std::fixed
+                  << std::setprecision(3) << spanReplayTime << " ms | por vertex array: " << vertexReplayTime << " ms | "
+                  << std::setprecision(2) << (spanReplayTime / vertexReplayTime) << "x | conversoes apos recolorir e remover: "
+                  << editRebuildCount << (isConsistent ? "" : " | DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Um único polígono salvo grande: sequencial x tiles com um worker e com todos, conferindo os pixels
+     */
+    void compareTiledLargePolygon(int vertexCount, int width, int height) const {
+        PolygonConfiguration configuration;
+        configuration.fillColor = ColorRGB(1.0f, 0.5f, 0.25f);
+        std::vector<PolygonManager::SavedPolygon> savedPolygons;
+        savedPolygons.push_back(PolygonManager::SavedPolygon(
+            makeCoastlinePolygon(vertexCount, width / 2, height / 2, width / 2 - 48, height / 2 - 48), configuration, true));
+        CpuFramebuffer sequentialFramebuffer(width, height);
+        CpuFramebuffer tiledFramebuffer(width, height);
+        
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double sequentialTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.renderSavedPolygons(savedPolygons, sequentialFramebuffer);
+        });
+        
+        TileBinnedRasterizer tileRasterizer(64, 1);
+        double singleWorkerTime = measureMilliseconds(iterations, [&]() {
+            tileRasterizer.renderSavedPolygons(savedPolygons, tiledFramebuffer);
+        });
+        bool isIdentical = tiledFramebuffer.getPixels() == sequentialFramebuffer.getPixels();
+        
+        tileRasterizer.setWorkerCount(0);
+        double allWorkersTime = measureMilliseconds(iterations, [&]() {
+            tileRasterizer.renderSavedPolygons(savedPolygons, tiledFramebuffer);
+        });
+        
+        std::cout << std::setw(6) << vertexCount << " vertices " << width << "x" << height << " | "
+                  << "sequencial: " << std::fixed << std::setprecision(3) << sequentialTime << " ms | "
+                  << "tiles, 1 worker: " << singleWorkerTime << " ms | "
+                  << "tiles, " << std::thread::hardware_concurrency() << " workers: " << allWorkersTime << " ms"
+                  << (isIdentical ? "" : " | DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Compara o teste de ponto pela máscara de runs com o teste de cruzamentos O(n)
+     */
+    void compareHitTesting(const std::string& shapeName, const std::vector<Point2D>& polygonVertices,
+                           int width, int height, int queryCount) const {
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        PolygonSpanMask spanMask;
+        double buildTime = measureMilliseconds(1, [&]() {
+            spanMask.build(polygonVertices, fillAlgorithm);
+        });
+        
+        std::vector<Point2D> queryPoints;
+        queryPoints.reserve(static_cast<size_t>(queryCount));
+        unsigned int seed = 777u;
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex) {
+            seed = seed * 1664525u + 1013904223u;
+            int x = static_cast<int>((seed >> 8) % static_cast<unsigned int>(width));
+            seed = seed * 1664525u + 1013904223u;
+            int y = static_cast<int>((seed >> 8) % static_cast<unsigned int>(height));
+            queryPoints.push_back(Point2D(x, y));
+        }
+        
+        size_t maskHits = 0;
+        double maskTime = measureMilliseconds(iterations, [&]() {
+            maskHits = 0;
+            for (const Point2D& point : queryPoints) {
+                maskHits += spanMask.contains(point.coordinateX, point.coordinateY) ? 1 : 0;
+            }
+        });
+        
+        // O teste de cruzamentos percorre todas as arestas: uma passada basta
+        size_t crossingHits = 0;
+        double crossingTime = measureMilliseconds(1, [&]() {
+            for (const Point2D& point : queryPoints) {
+                crossingHits += PolygonFillAlgorithm::isPixelCenterInside(polygonVertices, point.coordinateX, 
+                                                                          point.coordinateY) ? 1 : 0;
+            }
+        });
+        
+        double nanosecondsPerMaskQuery = maskTime * 1.0e6 / queryCount;
+        double nanosecondsPerCrossingQuery = crossingTime * 1.0e6 / queryCount;
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(7) << polygonVertices.size() << " vertices | "
+                  << "mascara: " << std::fixed << std::setprecision(3) << buildTime << " ms, "
+                  << spanMask.getRunCount() << " runs, " << (spanMask.getMemoryBytes() / 1024) << " KiB | "
+                  << "consulta: " << std::setprecision(1) << nanosecondsPerMaskQuery << " ns | "
+                  << "cruzamentos: " << nanosecondsPerCrossingQuery << " ns | "
+                  << "speedup: " << std::setprecision(0) << (nanosecondsPerCrossingQuery / nanosecondsPerMaskQuery) << "x"
+                  << (maskHits == crossingHits ? "" : " | DIVERGENCIA")
+                  << std::endl;
+    }
+
+    /**
+     * @brief Seleção entre polígonos salvos: PolygonHitTester x cruzamentos em cada polígono preenchido
+     *
+     * Um em cada quatro polígonos fica sem preenchimento e não deve ser
+     * selecionado. Depois de remover um polígono, a consulta não gera máscaras.
+     */
+    void compareSavedPolygonHitTesting(int polygonCount, int width, int height, int queryCount) const {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons = makeSavedPolygonScene(polygonCount, width, height);
+        for (size_t polygonIndex = 0; polygonIndex < savedPolygons.size(); polygonIndex += 4) {
+            savedPolygons[polygonIndex].isFilled = false;
+        }
+        
+        std::vector<Point2D> queryPoints;
+        queryPoints.reserve(static_cast<size_t>(queryCount));
+        unsigned int seed = 999u;
+        for (int queryIndex = 0; queryIndex < queryCount; ++queryIndex) {
+            seed = seed * 1664525u + 1013904223u;
+            int x = static_cast<int>((seed >> 8) % static_cast<unsigned int>(width));
+            seed = seed * 1664525u + 1013904223u;
+            int y = static_cast<int>((seed >> 8) % static_cast<unsigned int>(height));
+            queryPoints.push_back(Point2D(x, y));
+        }
+        
+        auto findByCrossings = [&](const Point2D& point) {
+            for (size_t polygonIndex = savedPolygons.size(); polygonIndex > 0; --polygonIndex) {
+                const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[polygonIndex - 1];
+                if (savedPolygon.isFilled && PolygonFillAlgorithm::isPixelCenterInside(savedPolygon.vertices, 
+                        point.coordinateX, point.coordinateY)) {
+                    return static_cast<int>(polygonIndex - 1);
+                }
+            }
+            return -1;
+        };
+        
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        PolygonHitTester hitTester;
+        double buildTime = measureMilliseconds(1, [&]() {
+            hitTester.synchronize(savedPolygons, fillAlgorithm);
+        });
+        
+        std::vector<int> testerResults(queryPoints.size());
+        double testerTime = measureMilliseconds(1, [&]() {
+            for (size_t queryIndex = 0; queryIndex < queryPoints.size(); ++queryIndex) {
+                testerResults[queryIndex] = hitTester.findPolygonAt(savedPolygons, fillAlgorithm, 
+                                                                    queryPoints[queryIndex].coordinateX, 
+                                                                    queryPoints[queryIndex].coordinateY);
+            }
+        });
+        
+        size_t mismatchCount = 0;
+        size_t hitCount = 0;
+        double crossingTime = measureMilliseconds(1, [&]() {
+            for (size_t queryIndex = 0; queryIndex < queryPoints.size(); ++queryIndex) {
+                int expected = findByCrossings(queryPoints[queryIndex]);
+                mismatchCount += (expected != testerResults[queryIndex]) ? 1 : 0;
+                hitCount += (expected >= 0) ? 1 : 0;
+            }
+        });
+        
+        // Remover um polígono desloca os índices, mas as máscaras são por polygonId
+        size_t rebuildCount = hitTester.getRebuildCount();
+        savedPolygons.erase(savedPolygons.begin() + 1);
+        for (const Point2D& point : queryPoints) {
+            mismatchCount += (findByCrossings(point) != hitTester.findPolygonAt(savedPolygons, fillAlgorithm, 
+                point.coordinateX, point.coordinateY)) ? 1 : 0;
+        }
+        size_t editRebuildCount = hitTester.getRebuildCount() - rebuildCount;
+        
+        std::cout << std::setw(6) << polygonCount << " poligonos salvos | mascaras: " << std::fixed 
+                  << std::setprecision(3) << buildTime << " ms | consulta (sincronizacao + caixas): " 
+                  << std::setprecision(1) << (testerTime * 1.0e3 / queryCount) << " us | cruzamentos: "
+                  << (crossingTime * 1.0e3 / queryCount) << " us | acertos: " << hitCount << "/" << queryCount
+                  << " | mascaras apos remover: " << editRebuildCount
+                  << ((mismatchCount == 0 && editRebuildCount == 0) ? "" : " | DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Compara a mesma cena de polígonos salvos com preenchimento opaco e com opacidade de 50%
+     */
+    void compareTranslucentOverlay(int polygonCount, int width, int height) const {
+        std::vector<PolygonManager::SavedPolygon> opaquePolygons = makeSavedPolygonScene(polygonCount, width, height);
+        std::vector<PolygonManager::SavedPolygon> translucentPolygons = opaquePolygons;
+        for (PolygonManager::SavedPolygon& savedPolygon : translucentPolygons) {
+            savedPolygon.configuration.setFillOpacity(0.5f);
+        }
+        CpuFramebuffer framebuffer(width, height);
+        
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double opaqueTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.renderSavedPolygons(opaquePolygons, framebuffer);
+        });
+        double translucentTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.renderSavedPolygons(translucentPolygons, framebuffer);
+        });
+        
+        TileBinnedRasterizer tileRasterizer;
+        double tiledTranslucentTime = measureMilliseconds(iterations, [&]() {
+            tileRasterizer.renderSavedPolygons(translucentPolygons, framebuffer);
+        });
+        
+        std::cout << std::setw(6) << polygonCount << " poligonos " << width << "x" << height << " | "
+                  << "opacos: " << std::fixed << std::setprecision(3) << opaqueTime << " ms | "
+                  << "alpha 50%: " << translucentTime << " ms | "
+                  << "alpha 50% em tiles: " << tiledTranslucentTime << " ms | "
+                  << "custo da composicao: " << std::setprecision(2) << (translucentTime / opaqueTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Compara a saída em spans (INTEGER_DDA) com a saída em trapézios da mesma varredura
+     */
+    void compareTrapezoidOutput(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        
+        SpanCountingSink spanSink;
+        double spanTime = measureMilliseconds(iterations, [&]() {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, spanSink);
+        });
+        std::uint64_t spanCount = spanSink.spanCount / static_cast<std::uint64_t>(iterations);
+        
+        TrapezoidSweep trapezoidSweep;
+        TrapezoidCountingSink trapezoidSink;
+        double trapezoidTime = measureMilliseconds(iterations, [&]() {
+            trapezoidSweep.sweepPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, trapezoidSink);
+        });
+        std::uint64_t trapezoidCount = trapezoidSweep.getEmittedTrapezoidCount();
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(8) << polygonVertices.size() << " vertices | "
+                  << "spans: " << std::setw(8) << spanCount << " em " << std::fixed << std::setprecision(3) << spanTime << " ms | "
+                  << "trapezios: " << std::setw(7) << trapezoidCount << " em " << trapezoidTime << " ms | "
+                  << "reducao: " << std::setprecision(1) 
+                  << (trapezoidCount == 0 ? 0.0 : static_cast<double>(spanCount) / static_cast<double>(trapezoidCount)) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Polígono regular convexo com o número de lados indicado
+     */
+    static std::vector<Point2D> makeRegularPolygon(int sideCount, int centerX, int centerY, int radius) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(sideCount));
+        
+        for (int vertexIndex = 0; vertexIndex < sideCount; ++vertexIndex) {
+            double angle = 2.0 * 3.14159265358979323846 * vertexIndex / sideCount;
+            vertices.push_back(Point2D(centerX + static_cast<int>(std::lround(radius * std::cos(angle))),
+                                       centerY + static_cast<int>(std::lround(radius * std::sin(angle)))));
+        }
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Compara o caminho geral (ET/AET) com o caminho rápido de duas cadeias para convexos
+     * @param polygonCount Quantos polígonos preencher (espalhados pela tela)
+     * @param sideCount Lados de cada polígono regular
+     * @param radius Raio de cada polígono
+     */
+    void compareConvexFastPath(int polygonCount, int sideCount, int radius) const {
+        std::vector<std::vector<Point2D> > polygons;
+        unsigned int seed = 777u;
+        for (int polygonIndex = 0; polygonIndex < polygonCount; ++polygonIndex) {
+            seed = seed * 1664525u + 1013904223u;
+            int centerX = radius + static_cast<int>((seed >> 8) % static_cast<unsigned int>(std::max(1, canvasWidth - 2 * radius)));
+            seed = seed * 1664525u + 1013904223u;
+            int centerY = radius + static_cast<int>((seed >> 8) % static_cast<unsigned int>(std::max(1, canvasHeight - 2 * radius)));
+            polygons.push_back(makeRegularPolygon(sideCount, centerX, centerY, radius));
+        }
+        
+        PolygonFillAlgorithm fillAlgorithm;
+        ColorRGB fillColor;
+        SpanCountingSink spanSink;
+        
+        double floatingPointTime = measureMilliseconds(iterations, [&]() {
+            for (const std::vector<Point2D>& polygon : polygons) {
+                fillAlgorithm.fillPolygon(polygon, fillColor, canvasHeight, canvasWidth, spanSink);
+            }
+        });
+        
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double integerTime = measureMilliseconds(iterations, [&]() {
+            for (const std::vector<Point2D>& polygon : polygons) {
+                fillAlgorithm.fillPolygon(polygon, fillColor, canvasHeight, canvasWidth, spanSink);
+            }
+        });
+        
+        double convexTime = measureMilliseconds(iterations, [&]() {
+            for (const std::vector<Point2D>& polygon : polygons) {
+                fillAlgorithm.fillConvexPolygon(polygon, fillColor, canvasHeight, canvasWidth, spanSink);
+            }
+        });
+        
+        std::cout << std::setw(6) << polygonCount << " x " << std::setw(4) << sideCount << " lados, raio "
+                  << std::setw(4) << radius << " | "
+                  << "geral double: " << std::fixed << std::setprecision(3) << floatingPointTime << " ms | "
+                  << "geral dda: " << integerTime << " ms | "
+                  << "convexo: " << convexTime << " ms | "
+                  << "speedup: " << std::setprecision(2) << (integerTime / convexTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Compara o preenchimento serrilhado (INTEGER_DDA) com a cobertura analítica
+     */
+    void compareAntialiasedFill(const std::string& shapeName, const std::vector<Point2D>& polygonVertices) const {
+        CpuFramebuffer framebuffer(canvasWidth, canvasHeight);
+        ColorRGB fillColor(1.0f, 0.5f, 0.0f);
+        
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        double aliasedTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygon(polygonVertices, fillColor, framebuffer);
+        });
+        
+        softwareRenderer.setAntialiasingEnabled(true);
+        double antialiasedTime = measureMilliseconds(iterations, [&]() {
+            softwareRenderer.fillPolygon(polygonVertices, fillColor, framebuffer);
+        });
+        
+        std::cout << std::left << std::setw(28) << shapeName
+                  << std::right << std::setw(8) << polygonVertices.size() << " vertices | "
+                  << "serrilhado: " << std::fixed << std::setprecision(3) << aliasedTime << " ms | "
+                  << "cobertura: " << antialiasedTime << " ms | "
+                  << "custo: " << std::setprecision(2) << (antialiasedTime / aliasedTime) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Mede as operações booleanas entre dois contornos SIG deslocados e o overdraw poupado pela união
+     * @param vertexCount Vértices de cada contorno
+     */
+    void compareBooleanOperations(int vertexCount, int width, int height) const {
+        int radius = std::min(width, height) / 3;
+        std::vector<Point2D> subjectVertices = makeCoastlinePolygon(vertexCount, width / 2 - radius / 3, height / 2,
+                                                                    radius, radius);
+        std::vector<Point2D> clippingVertices = makeCoastlinePolygon(vertexCount, width / 2 + radius / 3, height / 2,
+                                                                     radius, radius);
+        
+        PolygonBooleanSweep booleanSweep;
+        const BooleanOperation operations[4] = { BooleanOperation::UNION, BooleanOperation::INTERSECTION,
+                                                 BooleanOperation::DIFFERENCE, BooleanOperation::XOR };
+        const char* operationNames[4] = { "uniao", "intersecao", "diferenca", "xor" };
+        
+        std::cout << std::setw(7) << vertexCount << " vertices x 2 |";
+        std::vector<std::vector<Point2D> > unionRings;
+        for (int operationIndex = 0; operationIndex < 4; ++operationIndex) {
+            std::vector<std::vector<Point2D> > rings;
+            double operationTime = measureMilliseconds(1, [&]() {
+                rings = booleanSweep.compute(subjectVertices, clippingVertices, operations[operationIndex]);
+            });
+            std::cout << " " << operationNames[operationIndex] << ": " << std::fixed << std::setprecision(1)
+                      << operationTime << " ms (" << rings.size() << " aneis) |";
+            if (operations[operationIndex] == BooleanOperation::UNION) {
+                unionRings = rings;
+            }
+        }
+        
+        // Pixels rasterizados pelos dois polígonos separados e pela união
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        SpanCountingSink separateSink;
+        fillAlgorithm.fillPolygon(subjectVertices, fillColor, height, width, separateSink);
+        fillAlgorithm.fillPolygon(clippingVertices, fillColor, height, width, separateSink);
+        SpanCountingSink unionSink;
+        for (const std::vector<Point2D>& ring : unionRings) {
+            fillAlgorithm.fillPolygon(ring, fillColor, height, width, unionSink);
+        }
+        
+        std::cout << " pixels separados/uniao: " << std::setprecision(2)
+                  << (unionSink.pixelCount == 0 ? 0.0 : static_cast<double>(separateSink.pixelCount) / 
+                                                        static_cast<double>(unionSink.pixelCount)) << "x"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Liga bit nos pixels cujo centro fica a até maximumDistance de alguma aresta do polígono
+     */
+    static void markEdgeBand(const std::vector<Point2D>& polygonVertices, double maximumDistance,
+                             int width, int height, unsigned char bit, std::vector<unsigned char>& mask) {
+        int reach = static_cast<int>(std::ceil(maximumDistance));
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& start = polygonVertices[vertexIndex];
+            const Point2D& end = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            double deltaX = end.coordinateX - start.coordinateX;
+            double deltaY = end.coordinateY - start.coordinateY;
+            double squaredLength = deltaX * deltaX + deltaY * deltaY;
+            
+            int minimumX = std::max(0, std::min(start.coordinateX, end.coordinateX) - reach);
+            int maximumX = std::min(width - 1, std::max(start.coordinateX, end.coordinateX) + reach);
+            int minimumY = std::max(0, std::min(start.coordinateY, end.coordinateY) - reach);
+            int maximumY = std::min(height - 1, std::max(start.coordinateY, end.coordinateY) + reach);
+            for (int y = minimumY; y <= maximumY; ++y) {
+                for (int x = minimumX; x <= maximumX; ++x) {
+                    double offsetX = x + 0.5 - start.coordinateX;
+                    double offsetY = y + 0.5 - start.coordinateY;
+                    double t = squaredLength > 0.0 ? (offsetX * deltaX + offsetY * deltaY) / squaredLength : 0.0;
+                    t = std::max(0.0, std::min(1.0, t));
+                    double distanceX = offsetX - t * deltaX;
+                    double distanceY = offsetY - t * deltaY;
+                    if (distanceX * distanceX + distanceY * distanceY <= maximumDistance * maximumDistance) {
+                        mask[static_cast<size_t>(y) * width + x] |= bit;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Confere as operações booleanas com as máscaras de pixels dos polígonos de entrada
+     *
+     * O resultado de cada operação é preenchido e comparado, pixel a pixel,
+     * com OU, E, E-NÃO e OU exclusivo das máscaras de A e de B. Os cruzamentos
+     * são arredondados para a grade inteira, o que desloca as bordas em até
+     * meio pixel na diagonal: só pixels com centro nessa faixa em torno das
+     * arestas de entrada podem divergir, e qualquer divergência fora dela é
+     * um erro.
+     */
+    void verifyBooleanOperations(int vertexCount, int width, int height) const {
+        int radius = std::min(width, height) / 3;
+        std::vector<Point2D> subjectVertices = makeCoastlinePolygon(vertexCount, width / 2 - radius / 3, height / 2,
+                                                                    radius, radius);
+        std::vector<Point2D> clippingVertices = makeCoastlinePolygon(vertexCount, width / 2 + radius / 3, height / 2,
+                                                                     radius, radius);
+        
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        const unsigned char subjectBit = 1;
+        const unsigned char clippingBit = 2;
+        const unsigned char bandBit = 4;
+        std::vector<unsigned char> inputMask(static_cast<size_t>(width) * height, 0);
+        CoverageMaskSink subjectSink(inputMask, width, subjectBit);
+        fillAlgorithm.fillPolygon(subjectVertices, fillColor, height, width, subjectSink);
+        CoverageMaskSink clippingSink(inputMask, width, clippingBit);
+        fillAlgorithm.fillPolygon(clippingVertices, fillColor, height, width, clippingSink);
+        const double snapDistance = 0.75;
+        markEdgeBand(subjectVertices, snapDistance, width, height, bandBit, inputMask);
+        markEdgeBand(clippingVertices, snapDistance, width, height, bandBit, inputMask);
+        
+        PolygonBooleanSweep booleanSweep;
+        const BooleanOperation operations[4] = { BooleanOperation::UNION, BooleanOperation::INTERSECTION,
+                                                 BooleanOperation::DIFFERENCE, BooleanOperation::XOR };
+        const char* operationNames[4] = { "uniao", "intersecao", "diferenca", "xor" };
+        
+        std::cout << std::setw(7) << vertexCount << " vertices x 2 |";
+        for (int operationIndex = 0; operationIndex < 4; ++operationIndex) {
+            std::vector<std::vector<Point2D> > rings = booleanSweep.compute(subjectVertices, clippingVertices,
+                                                                            operations[operationIndex]);
+            std::vector<unsigned char> resultMask(inputMask.size(), 0);
+            CoverageMaskSink resultSink(resultMask, width, 1);
+            for (const std::vector<Point2D>& ring : rings) {
+                fillAlgorithm.fillPolygon(ring, fillColor, height, width, resultSink);
+            }
+            
+            size_t bandMismatchCount = 0;
+            size_t outsideMismatchCount = 0;
+            for (size_t pixelIndex = 0; pixelIndex < inputMask.size(); ++pixelIndex) {
+                bool insideSubject = (inputMask[pixelIndex] & subjectBit) != 0;
+                bool insideClipping = (inputMask[pixelIndex] & clippingBit) != 0;
+                bool isExpected = false;
+                switch (operations[operationIndex]) {
+                    case BooleanOperation::UNION:        isExpected = insideSubject || insideClipping; break;
+                    case BooleanOperation::INTERSECTION: isExpected = insideSubject && insideClipping; break;
+                    case BooleanOperation::DIFFERENCE:   isExpected = insideSubject && !insideClipping; break;
+                    case BooleanOperation::XOR:          isExpected = insideSubject != insideClipping; break;
+                }
+                if (isExpected != (resultMask[pixelIndex] != 0)) {
+                    ++((inputMask[pixelIndex] & bandBit) != 0 ? bandMismatchCount : outsideMismatchCount);
+                }
+            }
+            
+            std::cout << " " << operationNames[operationIndex] << ": " << bandMismatchCount << " px na faixa, "
+                      << outsideMismatchCount << " fora" << (outsideMismatchCount == 0 ? "" : " DIVERGENCIA") << " |";
+        }
+        std::cout << " passadas: " << booleanSweep.getSplitPassCount() << std::endl;
+    }
+
+    /**
+     * @brief Polígono estrelado {n/passo}: cada aresta pula passo vértices de um n-ágono regular
+     *
+     * Com passo > 1 as arestas se cruzam, cerca de 2 * (passo - 1) cruzamentos por aresta.
+     */
+    static std::vector<Point2D> makeStarPolygram(int vertexCount, int step, int centerX, int centerY, int radius) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(vertexCount));
+        
+        const double pi = 3.14159265358979323846;
+        for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+            double angle = 2.0 * pi * (static_cast<long long>(vertexIndex) * step % vertexCount) / vertexCount;
+            vertices.push_back(Point2D(centerX + static_cast<int>(std::lround(radius * std::cos(angle))),
+                                       centerY + static_cast<int>(std::lround(radius * std::sin(angle)))));
+        }
+        
+        return vertices;
+    }
+
+    /**
+     * @brief Conta os pares de arestas não consecutivas que se tocam, testando todos os pares (O(n^2))
+     *
+     * Vértices repetidos em sequência são descartados antes, como na varredura.
+     */
+    static size_t countIntersectingEdgePairsNaive(std::vector<Point2D> polygonVertices) {
+        polygonVertices.erase(std::unique(polygonVertices.begin(), polygonVertices.end()), polygonVertices.end());
+        while (polygonVertices.size() > 1 && polygonVertices.front() == polygonVertices.back()) {
+            polygonVertices.pop_back();
+        }
+        const size_t edgeCount = polygonVertices.size();
+        auto orientation = [](const Point2D& a, const Point2D& b, const Point2D& c) {
+            long long cross = static_cast<long long>(b.coordinateX - a.coordinateX) * (c.coordinateY - a.coordinateY) -
+                              static_cast<long long>(b.coordinateY - a.coordinateY) * (c.coordinateX - a.coordinateX);
+            return (cross > 0) - (cross < 0);
+        };
+        auto isInBox = [](const Point2D& a, const Point2D& b, const Point2D& c) {
+            return std::min(a.coordinateX, b.coordinateX) <= c.coordinateX && c.coordinateX <= std::max(a.coordinateX, b.coordinateX) &&
+                   std::min(a.coordinateY, b.coordinateY) <= c.coordinateY && c.coordinateY <= std::max(a.coordinateY, b.coordinateY);
+        };
+        
+        size_t pairCount = 0;
+        for (size_t firstEdge = 0; firstEdge < edgeCount; ++firstEdge) {
+            const Point2D& a = polygonVertices[firstEdge];
+            const Point2D& b = polygonVertices[(firstEdge + 1) % edgeCount];
+            for (size_t secondEdge = firstEdge + 2; secondEdge < edgeCount; ++secondEdge) {
+                if (firstEdge == 0 && secondEdge == edgeCount - 1) {
+                    continue;
+                }
+                const Point2D& c = polygonVertices[secondEdge];
+                const Point2D& d = polygonVertices[(secondEdge + 1) % edgeCount];
+                int o1 = orientation(a, b, c);
+                int o2 = orientation(a, b, d);
+                int o3 = orientation(c, d, a);
+                int o4 = orientation(c, d, b);
+                if ((o1 * o2 < 0 && o3 * o4 < 0) || (o1 == 0 && isInBox(a, b, c)) || (o2 == 0 && isInBox(a, b, d)) ||
+                    (o3 == 0 && isInBox(c, d, a)) || (o4 == 0 && isInBox(c, d, b))) {
+                    ++pairCount;
+                }
+            }
+        }
+        return pairCount;
+    }
+
+    /**
+     * @brief Compara a detecção de autointerseções por varredura com o teste de todos os pares
+     * @param includeNaive Mede também o O(n^2) (inviável para 10^5 arestas)
+     */
+    void compareSelfIntersectionCheck(const std::string& shapeName, const std::vector<Point2D>& polygonVertices,
+                                      bool includeNaive) const {
+        SelfIntersectionSweep intersectionSweep;
+        std::vector<SelfIntersection> intersections;
+        double sweepTime = measureMilliseconds(1, [&]() {
+            intersectionSweep.findIntersections(polygonVertices, intersections);
+        });
+        
+        // Sobreposições colineares aparecem com dois pontos para o mesmo par
+        size_t sweepPairCount = 0;
+        for (size_t intersectionIndex = 0; intersectionIndex < intersections.size(); ++intersectionIndex) {
+            if (intersectionIndex == 0 ||
+                intersections[intersectionIndex].firstEdge != intersections[intersectionIndex - 1].firstEdge ||
+                intersections[intersectionIndex].secondEdge != intersections[intersectionIndex - 1].secondEdge) {
+                ++sweepPairCount;
+            }
+        }
+        
+        std::cout << std::setw(24) << shapeName << " | varredura: " << std::fixed << std::setprecision(2)
+                  << sweepTime << " ms (" << intersections.size() << " pontos, " << sweepPairCount << " pares)";
+        if (includeNaive) {
+            size_t naivePairCount = 0;
+            double naiveTime = measureMilliseconds(1, [&]() {
+                naivePairCount = countIntersectingEdgePairsNaive(polygonVertices);
+            });
+            std::cout << " | todos os pares: " << naiveTime << " ms (" << naivePairCount << " pares)"
+                      << " | " << std::setprecision(1) << (sweepTime > 0.0 ? naiveTime / sweepTime : 0.0) << "x";
+        }
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief Lista os pares de arestas que se tocam, testando todos os pares (O(n^2)) com a convenção da varredura
+     *
+     * O polígono não pode ter vértices repetidos em sequência. Arestas
+     * consecutivas só contam quando se sobrepõem além do vértice comum.
+     */
+    static std::vector<std::pair<size_t, size_t> > findTouchingEdgePairsNaive(const std::vector<Point2D>& polygonVertices) {
+        const size_t edgeCount = polygonVertices.size();
+        auto orientation = [](const Point2D& a, const Point2D& b, const Point2D& c) {
+            long long cross = static_cast<long long>(b.coordinateX - a.coordinateX) * (c.coordinateY - a.coordinateY) -
+                              static_cast<long long>(b.coordinateY - a.coordinateY) * (c.coordinateX - a.coordinateX);
+            return (cross > 0) - (cross < 0);
+        };
+        auto isInBox = [](const Point2D& a, const Point2D& b, const Point2D& c) {
+            return std::min(a.coordinateX, b.coordinateX) <= c.coordinateX && c.coordinateX <= std::max(a.coordinateX, b.coordinateX) &&
+                   std::min(a.coordinateY, b.coordinateY) <= c.coordinateY && c.coordinateY <= std::max(a.coordinateY, b.coordinateY);
+        };
+        
+        std::vector<std::pair<size_t, size_t> > pairs;
+        for (size_t firstEdge = 0; firstEdge < edgeCount; ++firstEdge) {
+            const Point2D& a = polygonVertices[firstEdge];
+            const Point2D& b = polygonVertices[(firstEdge + 1) % edgeCount];
+            for (size_t secondEdge = firstEdge + 1; secondEdge < edgeCount; ++secondEdge) {
+                const Point2D& c = polygonVertices[secondEdge];
+                const Point2D& d = polygonVertices[(secondEdge + 1) % edgeCount];
+                if (secondEdge == firstEdge + 1 || (firstEdge == 0 && secondEdge == edgeCount - 1)) {
+                    // Vértice comum e as outras pontas das duas arestas: sobreposição só se colineares e do mesmo lado
+                    const Point2D& shared = secondEdge == firstEdge + 1 ? b : a;
+                    const Point2D& firstOther = secondEdge == firstEdge + 1 ? a : b;
+                    const Point2D& secondOther = secondEdge == firstEdge + 1 ? d : c;
+                    long long dot = static_cast<long long>(firstOther.coordinateX - shared.coordinateX) * (secondOther.coordinateX - shared.coordinateX) +
+                                    static_cast<long long>(firstOther.coordinateY - shared.coordinateY) * (secondOther.coordinateY - shared.coordinateY);
+                    if (orientation(shared, firstOther, secondOther) == 0 && dot > 0) {
+                        pairs.push_back(std::make_pair(firstEdge, secondEdge));
+                    }
+                    continue;
+                }
+                int o1 = orientation(a, b, c);
+                int o2 = orientation(a, b, d);
+                int o3 = orientation(c, d, a);
+                int o4 = orientation(c, d, b);
+                if ((o1 * o2 < 0 && o3 * o4 < 0) || (o1 == 0 && isInBox(a, b, c)) || (o2 == 0 && isInBox(a, b, d)) ||
+                    (o3 == 0 && isInBox(c, d, a)) || (o4 == 0 && isInBox(c, d, b))) {
+                    pairs.push_back(std::make_pair(firstEdge, secondEdge));
+                }
+            }
+        }
+        return pairs;
+    }
+
+    /**
+     * @brief Confere os pares relatados pela varredura com o teste de todos os pares em polígonos pequenos
+     *
+     * Vértices sorteados numa grade 5x5 geram muitos cruzamentos em pontos
+     * fracionários, colinearidades e toques em vértices. Inclui o polígono
+     * em que partes divididas em pontos arredondados trocavam de ordem e o
+     * cruzamento das arestas 5 e 8 em (8/3, 5/3) não era relatado.
+     */
+    void verifySelfIntersectionPairs(int polygonCount) const {
+        std::vector<std::vector<Point2D> > polygons;
+        polygons.push_back({ Point2D(3, 4), Point2D(2, 2), Point2D(2, 4), Point2D(1, 0), Point2D(4, 0),
+                             Point2D(4, 2), Point2D(0, 1), Point2D(0, 2), Point2D(2, 1), Point2D(3, 2) });
+        
+        unsigned int seed = 12345u;
+        auto nextRandom = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int>(seed >> 8);
+        };
+        while (static_cast<int>(polygons.size()) < polygonCount) {
+            std::vector<Point2D> vertices(static_cast<size_t>(4 + nextRandom() % 9));
+            for (Point2D& vertex : vertices) {
+                vertex = Point2D(nextRandom() % 5, nextRandom() % 5);
+            }
+            bool hasRepeatedVertex = false;
+            for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex) {
+                hasRepeatedVertex = hasRepeatedVertex || vertices[vertexIndex] == vertices[(vertexIndex + 1) % vertices.size()];
+            }
+            if (!hasRepeatedVertex) {
+                polygons.push_back(vertices);
+            }
+        }
+        
+        SelfIntersectionSweep intersectionSweep;
+        std::vector<SelfIntersection> intersections;
+        size_t mismatchCount = 0;
+        for (const std::vector<Point2D>& vertices : polygons) {
+            intersectionSweep.findIntersections(vertices, intersections);
+            std::vector<std::pair<size_t, size_t> > sweepPairs;
+            for (const SelfIntersection& intersection : intersections) {
+                sweepPairs.push_back(std::make_pair(intersection.firstEdge, intersection.secondEdge));
+            }
+            sweepPairs.erase(std::unique(sweepPairs.begin(), sweepPairs.end()), sweepPairs.end());
+            if (sweepPairs != findTouchingEdgePairsNaive(vertices)) {
+                ++mismatchCount;
+            }
+        }
+        
+        intersectionSweep.findIntersections(polygons.front(), intersections);
+        bool isCrossingReported = false;
+        for (const SelfIntersection& intersection : intersections) {
+            isCrossingReported = isCrossingReported || (intersection.firstEdge == 5 && intersection.secondEdge == 8 &&
+                                                        std::fabs(intersection.coordinateX - 8.0 / 3.0) < 1e-9 &&
+                                                        std::fabs(intersection.coordinateY - 5.0 / 3.0) < 1e-9);
+        }
+        
+        std::cout << std::setw(7) << polygons.size() << " poligonos 5x5 | pares diferentes: " << mismatchCount
+                  << " | arestas 5 e 8 em (8/3, 5/3): " << (isCrossingReported ? "relatado" : "ausente")
+                  << (mismatchCount == 0 && isCrossingReported ? "" : " DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Mede os níveis de detalhe de um contorno denso: vértices por tolerância e preenchimento simplificado
+     */
+    void compareSimplification(const std::string& shapeName, const std::vector<Point2D>& polygonVertices,
+                               SimplificationMethod method) const {
+        PolygonLevelsOfDetail levelsOfDetail;
+        size_t halfPixelCount = 0;
+        double importanceTime = measureMilliseconds(1, [&]() {
+            halfPixelCount = levelsOfDetail.getLevel(polygonVertices, method, 0.5).size();
+        });
+        
+        std::cout << std::setw(22) << shapeName
+                  << (method == SimplificationMethod::DOUGLAS_PEUCKER ? " DP" : " VW") << " | "
+                  << polygonVertices.size() << " vertices, niveis em " << std::fixed << std::setprecision(1)
+                  << importanceTime << " ms | 0.5px: " << halfPixelCount;
+        for (double tolerance : {1.0, 2.0, 4.0}) {
+            std::cout << " | " << std::setprecision(0) << tolerance << "px: "
+                      << levelsOfDetail.getLevel(polygonVertices, method, tolerance).size();
+        }
+        
+        // Preenchimento pelos vértices originais e pelo nível de meio pixel
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        const std::vector<Point2D>& simplifiedVertices = levelsOfDetail.getLevel(polygonVertices, method, 0.5);
+        SpanCountingSink originalSink;
+        SpanCountingSink simplifiedSink;
+        double originalTime = measureMilliseconds(iterations, [&]() {
+            originalSink = SpanCountingSink();
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, canvasHeight, canvasWidth, originalSink);
+        });
+        double simplifiedTime = measureMilliseconds(iterations, [&]() {
+            simplifiedSink = SpanCountingSink();
+            fillAlgorithm.fillPolygon(simplifiedVertices, fillColor, canvasHeight, canvasWidth, simplifiedSink);
+        });
+        
+        std::cout << " | preenchimento: " << std::setprecision(2) << originalTime << " -> " << simplifiedTime
+                  << " ms (pixels " << originalSink.pixelCount << " -> " << simplifiedSink.pixelCount << ")"
+                  << std::endl;
+    }
+
+    /**
+     * @brief Compara vértices inteiros com vértices 24.8: mesmos spans para Point2D e custo do subpixel
+     *
+     * A estrela é gerada em coordenadas reais; a versão em Point2D arredonda
+     * cada vértice para o pixel e a versão 24.8 para 1/256 de pixel.
+     */
+    void compareSubpixelVertices(int pointCount, int centerX, int centerY, int outerRadius, int innerRadius) const {
+        std::vector<Point2D> pixelVertices;
+        std::vector<SubpixelPoint2D> convertedVertices;
+        std::vector<SubpixelPoint2D> subpixelVertices;
+        const double pi = 3.14159265358979323846;
+        for (int vertexIndex = 0; vertexIndex < pointCount * 2; ++vertexIndex) {
+            double angle = pi * vertexIndex / pointCount;
+            int radius = (vertexIndex % 2 == 0) ? outerRadius : innerRadius;
+            double x = centerX + radius * std::cos(angle);
+            double y = centerY + radius * std::sin(angle);
+            pixelVertices.push_back(Point2D(static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y))));
+            convertedVertices.push_back(SubpixelPoint2D::fromPixel(pixelVertices.back()));
+            subpixelVertices.push_back(SubpixelPoint2D::fromCoordinates(x, y));
+        }
+        
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        ColorRGB fillColor;
+        SpanChecksumSink pixelSink;
+        SpanChecksumSink convertedSink;
+        double pixelTime = measureMilliseconds(iterations, [&]() {
+            pixelSink = SpanChecksumSink();
+            fillAlgorithm.fillPolygon(pixelVertices, fillColor, canvasHeight, canvasWidth, pixelSink);
+        });
+        double convertedTime = measureMilliseconds(iterations, [&]() {
+            convertedSink = SpanChecksumSink();
+            fillAlgorithm.fillPolygon(convertedVertices, fillColor, canvasHeight, canvasWidth, convertedSink);
+        });
+        
+        SpanCountingSink pixelCountSink;
+        SpanCountingSink subpixelCountSink;
+        fillAlgorithm.fillPolygon(pixelVertices, fillColor, canvasHeight, canvasWidth, pixelCountSink);
+        fillAlgorithm.fillPolygon(subpixelVertices, fillColor, canvasHeight, canvasWidth, subpixelCountSink);
+        
+        std::cout << "estrela " << std::setw(5) << pointCount << " pontas | "
+                  << "Point2D: " << std::fixed << std::setprecision(3) << pixelTime << " ms | "
+                  << "24.8: " << convertedTime << " ms | "
+                  << "spans identicos: " << (pixelSink.checksum == convertedSink.checksum ? "sim" : "NAO") << " | "
+                  << "pixels arredondado/subpixel: " << pixelCountSink.pixelCount << "/" << subpixelCountSink.pixelCount
+                  << std::endl;
+    }
+
+    /**
+     * @brief Polígonos salvos importados em 24.8: cada renderizador x preenchimento direto dos vértices 24.8
+     */
+    void verifySubpixelSavedPolygons(int polygonCount, int width, int height) const {
+        std::vector<PolygonManager::SavedPolygon> savedPolygons = makeSavedPolygonScene(polygonCount, width, height);
+        unsigned int seed = 54321u;
+        auto nextOffset = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int>((seed >> 8) % 255) - 127;
+        };
+        for (PolygonManager::SavedPolygon& savedPolygon : savedPolygons) {
+            for (Point2D& vertex : savedPolygon.vertices) {
+                SubpixelPoint2D subpixelVertex = SubpixelPoint2D::fromPixel(vertex);
+                subpixelVertex.fixedX += nextOffset();
+                subpixelVertex.fixedY += nextOffset();
+                savedPolygon.subpixelVertices.push_back(subpixelVertex);
+                vertex = subpixelVertex.toNearestPixel();
+            }
+        }
+        
+        PolygonFillAlgorithm fillAlgorithm;
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        CpuFramebuffer expectedFramebuffer(width, height);
+        CpuFramebuffer roundedFramebuffer(width, height);
+        FramebufferSpanSink expectedSink(expectedFramebuffer);
+        FramebufferSpanSink roundedSink(roundedFramebuffer);
+        for (const PolygonManager::SavedPolygon& savedPolygon : savedPolygons) {
+            fillAlgorithm.fillPolygon(savedPolygon.subpixelVertices, savedPolygon.configuration.fillColor, 
+                                      height, width, expectedSink);
+            fillAlgorithm.fillPolygon(savedPolygon.vertices, savedPolygon.configuration.fillColor, 
+                                      height, width, roundedSink);
+        }
+        
+        CpuFramebuffer softwareFramebuffer(width, height);
+        SoftwareRenderer softwareRenderer;
+        softwareRenderer.getFillAlgorithm().setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        softwareRenderer.renderSavedPolygons(savedPolygons, softwareFramebuffer);
+        
+        CpuFramebuffer tiledFramebuffer(width, height);
+        TileBinnedRasterizer tileRasterizer;
+        tileRasterizer.renderSavedPolygons(savedPolygons, tiledFramebuffer);
+        
+        CpuFramebuffer sweepFramebuffer(width, height);
+        ScanlineSweepRenderer sweepRenderer;
+        sweepRenderer.renderSavedPolygons(savedPolygons, sweepFramebuffer);
+        
+        CpuFramebuffer cachedFramebuffer(width, height);
+        FramebufferSpanSink cachedSink(cachedFramebuffer);
+        PolygonRasterCache rasterCache;
+        rasterCache.renderSavedPolygons(savedPolygons, fillAlgorithm, height, width, cachedSink);
+        
+        const std::vector<CpuFramebuffer::PixelType>& expectedPixels = expectedFramebuffer.getPixels();
+        auto countDifferences = [&](const CpuFramebuffer& framebuffer) {
+            size_t differenceCount = 0;
+            for (size_t pixelIndex = 0; pixelIndex < expectedPixels.size(); ++pixelIndex) {
+                differenceCount += (framebuffer.getPixels()[pixelIndex] != expectedPixels[pixelIndex]) ? 1 : 0;
+            }
+            return differenceCount;
+        };
+        size_t softwareDifferences = countDifferences(softwareFramebuffer);
+        size_t tiledDifferences = countDifferences(tiledFramebuffer);
+        size_t sweepDifferences = countDifferences(sweepFramebuffer);
+        size_t cachedDifferences = countDifferences(cachedFramebuffer);
+        bool isConsistent = softwareDifferences == 0 && tiledDifferences == 0 && 
+                            sweepDifferences == 0 && cachedDifferences == 0;
+        
+        std::cout << std::setw(6) << polygonCount << " poligonos 24.8 | pixels diferentes do preenchimento 24.8: "
+                  << "sequencial " << softwareDifferences << ", tiles " << tiledDifferences
+                  << ", varredura unica " << sweepDifferences << ", cache " << cachedDifferences
+                  << " | vertices arredondados: " << countDifferences(roundedFramebuffer)
+                  << (isConsistent ? "" : " | DIVERGENCIA") << std::endl;
+    }
+
+    /**
+     * @brief Executa todos os benchmarks e imprime os resultados no console
+     */
+    void run() const {
+        int centerX = canvasWidth / 2;
+        int centerY = canvasHeight / 2;
+        int radius = std::min(canvasWidth, canvasHeight) / 2 - 8;
+        
+        std::cout << "========================================" << std::endl;
+        std::cout << "Benchmark de preenchimento ET/AET (" << canvasWidth << "x" << canvasHeight
+                  << ", " << iterations << " repeticoes)" << std::endl;
+        std::cout << "========================================" << std::endl;
+        
+        std::cout << "-- Ordenacao da AET --" << std::endl;
+        for (int pointCount : {500, 2000, 8000}) {
+            compareActiveEdgeOrdering("estrela " + std::to_string(pointCount) + " pontas",
+                                      makeStarPolygon(pointCount, centerX, centerY, radius, radius / 3));
+        }
+        for (int vertexCount : {2000, 8000}) {
+            compareActiveEdgeOrdering("espiral " + std::to_string(vertexCount / 2) + " amostras",
+                                      makeSpiralPolygon(vertexCount, centerX, centerY, radius, 12));
+        }
+        
+        std::cout << "-- Avanco das arestas --" << std::endl;
+        compareEdgeStepping("estrela 2000 pontas", makeStarPolygon(2000, centerX, centerY, radius, radius / 3));
+        compareEdgeStepping("espiral 4000 amostras", makeSpiralPolygon(8000, centerX, centerY, radius, 12));
+        
+        std::cout << "-- Poligono em edicao (GraphicsRenderer, 1920x1080) --" << std::endl;
+        compareEditedPolygonFill("estrela 200 pontas", makeStarPolygon(200, 960, 540, 500, 170), 1920, 1080);
+        compareEditedPolygonFill("espiral 500 amostras", makeSpiralPolygon(1000, 960, 540, 500, 6), 1920, 1080);
+        
+        std::cout << "-- Layout da AET (AoS x SoA) --" << std::endl;
+        for (int toothCount : {100, 500, 2000}) {
+            compareActiveEdgeLayout("hachura " + std::to_string(toothCount) + " dentes",
+                                    makeHatchPolygon(toothCount, 4, 4, canvasWidth - 8, canvasHeight - 8));
+        }
+        compareActiveEdgeLayout("estrela 2000 pontas", makeStarPolygon(2000, centerX, centerY, radius, radius / 3));
+        
+        std::cout << "-- Saida em trapezios --" << std::endl;
+        compareTrapezoidOutput("quadrado", makeRegularPolygon(4, centerX, centerY, radius));
+        compareTrapezoidOutput("estrela 64 pontas", makeStarPolygon(64, centerX, centerY, radius, radius / 3));
+        compareTrapezoidOutput("estrela 2000 pontas", makeStarPolygon(2000, centerX, centerY, radius, radius / 3));
+        compareTrapezoidOutput("espiral 4000 amostras", makeSpiralPolygon(8000, centerX, centerY, radius, 12));
+        
+        std::cout << "-- Caminho rapido para poligonos convexos --" << std::endl;
+        compareConvexFastPath(10000, 4, 16);
+        compareConvexFastPath(1000, 32, 64);
+        compareConvexFastPath(10, 1024, radius);
+        
+        std::cout << "-- Antisserrilhamento por cobertura analitica --" << std::endl;
+        compareAntialiasedFill("estrela 64 pontas", makeStarPolygon(64, centerX, centerY, radius, radius / 3));
+        compareAntialiasedFill("estrela 2000 pontas", makeStarPolygon(2000, centerX, centerY, radius, radius / 3));
+        
+        std::cout << "-- Escrita de spans (7680 x 512) --" << std::endl;
+        measureSpanWriteThroughput<PixelFormatRGBA8>("RGBA8");
+        measureSpanWriteThroughput<PixelFormatBGRA8>("BGRA8");
+        measureSpanWriteThroughput<PixelFormatRGB565>("RGB565");
+        measureSpanWriteThroughput<PixelFormatIndexed8>("indexado 8 bits");
+        
+        std::cout << "-- Shaders de span --" << std::endl;
+        compareSpanShaders("quadrado", makeRegularPolygon(4, centerX, centerY, radius));
+        compareSpanShaders("estrela 64 pontas", makeStarPolygon(64, centerX, centerY, radius, radius / 3));
+        
+        std::cout << "-- Cor por vertice (Gouraud) --" << std::endl;
+        compareGouraudFill<PixelFormatRGBA8>("quadrado RGBA8", makeRegularPolygon(4, centerX, centerY, radius));
+        compareGouraudFill<PixelFormatRGB565>("quadrado RGB565", makeRegularPolygon(4, centerX, centerY, radius));
+        compareGouraudFill<PixelFormatIndexed8>("quadrado indexado", makeRegularPolygon(4, centerX, centerY, radius));
+        compareGouraudFill<PixelFormatRGBA8>("estrela 64 pontas RGBA8", makeStarPolygon(64, centerX, centerY, radius, radius / 3));
+        
+        std::cout << "-- Preenchimento em faixas paralelas --" << std::endl;
+        measureBandParallelScaling("contorno SIG", makeCoastlinePolygon(200000, 2048, 8192, 2000, 8000), 4096, 16384);
+        
+        std::cout << "-- Poligonos salvos: sequencial x tiles --" << std::endl;
+        compareSavedPolygonRasterizers(1000, 1920, 1080);
+        compareSavedPolygonRasterizers(5000, 1920, 1080);
+        compareTiledLargePolygon(20000, 4096, 4096);
+        compareSweepFillRules(1000, 1920, 1080);
+        compareRasterCacheReplay(1000, 1920, 1080);
+        compareRasterCacheReplay(5000, 1920, 1080);
+        
+        std::cout << "-- Teste de ponto (mascara de runs) --" << std::endl;
+        compareHitTesting("estrela 2000 pontas", makeStarPolygon(2000, centerX, centerY, radius, radius / 3),
+                          canvasWidth, canvasHeight, 20000);
+        compareHitTesting("contorno SIG", makeCoastlinePolygon(100000, 2048, 2048, 2000, 2000), 4096, 4096, 2000);
+        compareSavedPolygonHitTesting(1000, 1920, 1080, 2000);
+        compareSavedPolygonHitTesting(5000, 1920, 1080, 2000);
+        
+        std::cout << "-- Sobreposicao translucida (alpha pre-multiplicado) --" << std::endl;
+        compareTranslucentOverlay(1000, 1920, 1080);
+        compareTranslucentOverlay(5000, 1920, 1080);
+        
+        std::cout << "-- Operacoes booleanas (varredura) --" << std::endl;
+        for (int vertexCount : {1000, 10000, 100000}) {
+            compareBooleanOperations(vertexCount, 4096, 4096);
+        }
+        
+        std::cout << "-- Operacoes booleanas x mascaras de pixels --" << std::endl;
+        for (int vertexCount : {1000, 10000, 100000}) {
+            verifyBooleanOperations(vertexCount, 4096, 4096);
+        }
+        
+        std::cout << "-- Autointersecoes (Bentley-Ottmann) --" << std::endl;
+        // Contornos em escala de importação (raio = n): simples, sem arredondamento criando cruzamentos
+        for (int vertexCount : {1000, 10000, 100000}) {
+            compareSelfIntersectionCheck("contorno SIG " + std::to_string(vertexCount),
+                                         makeCoastlinePolygon(vertexCount, vertexCount, vertexCount, vertexCount, vertexCount),
+                                         vertexCount <= 10000);
+        }
+        compareSelfIntersectionCheck("estrela {1001/3}", makeStarPolygram(1001, 3, centerX, centerY, radius), true);
+        compareSelfIntersectionCheck("estrela {100003/3}", makeStarPolygram(100003, 3, 10000000, 10000000, 10000000), false);
+        verifySelfIntersectionPairs(20000);
+        
+        std::cout << "-- Niveis de detalhe (Douglas-Peucker x Visvalingam-Whyatt) --" << std::endl;
+        for (SimplificationMethod method : {SimplificationMethod::DOUGLAS_PEUCKER, SimplificationMethod::VISVALINGAM_WHYATT}) {
+            compareSimplification("contorno SIG 10000", makeCoastlinePolygon(10000, centerX, centerY, radius, radius), method);
+            compareSimplification("contorno SIG 200000", makeCoastlinePolygon(200000, centerX, centerY, radius, radius), method);
+        }
+        
+        std::cout << "-- Vertices em ponto fixo 24.8 --" << std::endl;
+        compareSubpixelVertices(64, centerX, centerY, radius, radius / 3);
+        compareSubpixelVertices(2000, centerX, centerY, radius, radius / 3);
+        verifySubpixelSavedPolygons(1000, 1920, 1080);
+    }
+};
+
+#endif // FILL_BENCHMARK_H
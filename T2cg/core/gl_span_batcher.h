@@ -0,0 +1,223 @@
+/**
+ * @file gl_span_batcher.h
+ * @brief Acumula spans em um vertex array e desenha todos com uma única chamada
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef GL_SPAN_BATCHER_H
+#define GL_SPAN_BATCHER_H
+
+#include "data_structures.h"
+#include <GL/gl.h>
+#include <vector>
+
+/**
+ * @struct SpanBatchVertex
+ * @brief Vértice intercalado cor + posição (layout GL_C4UB_V2F)
+ */
+struct SpanBatchVertex {
+    GLubyte redComponent;
+    GLubyte greenComponent;
+    GLubyte blueComponent;
+    GLubyte alphaComponent;
+    GLfloat coordinateX;
+    GLfloat coordinateY;
+};
+
+/**
+ * @class GLVertexBatch
+ * @brief Vertex array intercalado de uma primitiva GL, desenhado com um único glDrawArrays
+ *
+ * Base comum dos lotes de spans (GL_LINES) e de trapézios (GL_TRIANGLES):
+ * guarda os vértices, a cor corrente já convertida em bytes e se algum
+ * vértice é translúcido. A memória do array é reaproveitada entre quadros.
+ */
+class GLVertexBatch {
+private:
+    GLenum primitiveMode;
+    std::vector<SpanBatchVertex> vertices;
+    ColorRGB cachedColor;
+    GLubyte cachedRed, cachedGreen, cachedBlue, cachedAlpha;
+    bool hasCachedColor;
+    bool hasTranslucentVertices;
+
+public:
+    /**
+     * @brief Componente de cor (0.0 - 1.0) em um byte, como enviado ao GL
+     */
+    static GLubyte toColorByte(float component) {
+        if (component <= 0.0f) return 0;
+        if (component >= 1.0f) return 255;
+        return static_cast<GLubyte>(component * 255.0f + 0.5f);
+    }
+
+    explicit GLVertexBatch(GLenum mode) 
+        : primitiveMode(mode), cachedRed(0), cachedGreen(0), cachedBlue(0), cachedAlpha(255), 
+          hasCachedColor(false), hasTranslucentVertices(false) {}
+
+    /**
+     * @brief Define a cor dos próximos appendVertex(x, y); a conversão é refeita só quando a cor muda
+     */
+    void setColor(const ColorRGB& color) {
+        if (!hasCachedColor || color != cachedColor) {
+            cachedColor = color;
+            cachedRed = toColorByte(color.redComponent);
+            cachedGreen = toColorByte(color.greenComponent);
+            cachedBlue = toColorByte(color.blueComponent);
+            cachedAlpha = toColorByte(color.alphaComponent);
+            hasCachedColor = true;
+        }
+        if (cachedAlpha != 255) {
+            hasTranslucentVertices = true;
+        }
+    }
+
+    /**
+     * @brief Acrescenta um vértice com a cor de setColor
+     */
+    void appendVertex(GLfloat coordinateX, GLfloat coordinateY) {
+        SpanBatchVertex vertex = { cachedRed, cachedGreen, cachedBlue, cachedAlpha, coordinateX, coordinateY };
+        vertices.push_back(vertex);
+    }
+
+    /**
+     * @brief Acrescenta um vértice com cor própria
+     */
+    void appendVertex(const SpanBatchVertex& vertex) {
+        if (vertex.alphaComponent != 255) {
+            hasTranslucentVertices = true;
+        }
+        vertices.push_back(vertex);
+    }
+
+    /**
+     * @brief Acrescenta, com uma cópia, vértices já montados de uma única cor
+     */
+    void appendVertices(const std::vector<SpanBatchVertex>& batchVertices) {
+        if (batchVertices.empty()) {
+            return;
+        }
+        if (batchVertices.front().alphaComponent != 255) {
+            hasTranslucentVertices = true;
+        }
+        vertices.insert(vertices.end(), batchVertices.begin(), batchVertices.end());
+    }
+
+    size_t getVertexCount() const {
+        return vertices.size();
+    }
+
+    /**
+     * @brief Descarta os vértices pendentes mantendo a capacidade alocada
+     */
+    void clear() {
+        vertices.clear();
+        hasTranslucentVertices = false;
+    }
+
+    /**
+     * @brief Desenha todos os vértices pendentes com um glDrawArrays e esvazia o lote
+     *
+     * Requer um contexto OpenGL ativo. Altera a cor corrente de vértice.
+     * Se algum item do lote é translúcido, o desenho é feito com
+     * GL_BLEND (SRC_ALPHA, ONE_MINUS_SRC_ALPHA); o estado anterior é restaurado.
+     */
+    void flush() {
+        if (vertices.empty()) {
+            return;
+        }
+        
+        if (hasTranslucentVertices) {
+            glPushAttrib(GL_COLOR_BUFFER_BIT);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        glInterleavedArrays(GL_C4UB_V2F, 0, vertices.data());
+        glDrawArrays(primitiveMode, 0, static_cast<GLsizei>(vertices.size()));
+        glPopClientAttrib();
+        
+        if (hasTranslucentVertices) {
+            glPopAttrib();
+        }
+        
+        clear();
+    }
+};
+
+/**
+ * @class GLSpanBatcher
+ * @brief Destino de spans que agrupa tudo em um vertex array de GL_LINES
+ *
+ * Cada span vira um segmento [startX, endX + 1) com a cor em cada vértice,
+ * inclusive os spans de um pixel (antes desenhados com GL_POINTS), então um
+ * quadro inteiro de preenchimentos sai em um só glDrawArrays. A ordem do
+ * array é a ordem de emissão, o que preserva a ordem do pintor.
+ */
+class GLSpanBatcher {
+private:
+    GLVertexBatch vertexBatch;
+
+public:
+    GLSpanBatcher() : vertexBatch(GL_LINES) {}
+
+    /**
+     * @brief Acrescenta o span [startX, endX] da scanline ao lote
+     */
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB& color) {
+        vertexBatch.setColor(color);
+        vertexBatch.appendVertex(static_cast<GLfloat>(startX), static_cast<GLfloat>(scanLine));
+        vertexBatch.appendVertex(static_cast<GLfloat>(endX + 1), static_cast<GLfloat>(scanLine));
+    }
+
+    /**
+     * @brief Acrescenta um span com cor interpolada; o GL interpola a cor ao longo da linha
+     */
+    void emitShadedSpan(int scanLine, int startX, int endX, 
+                        const ColorRGB& startColor, const ColorRGB& endColor) {
+        SpanBatchVertex startVertex = { GLVertexBatch::toColorByte(startColor.redComponent), 
+                                        GLVertexBatch::toColorByte(startColor.greenComponent),
+                                        GLVertexBatch::toColorByte(startColor.blueComponent), 
+                                        GLVertexBatch::toColorByte(startColor.alphaComponent),
+                                        static_cast<GLfloat>(startX), static_cast<GLfloat>(scanLine) };
+        SpanBatchVertex endVertex = { GLVertexBatch::toColorByte(endColor.redComponent), 
+                                      GLVertexBatch::toColorByte(endColor.greenComponent),
+                                      GLVertexBatch::toColorByte(endColor.blueComponent), 
+                                      GLVertexBatch::toColorByte(endColor.alphaComponent),
+                                      static_cast<GLfloat>(endX + 1), static_cast<GLfloat>(scanLine) };
+        vertexBatch.appendVertex(startVertex);
+        vertexBatch.appendVertex(endVertex);
+    }
+
+    /**
+     * @brief Acrescenta ao lote, com uma cópia, vértices já montados de uma única cor (ex.: um polígono em cache)
+     */
+    void appendVertices(const std::vector<SpanBatchVertex>& batchVertices) {
+        vertexBatch.appendVertices(batchVertices);
+    }
+
+    /**
+     * @brief Número de spans pendentes no lote
+     */
+    size_t getPendingSpanCount() const {
+        return vertexBatch.getVertexCount() / 2;
+    }
+
+    /**
+     * @brief Descarta os spans pendentes mantendo a capacidade alocada
+     */
+    void clear() {
+        vertexBatch.clear();
+    }
+
+    /**
+     * @brief Desenha todos os spans pendentes (ver GLVertexBatch::flush)
+     */
+    void flush() {
+        vertexBatch.flush();
+    }
+};
+
+#endif // GL_SPAN_BATCHER_H
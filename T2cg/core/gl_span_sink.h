@@ -0,0 +1,60 @@
+/**
+ * @file gl_span_sink.h
+ * @brief Destino de spans que desenha diretamente com OpenGL imediato
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef GL_SPAN_SINK_H
+#define GL_SPAN_SINK_H
+
+#include "data_structures.h"
+#include <GL/gl.h>
+
+/**
+ * @class GLSpanSink
+ * @brief Desenha cada span como uma linha horizontal (GL_LINES)
+ *
+ * Spans de um único pixel (sobra de contagem ímpar na AET) são desenhados
+ * como GL_POINTS, reproduzindo o comportamento original de fillPolygon.
+ * Requer um contexto OpenGL ativo.
+ * O alpha da cor é repassado ao GL; a composição só ocorre se o chamador
+ * tiver ligado GL_BLEND.
+ */
+class GLSpanSink {
+private:
+    ColorRGB currentColor;
+    bool hasCurrentColor;
+
+public:
+    GLSpanSink() : hasCurrentColor(false) {}
+
+    /**
+     * @brief Desenha o span [startX, endX] na scanline indicada
+     * @param scanLine Coordenada Y do span
+     * @param startX Primeiro pixel do span
+     * @param endX Último pixel do span (inclusivo)
+     * @param color Cor do span
+     */
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB& color) {
+        if (!hasCurrentColor || color != currentColor) {
+            glColor4f(color.redComponent, color.greenComponent, color.blueComponent, color.alphaComponent);
+            currentColor = color;
+            hasCurrentColor = true;
+        }
+        
+        if (startX == endX) {
+            glBegin(GL_POINTS);
+            glVertex2i(startX, scanLine);
+            glEnd();
+            return;
+        }
+        
+        glBegin(GL_LINES); // Usar linhas para preencher o span horizontal
+        glVertex2i(startX, scanLine);
+        glVertex2i(endX + 1, scanLine);
+        glEnd();
+    }
+};
+
+#endif // GL_SPAN_SINK_H
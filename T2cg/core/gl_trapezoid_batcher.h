@@ -0,0 +1,75 @@
+/**
+ * @file gl_trapezoid_batcher.h
+ * @brief Acumula trapézios da varredura como pares de triângulos e desenha todos com uma única chamada
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef GL_TRAPEZOID_BATCHER_H
+#define GL_TRAPEZOID_BATCHER_H
+
+#include "data_structures.h"
+#include "gl_span_batcher.h"
+#include "trapezoid_sweep.h"
+#include <GL/gl.h>
+
+/**
+ * @class GLTrapezoidBatcher
+ * @brief Destino de trapézios que agrupa tudo em um vertex array de GL_TRIANGLES
+ *
+ * Cada trapézio vira dois triângulos com os cantos exatos das arestas nas
+ * alturas firstScanLine e lastScanLine + 1. Como o GL também amostra no
+ * centro do pixel, o resultado coincide com os spans do INTEGER_DDA
+ * (a menos das regras de desempate do rasterizador), com uma fração das
+ * primitivas. Usa o mesmo GLVertexBatch do GLSpanBatcher.
+ */
+class GLTrapezoidBatcher {
+private:
+    GLVertexBatch vertexBatch;
+
+    void appendVertex(double coordinateX, double coordinateY) {
+        vertexBatch.appendVertex(static_cast<GLfloat>(coordinateX), static_cast<GLfloat>(coordinateY));
+    }
+
+public:
+    GLTrapezoidBatcher() : vertexBatch(GL_TRIANGLES) {}
+
+    /**
+     * @brief Acrescenta o trapézio ao lote como dois triângulos
+     */
+    void emitTrapezoid(const ScanlineTrapezoid& trapezoid, const ColorRGB& color) {
+        vertexBatch.setColor(color);
+        
+        TrapezoidCorners corners = trapezoid.getCorners();
+        appendVertex(corners.topLeftX, corners.topY);
+        appendVertex(corners.topRightX, corners.topY);
+        appendVertex(corners.bottomLeftX, corners.bottomY);
+        
+        appendVertex(corners.topRightX, corners.topY);
+        appendVertex(corners.bottomRightX, corners.bottomY);
+        appendVertex(corners.bottomLeftX, corners.bottomY);
+    }
+
+    /**
+     * @brief Número de trapézios pendentes no lote
+     */
+    size_t getPendingTrapezoidCount() const {
+        return vertexBatch.getVertexCount() / 6;
+    }
+
+    /**
+     * @brief Descarta os trapézios pendentes mantendo a capacidade alocada
+     */
+    void clear() {
+        vertexBatch.clear();
+    }
+
+    /**
+     * @brief Desenha todos os trapézios pendentes (ver GLVertexBatch::flush)
+     */
+    void flush() {
+        vertexBatch.flush();
+    }
+};
+
+#endif // GL_TRAPEZOID_BATCHER_H
@@ -12,7 +12,14 @@
 
 #include "data_structures.h"
 #include "polygon_fill_algorithm.h"
+#include "gl_span_batcher.h"
+#include "gl_trapezoid_batcher.h"
 #include "polygon_manager.h"
+#include "polygon_raster_cache.h"
+#include "polygon_span_mask.h"
+#include "incremental_fill.h"
+#include "trapezoid_sweep.h"
+#include "self_intersection.h"
 #include <string>
 #include <GL/glut.h>
 #include <GL/gl.h>
@@ -20,9 +27,92 @@
 class GraphicsRenderer {
 private:
     PolygonFillAlgorithm fillAlgorithm;
+    mutable GLSpanBatcher spanBatcher;    // Reaproveitado entre quadros
+    mutable PolygonRasterCache rasterCache;
+    mutable PolygonHitTester hitTester;    // Máscaras para a seleção com o mouse
+    mutable IncrementalPolygonFill editedPolygonFill;
+    mutable TrapezoidSweep trapezoidSweep;
+    mutable GLTrapezoidBatcher trapezoidBatcher;
+    bool isTrapezoidOutputEnabled;
+    SimplificationMethod simplificationMethod;
+    double outlineTolerance;    // Pixels; a área 2D é desenhada 1:1 (glOrtho do tamanho da janela)
+    double fillTolerance;
 
 public:
-    GraphicsRenderer() {}
+    GraphicsRenderer() 
+        : isTrapezoidOutputEnabled(false), simplificationMethod(SimplificationMethod::DOUGLAS_PEUCKER),
+          outlineTolerance(0.5), fillTolerance(0.0) {
+        // Arestas inteiras: o polígono em edição é revarrido só nas linhas
+        // alteradas e os salvos convexos usam o caminho rápido, com os mesmos pixels
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+    }
+
+    /**
+     * @brief Define a representação das arestas de todos os preenchimentos
+     *
+     * INTEGER_DDA (padrão) amostra o centro do pixel exatamente e habilita o
+     * preenchimento incremental do polígono em edição e o caminho rápido dos
+     * convexos; FLOATING_POINT refaz tudo a cada quadro e desliga a saída em
+     * trapézios. Descarta o cache.
+     */
+    void setEdgeSteppingMode(EdgeSteppingMode steppingMode) {
+        if (steppingMode != EdgeSteppingMode::INTEGER_DDA) {
+            isTrapezoidOutputEnabled = false;
+        }
+        if (steppingMode != fillAlgorithm.getEdgeSteppingMode()) {
+            fillAlgorithm.setEdgeSteppingMode(steppingMode);
+            rasterCache.invalidate();
+            hitTester.invalidate();
+        }
+    }
+
+    EdgeSteppingMode getEdgeSteppingMode() const {
+        return fillAlgorithm.getEdgeSteppingMode();
+    }
+
+    /**
+     * @brief Liga a saída em trapézios (dois triângulos cada) no lugar de um span por scanline
+     *
+     * Vale para fillPolygon. Os trapézios seguem as arestas inteiras do
+     * INTEGER_DDA e, no modo FLOATING_POINT, pintariam até um pixel a mais ou
+     * a menos em cada borda do que os spans; por isso ligar a saída também
+     * passa o renderer para INTEGER_DDA, e voltar a FLOATING_POINT a desliga.
+     */
+    void setTrapezoidOutputEnabled(bool enabled) {
+        isTrapezoidOutputEnabled = enabled;
+        if (enabled) {
+            setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+        }
+    }
+
+    bool getTrapezoidOutputEnabled() const {
+        return isTrapezoidOutputEnabled;
+    }
+
+    /**
+     * @brief Define o nível de detalhe dos polígonos salvos
+     * @param method Algoritmo de simplificação
+     * @param outlineTolerancePixels Tolerância dos contornos (0 = todos os vértices)
+     * @param fillTolerancePixels Tolerância dos preenchimentos (0 = vértices originais, spans exatos)
+     */
+    void setSimplification(SimplificationMethod method, double outlineTolerancePixels, double fillTolerancePixels) {
+        simplificationMethod = method;
+        outlineTolerance = outlineTolerancePixels;
+        fillTolerance = fillTolerancePixels;
+        rasterCache.setSimplification(method, fillTolerancePixels);
+    }
+
+    SimplificationMethod getSimplificationMethod() const {
+        return simplificationMethod;
+    }
+
+    double getOutlineTolerance() const {
+        return outlineTolerance;
+    }
+
+    double getFillTolerance() const {
+        return fillTolerance;
+    }
 
     void renderPolygon(const std::vector<Point2D>& polygonVertices, 
                       const PolygonConfiguration& configuration,
@@ -63,6 +153,26 @@ public:
         glPointSize(1.0f);
     }
 
+    /**
+     * @brief Marca em vermelho os pontos de autointerseção do polígono fechado
+     */
+    void renderSelfIntersections(const std::vector<SelfIntersection>& selfIntersections) const {
+        if (selfIntersections.empty()) {
+            return;
+        }
+        
+        glColor3f(1.0f, 0.0f, 0.0f);
+        glPointSize(8.0f);
+        
+        glBegin(GL_POINTS);
+        for (const SelfIntersection& intersection : selfIntersections) {
+            glVertex2d(intersection.coordinateX, intersection.coordinateY);
+        }
+        glEnd();
+        
+        glPointSize(1.0f);
+    }
+
     void fillPolygon(const std::vector<Point2D>& polygonVertices, 
                     const ColorRGB& fillColor,
                     int maxHeight,
@@ -71,13 +181,92 @@ public:
             return;
         }
         
-        fillAlgorithm.fillPolygon(polygonVertices, fillColor, maxHeight, maxWidth);
+        if (isTrapezoidOutputEnabled) {
+            trapezoidSweep.getFillAlgorithm().setFillRule(fillAlgorithm.getFillRule());
+            trapezoidSweep.sweepPolygon(polygonVertices, fillColor, maxHeight, maxWidth, trapezoidBatcher);
+            trapezoidBatcher.flush();
+            return;
+        }
+        
+        fillAlgorithm.fillPolygon(polygonVertices, fillColor, maxHeight, maxWidth, spanBatcher);
+        spanBatcher.flush();
+    }
+
+    /**
+     * @brief Preenche o polígono com uma cor por vértice (Gouraud 2D), sem triangular
+     */
+    void fillPolygonGouraud(const std::vector<Point2D>& polygonVertices, 
+                            const std::vector<ColorRGB>& vertexColors,
+                            int maxHeight,
+                            int maxWidth) const {
+        fillAlgorithm.fillPolygonGouraud(polygonVertices, vertexColors, maxHeight, maxWidth, spanBatcher);
+        spanBatcher.flush();
     }
 
     // renderText removed
 
     // renderUserInterface removed (Migrated to Qt)
 
+    /**
+     * @brief Preenche o polígono em edição revarrendo só as scanlines alteradas
+     *
+     * Usa IncrementalPolygonFill (arestas inteiras), então após acrescentar ou
+     * remover o último vértice apenas a faixa Y das arestas trocadas é refeita.
+     * Isso só vale no modo INTEGER_DDA; nos demais modos o polígono é
+     * varrido inteiro, com a mesma amostragem da sua cópia salva.
+     */
+    template <typename SpanSink>
+    void fillEditedPolygon(const std::vector<Point2D>& polygonVertices, 
+                           const ColorRGB& fillColor,
+                           int maxHeight,
+                           int maxWidth,
+                           SpanSink& spanSink) const {
+        if (fillAlgorithm.getEdgeSteppingMode() != EdgeSteppingMode::INTEGER_DDA) {
+            fillAlgorithm.fillPolygon(polygonVertices, fillColor, maxHeight, maxWidth, spanSink);
+            return;
+        }
+        
+        editedPolygonFill.setFillRule(fillAlgorithm.getFillRule());
+        editedPolygonFill.update(polygonVertices, maxHeight, maxWidth);
+        if (polygonVertices.size() < 3) {
+            return;
+        }
+        
+        editedPolygonFill.emitSpans(fillColor, spanSink);
+    }
+
+    void fillEditedPolygon(const std::vector<Point2D>& polygonVertices, 
+                           const ColorRGB& fillColor,
+                           int maxHeight,
+                           int maxWidth) const {
+        fillEditedPolygon(polygonVertices, fillColor, maxHeight, maxWidth, spanBatcher);
+        spanBatcher.flush();
+    }
+
+    /**
+     * @brief Scanlines revarridas pelo último fillEditedPolygon no modo INTEGER_DDA
+     */
+    size_t getEditedPolygonRescannedRowCount() const {
+        return editedPolygonFill.getRescannedRowCount();
+    }
+
+    /**
+     * @brief Índice do polígono salvo preenchido mais acima sob o pixel (x, y), ou -1
+     *
+     * Usa as mesmas regras de preenchimento do desenho, então o polígono
+     * escolhido é o que pinta o pixel clicado.
+     */
+    int findSavedPolygonAt(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, int x, int y) const {
+        return hitTester.findPolygonAt(savedPolygons, fillAlgorithm, x, y);
+    }
+
+    /**
+     * @brief Descarta os spans em cache dos polígonos salvos (chamar no reshape)
+     */
+    void invalidateRasterCache() {
+        rasterCache.invalidate();
+    }
+
     void clearDrawingArea(const WindowDimensions* windowDims) const {
         glColor3f(0.0f, 0.0f, 0.0f);
         glRecti(0, 0, windowDims->drawingAreaWidth, windowDims->drawingAreaHeight);
@@ -88,13 +277,18 @@ public:
     void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, 
                            int maxHeight, 
                            int maxWidth) const {
+        // Todos os preenchimentos em um único lote, na ordem dos polígonos
+        rasterCache.renderSavedPolygons(savedPolygons, fillAlgorithm, maxHeight, maxWidth, spanBatcher);
+        spanBatcher.flush();
+        
+        // Contornos e vértices por cima dos preenchimentos; o contorno usa o
+        // nível de detalhe, então contornos densos custam o tamanho na tela.
+        // Buracos são linhas próprias, sem as pontes do anel preenchido
         for (const auto& savedPolygon : savedPolygons) {
-            renderPolygon(savedPolygon.vertices, savedPolygon.configuration, true);
-            
-            if (savedPolygon.isFilled) {
-                fillPolygon(savedPolygon.vertices, savedPolygon.configuration.fillColor, maxHeight, maxWidth);
+            for (size_t outlineIndex = 0; outlineIndex < savedPolygon.getOutlineCount(); ++outlineIndex) {
+                renderPolygon(savedPolygon.getSimplifiedOutline(outlineIndex, simplificationMethod, outlineTolerance),
+                              savedPolygon.configuration, true);
             }
-            
             renderPolygonVertices(savedPolygon.vertices, savedPolygon.configuration.showVertices);
         }
     }
@@ -0,0 +1,214 @@
+/**
+ * @file incremental_fill.h
+ * @brief Preenchimento incremental do polígono em edição
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef INCREMENTAL_FILL_H
+#define INCREMENTAL_FILL_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class IncrementalPolygonFill
+ * @brief Mantém os spans do polígono em edição e revarre só as scanlines afetadas
+ *
+ * Acrescentar ou remover o último vértice troca no máximo três arestas: a
+ * aresta de fechamento (último -> primeiro) e as arestas que tocam o vértice.
+ * Com as arestas inteiras (INTEGER_DDA) cada scanline depende apenas das
+ * arestas que a cruzam, então basta refazer as linhas dentro do intervalo
+ * Y dessas arestas. Qualquer outra alteração (ou mudança de tamanho da
+ * janela) provoca uma varredura completa.
+ *
+ * Os spans ficam em um único vetor com o início de cada linha em rowStarts
+ * (como em PolygonSpanMask); uma edição substitui apenas a fatia da faixa
+ * revarrida, e nenhuma varredura aloca por scanline.
+ */
+class IncrementalPolygonFill {
+private:
+    struct RowSpan {
+        int startX;
+        int endX;    // Inclusivo
+    };
+
+    /**
+     * @brief Destino de spans que grava a faixa revarrida (as scanlines chegam em ordem crescente)
+     */
+    struct BandRecordingSink {
+        std::vector<RowSpan>* spans;
+        std::vector<std::uint32_t>* rowCounts;
+        int bandStart;
+
+        void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+            RowSpan span = { startX, endX };
+            spans->push_back(span);
+            (*rowCounts)[scanLine - bandStart]++;
+        }
+    };
+
+    PolygonFillAlgorithm fillAlgorithm;
+    FixedCompactEdgeTable edgeTable;
+    std::vector<Point2D> trackedVertices;
+    std::vector<RowSpan> rowSpans;               // Spans de todas as linhas, em ordem de scanline
+    std::vector<std::uint32_t> rowStarts;        // Linha y ocupa rowSpans[rowStarts[y], rowStarts[y + 1])
+    std::vector<RowSpan> bandSpans;              // Faixa revarrida, antes de entrar em rowSpans
+    std::vector<std::uint32_t> bandRowCounts;
+    int trackedHeight;
+    int trackedWidth;
+    size_t rescannedRowCount;    // Linhas revarridas na última atualização
+
+    static bool sharesPrefix(const std::vector<Point2D>& longer, const std::vector<Point2D>& shorter) {
+        for (size_t vertexIndex = 0; vertexIndex < shorter.size(); ++vertexIndex) {
+            if (longer[vertexIndex].coordinateX != shorter[vertexIndex].coordinateX ||
+                longer[vertexIndex].coordinateY != shorter[vertexIndex].coordinateY) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Revarre as scanlines [bandStart, bandEnd) do polígono
+     */
+    void rescanBand(const std::vector<Point2D>& polygonVertices, int bandStart, int bandEnd) {
+        bandStart = std::max(bandStart, 0);
+        bandEnd = std::min(bandEnd, trackedHeight);
+        if (bandStart >= bandEnd) {
+            return;
+        }
+        
+        rescannedRowCount += static_cast<size_t>(bandEnd - bandStart);
+        
+        bandSpans.clear();
+        bandRowCounts.assign(static_cast<size_t>(bandEnd - bandStart), 0);
+        if (polygonVertices.size() >= 3) {
+            fillAlgorithm.buildFixedEdgeTable(polygonVertices, bandStart, bandEnd, edgeTable, trackedWidth);
+            BandRecordingSink recordingSink = { &bandSpans, &bandRowCounts, bandStart };
+            fillAlgorithm.scanConvertFixedEdgeTable(edgeTable, ColorRGB(), bandEnd, trackedWidth, recordingSink);
+        }
+        
+        // Substitui a fatia da faixa em rowSpans e desloca os índices das linhas abaixo dela
+        size_t sliceBegin = rowStarts[bandStart];
+        size_t sliceEnd = rowStarts[bandEnd];
+        if (bandSpans.size() > sliceEnd - sliceBegin) {
+            rowSpans.insert(rowSpans.begin() + sliceEnd, bandSpans.size() - (sliceEnd - sliceBegin), RowSpan());
+        } else {
+            rowSpans.erase(rowSpans.begin() + sliceBegin + bandSpans.size(), rowSpans.begin() + sliceEnd);
+        }
+        std::copy(bandSpans.begin(), bandSpans.end(), rowSpans.begin() + sliceBegin);
+        
+        for (int scanLine = bandStart; scanLine < bandEnd; ++scanLine) {
+            rowStarts[scanLine + 1] = rowStarts[scanLine] + bandRowCounts[scanLine - bandStart];
+        }
+        std::uint32_t shift = rowStarts[bandEnd] - static_cast<std::uint32_t>(sliceEnd);
+        for (size_t scanLine = static_cast<size_t>(bandEnd) + 1; scanLine < rowStarts.size(); ++scanLine) {
+            rowStarts[scanLine] += shift;
+        }
+    }
+
+    /**
+     * @brief Faixa de scanlines coberta pelos vértices de uma edição no fim da lista
+     * @param lastCommon Último vértice comum às duas versões
+     * @param firstVertex Primeiro vértice (fecha o polígono)
+     * @param editedVertex Vértice acrescentado ou removido
+     */
+    void rescanEditedVertex(const std::vector<Point2D>& polygonVertices,
+                            const Point2D& lastCommon, 
+                            const Point2D& firstVertex, 
+                            const Point2D& editedVertex) {
+        int bandStart = std::min(std::min(lastCommon.coordinateY, firstVertex.coordinateY), editedVertex.coordinateY);
+        int bandEnd = std::max(std::max(lastCommon.coordinateY, firstVertex.coordinateY), editedVertex.coordinateY);
+        rescanBand(polygonVertices, bandStart, bandEnd);
+    }
+
+public:
+    IncrementalPolygonFill() : trackedHeight(-1), trackedWidth(-1), rescannedRowCount(0) {
+        fillAlgorithm.setEdgeSteppingMode(EdgeSteppingMode::INTEGER_DDA);
+    }
+
+    /**
+     * @brief Descarta os spans guardados; a próxima atualização varre tudo
+     */
+    void reset() {
+        trackedVertices.clear();
+        rowSpans.clear();
+        rowStarts.clear();
+        trackedHeight = -1;
+        trackedWidth = -1;
+    }
+
+    /**
+     * @brief Define a regra de preenchimento (descarta os spans guardados se ela mudar)
+     */
+    void setFillRule(FillRule rule) {
+        if (rule != fillAlgorithm.getFillRule()) {
+            fillAlgorithm.setFillRule(rule);
+            reset();
+        }
+    }
+
+    /**
+     * @brief Número de scanlines revarridas na última chamada a update
+     */
+    size_t getRescannedRowCount() const {
+        return rescannedRowCount;
+    }
+
+    /**
+     * @brief Sincroniza os spans com os vértices atuais do polígono
+     * @param polygonVertices Vértices atuais (polígono fechado implicitamente)
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     */
+    void update(const std::vector<Point2D>& polygonVertices, int maxHeight, int maxWidth) {
+        rescannedRowCount = 0;
+        
+        bool sameArea = (maxHeight == trackedHeight && maxWidth == trackedWidth);
+        size_t previousCount = trackedVertices.size();
+        size_t currentCount = polygonVertices.size();
+        
+        if (sameArea && currentCount == previousCount && sharesPrefix(polygonVertices, trackedVertices)) {
+            return;
+        }
+        
+        bool appended = sameArea && previousCount >= 3 && currentCount == previousCount + 1 &&
+                        sharesPrefix(polygonVertices, trackedVertices);
+        bool removed = sameArea && currentCount >= 3 && previousCount == currentCount + 1 &&
+                       sharesPrefix(trackedVertices, polygonVertices);
+        
+        if (appended) {
+            rescanEditedVertex(polygonVertices, trackedVertices.back(), trackedVertices.front(), polygonVertices.back());
+            trackedVertices.push_back(polygonVertices.back());
+        } else if (removed) {
+            rescanEditedVertex(polygonVertices, polygonVertices.back(), polygonVertices.front(), trackedVertices.back());
+            trackedVertices.pop_back();
+        } else {
+            trackedHeight = std::max(maxHeight, 0);
+            trackedWidth = maxWidth;
+            // Os vetores mantêm a capacidade entre varreduras completas e reshapes
+            rowSpans.clear();
+            rowStarts.assign(static_cast<size_t>(trackedHeight) + 1, 0);
+            trackedVertices = polygonVertices;
+            rescanBand(polygonVertices, 0, trackedHeight);
+        }
+    }
+
+    /**
+     * @brief Emite os spans guardados, de cima para baixo
+     */
+    template <typename SpanSink>
+    void emitSpans(const ColorRGB& fillColor, SpanSink& spanSink) const {
+        for (size_t scanLine = 0; scanLine + 1 < rowStarts.size(); ++scanLine) {
+            for (std::uint32_t spanIndex = rowStarts[scanLine]; spanIndex < rowStarts[scanLine + 1]; ++spanIndex) {
+                spanSink.emitSpan(static_cast<int>(scanLine), rowSpans[spanIndex].startX, rowSpans[spanIndex].endX, fillColor);
+            }
+        }
+    }
+};
+
+#endif // INCREMENTAL_FILL_H
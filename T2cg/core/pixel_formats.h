@@ -0,0 +1,305 @@
+/**
+ * @file pixel_formats.h
+ * @brief Formatos de pixel suportados pelo framebuffer de CPU
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef PIXEL_FORMATS_H
+#define PIXEL_FORMATS_H
+
+#include "data_structures.h"
+#include "span_fill_kernels.h"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Converte um componente de cor (0.0 - 1.0) para um inteiro em [0, maxValue]
+ */
+inline std::uint32_t quantizeColorComponent(float component, std::uint32_t maxValue) {
+    float clamped = std::min(1.0f, std::max(0.0f, component));
+    return static_cast<std::uint32_t>(clamped * static_cast<float>(maxValue) + 0.5f);
+}
+
+/**
+ * @struct PremultipliedColor
+ * @brief Cor de preenchimento translúcida em 8 bits, com RGB já multiplicado pelo alpha
+ *
+ * Preparada uma vez por cor; blendSpan de cada formato faz
+ * destino = cor + destino * inverseAlpha / 255 em cada canal.
+ */
+struct PremultipliedColor {
+    std::uint8_t redComponent;
+    std::uint8_t greenComponent;
+    std::uint8_t blueComponent;
+    std::uint8_t alphaComponent;
+    std::uint8_t inverseAlpha;
+
+    static PremultipliedColor fromColor(const ColorRGB& color) {
+        std::uint32_t alpha = quantizeColorComponent(color.alphaComponent, 255);
+        
+        PremultipliedColor premultiplied;
+        premultiplied.redComponent = static_cast<std::uint8_t>((quantizeColorComponent(color.redComponent, 255) * alpha + 127) / 255);
+        premultiplied.greenComponent = static_cast<std::uint8_t>((quantizeColorComponent(color.greenComponent, 255) * alpha + 127) / 255);
+        premultiplied.blueComponent = static_cast<std::uint8_t>((quantizeColorComponent(color.blueComponent, 255) * alpha + 127) / 255);
+        premultiplied.alphaComponent = static_cast<std::uint8_t>(alpha);
+        premultiplied.inverseAlpha = static_cast<std::uint8_t>(255 - alpha);
+        return premultiplied;
+    }
+
+    bool isOpaque() const { return alphaComponent == 255; }
+    bool isTransparent() const { return alphaComponent == 0; }
+
+    /**
+     * @brief Compõe a cor sobre um pixel RGB de 8 bits por canal (caminho escalar)
+     */
+    void blendRGB8(unsigned char rgb[3]) const {
+        const std::uint8_t source[3] = { redComponent, greenComponent, blueComponent };
+        for (int channel = 0; channel < 3; ++channel) {
+            std::uint32_t scaled = rgb[channel] * static_cast<std::uint32_t>(inverseAlpha) + 128;
+            rgb[channel] = static_cast<unsigned char>(std::min<std::uint32_t>(255, source[channel] + ((scaled + (scaled >> 8)) >> 8)));
+        }
+    }
+};
+
+/**
+ * @struct PixelFormatRGBA8
+ * @brief 32 bits por pixel, bytes na memória na ordem R, G, B, A
+ */
+struct PixelFormatRGBA8 {
+    typedef std::uint32_t PixelType;
+
+    static PixelType pack(const ColorRGB& color) {
+        return quantizeColorComponent(color.redComponent, 255) |
+               (quantizeColorComponent(color.greenComponent, 255) << 8) |
+               (quantizeColorComponent(color.blueComponent, 255) << 16) |
+               (0xFFu << 24);
+    }
+
+    static void unpackRGB8(PixelType pixel, unsigned char rgb[3]) {
+        rgb[0] = static_cast<unsigned char>(pixel & 0xFF);
+        rgb[1] = static_cast<unsigned char>((pixel >> 8) & 0xFF);
+        rgb[2] = static_cast<unsigned char>((pixel >> 16) & 0xFF);
+    }
+
+    /**
+     * @brief Escreve pixelCount pixels com R, G, B em ponto fixo 16.16 (0 - 255) somando stepRGB a cada pixel
+     */
+    static void fillInterpolated(PixelType* destination, size_t pixelCount,
+                                 const std::int32_t startRGB[3], const std::int32_t stepRGB[3]) {
+        SpanFillKernels::interpolateRGB32(destination, pixelCount, startRGB, stepRGB);
+    }
+
+    /**
+     * @brief Compõe color sobre pixelCount pixels (SIMD, 4 - 8 pixels por iteração)
+     */
+    static void blendSpan(PixelType* destination, size_t pixelCount, const PremultipliedColor& color) {
+        std::uint32_t source = color.redComponent | (static_cast<std::uint32_t>(color.greenComponent) << 8) |
+                               (static_cast<std::uint32_t>(color.blueComponent) << 16) |
+                               (static_cast<std::uint32_t>(color.alphaComponent) << 24);
+        SpanFillKernels::blendPremultipliedRGBA32(destination, pixelCount, source, color.inverseAlpha);
+    }
+};
+
+/**
+ * @struct PixelFormatBGRA8
+ * @brief 32 bits por pixel, bytes na memória na ordem B, G, R, A (layout do GDI/DIB)
+ */
+struct PixelFormatBGRA8 {
+    typedef std::uint32_t PixelType;
+
+    static PixelType pack(const ColorRGB& color) {
+        return quantizeColorComponent(color.blueComponent, 255) |
+               (quantizeColorComponent(color.greenComponent, 255) << 8) |
+               (quantizeColorComponent(color.redComponent, 255) << 16) |
+               (0xFFu << 24);
+    }
+
+    static void unpackRGB8(PixelType pixel, unsigned char rgb[3]) {
+        rgb[0] = static_cast<unsigned char>((pixel >> 16) & 0xFF);
+        rgb[1] = static_cast<unsigned char>((pixel >> 8) & 0xFF);
+        rgb[2] = static_cast<unsigned char>(pixel & 0xFF);
+    }
+
+    static void fillInterpolated(PixelType* destination, size_t pixelCount,
+                                 const std::int32_t startRGB[3], const std::int32_t stepRGB[3]) {
+        const std::int32_t startBGR[3] = { startRGB[2], startRGB[1], startRGB[0] };
+        const std::int32_t stepBGR[3] = { stepRGB[2], stepRGB[1], stepRGB[0] };
+        SpanFillKernels::interpolateRGB32(destination, pixelCount, startBGR, stepBGR);
+    }
+
+    static void blendSpan(PixelType* destination, size_t pixelCount, const PremultipliedColor& color) {
+        std::uint32_t source = color.blueComponent | (static_cast<std::uint32_t>(color.greenComponent) << 8) |
+                               (static_cast<std::uint32_t>(color.redComponent) << 16) |
+                               (static_cast<std::uint32_t>(color.alphaComponent) << 24);
+        SpanFillKernels::blendPremultipliedRGBA32(destination, pixelCount, source, color.inverseAlpha);
+    }
+};
+
+/**
+ * @struct PixelFormatRGB565
+ * @brief 16 bits por pixel: 5 bits de vermelho, 6 de verde e 5 de azul
+ */
+struct PixelFormatRGB565 {
+    typedef std::uint16_t PixelType;
+
+    static PixelType pack(const ColorRGB& color) {
+        return static_cast<PixelType>((quantizeColorComponent(color.redComponent, 31) << 11) |
+                                      (quantizeColorComponent(color.greenComponent, 63) << 5) |
+                                      quantizeColorComponent(color.blueComponent, 31));
+    }
+
+    static void unpackRGB8(PixelType pixel, unsigned char rgb[3]) {
+        unsigned int red = (pixel >> 11) & 0x1F;
+        unsigned int green = (pixel >> 5) & 0x3F;
+        unsigned int blue = pixel & 0x1F;
+        
+        rgb[0] = static_cast<unsigned char>((red << 3) | (red >> 2));
+        rgb[1] = static_cast<unsigned char>((green << 2) | (green >> 4));
+        rgb[2] = static_cast<unsigned char>((blue << 3) | (blue >> 2));
+    }
+
+    static void fillInterpolated(PixelType* destination, size_t pixelCount,
+                                 const std::int32_t startRGB[3], const std::int32_t stepRGB[3]) {
+        std::int32_t red = startRGB[0], green = startRGB[1], blue = startRGB[2];
+        for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+            destination[pixelIndex] = static_cast<PixelType>(((red >> 19) << 11) | ((green >> 18) << 5) | (blue >> 19));
+            red += stepRGB[0];
+            green += stepRGB[1];
+            blue += stepRGB[2];
+        }
+    }
+
+    /**
+     * @brief Expande para 8 bits por canal, compõe e reempacota um pixel
+     *
+     * O arredondamento de x / 255 é feito por ((x + 128) * 257) >> 16, exato
+     * para x até 255 * 255.
+     */
+    static PixelType blendPixel(PixelType pixel, const PremultipliedColor& color) {
+        unsigned char rgb[3];
+        unpackRGB8(pixel, rgb);
+        color.blendRGB8(rgb);
+        return static_cast<PixelType>(((((rgb[0] * 31u + 128) * 257) >> 16) << 11) |
+                                      ((((rgb[1] * 63u + 128) * 257) >> 16) << 5) |
+                                      (((rgb[2] * 31u + 128) * 257) >> 16));
+    }
+
+    /**
+     * @brief Sem SIMD: compõe uma vez por run de pixels iguais e repete o resultado
+     */
+    static void blendSpan(PixelType* destination, size_t pixelCount, const PremultipliedColor& color) {
+        if (pixelCount == 0) {
+            return;
+        }
+        
+        PixelType runPixel = destination[0];
+        PixelType blendedPixel = blendPixel(runPixel, color);
+        for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+            if (destination[pixelIndex] != runPixel) {
+                runPixel = destination[pixelIndex];
+                blendedPixel = blendPixel(runPixel, color);
+            }
+            destination[pixelIndex] = blendedPixel;
+        }
+    }
+};
+
+/**
+ * @struct PixelFormatIndexed8
+ * @brief 8 bits por pixel, índice na paleta COLOR_PALETTE (cor mais próxima)
+ */
+struct PixelFormatIndexed8 {
+    typedef std::uint8_t PixelType;
+
+    static PixelType pack(const ColorRGB& color) {
+        return nearestPaletteIndex(static_cast<int>(quantizeColorComponent(color.redComponent, 255)),
+                                   static_cast<int>(quantizeColorComponent(color.greenComponent, 255)),
+                                   static_cast<int>(quantizeColorComponent(color.blueComponent, 255)));
+    }
+
+    /**
+     * @brief Índice da cor da paleta mais próxima de (red, green, blue) em 8 bits por canal
+     */
+    static PixelType nearestPaletteIndex(int red, int green, int blue) {
+        int bestIndex = 0;
+        int bestDistance = -1;
+        for (int paletteIndex = 0; paletteIndex < 16; ++paletteIndex) {
+            int deltaRed = COLOR_PALETTE[paletteIndex].r - red;
+            int deltaGreen = COLOR_PALETTE[paletteIndex].g - green;
+            int deltaBlue = COLOR_PALETTE[paletteIndex].b - blue;
+            int distance = deltaRed * deltaRed + deltaGreen * deltaGreen + deltaBlue * deltaBlue;
+            
+            if (bestDistance < 0 || distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = paletteIndex;
+            }
+        }
+        
+        return static_cast<PixelType>(bestIndex);
+    }
+
+    static void unpackRGB8(PixelType pixel, unsigned char rgb[3]) {
+        const Color16Bit& paletteColor = COLOR_PALETTE[pixel & 0x0F];
+        rgb[0] = static_cast<unsigned char>(paletteColor.r);
+        rgb[1] = static_cast<unsigned char>(paletteColor.g);
+        rgb[2] = static_cast<unsigned char>(paletteColor.b);
+    }
+
+    /**
+     * @struct QuantizationTable
+     * @brief Índice da paleta para cada cor RGB com 4 bits por canal (centro de cada célula)
+     */
+    struct QuantizationTable {
+        PixelType indices[4096];
+
+        QuantizationTable() {
+            for (int cell = 0; cell < 4096; ++cell) {
+                indices[cell] = nearestPaletteIndex(((cell >> 8) << 4) | 8, (((cell >> 4) & 0x0F) << 4) | 8,
+                                                    ((cell & 0x0F) << 4) | 8);
+            }
+        }
+    };
+
+    /**
+     * @brief Tabela 4-4-4 da COLOR_PALETTE, montada no primeiro uso
+     */
+    static const QuantizationTable& getQuantizationTable() {
+        static const QuantizationTable table;
+        return table;
+    }
+
+    /**
+     * @brief Sem SIMD: cada pixel é quantizado pela tabela 4-4-4, sem procurar na paleta
+     */
+    static void fillInterpolated(PixelType* destination, size_t pixelCount,
+                                 const std::int32_t startRGB[3], const std::int32_t stepRGB[3]) {
+        const PixelType* indices = getQuantizationTable().indices;
+        std::int32_t red = startRGB[0], green = startRGB[1], blue = startRGB[2];
+        for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+            destination[pixelIndex] = indices[((red >> 20) << 8) | ((green >> 20) << 4) | (blue >> 20)];
+            red += stepRGB[0];
+            green += stepRGB[1];
+            blue += stepRGB[2];
+        }
+    }
+
+    /**
+     * @brief Compõe a cor sobre as 16 cores da paleta uma vez e troca cada pixel por tabela
+     */
+    static void blendSpan(PixelType* destination, size_t pixelCount, const PremultipliedColor& color) {
+        PixelType blendedIndices[16];
+        for (int paletteIndex = 0; paletteIndex < 16; ++paletteIndex) {
+            unsigned char rgb[3];
+            unpackRGB8(static_cast<PixelType>(paletteIndex), rgb);
+            color.blendRGB8(rgb);
+            blendedIndices[paletteIndex] = nearestPaletteIndex(rgb[0], rgb[1], rgb[2]);
+        }
+        
+        for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+            destination[pixelIndex] = blendedIndices[destination[pixelIndex] & 0x0F];
+        }
+    }
+};
+
+#endif // PIXEL_FORMATS_H
@@ -0,0 +1,950 @@
+/**
+ * @file polygon_boolean.h
+ * @brief Operações booleanas entre polígonos (união, interseção, diferença, xor) por varredura
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef POLYGON_BOOLEAN_H
+#define POLYGON_BOOLEAN_H
+
+#include "data_structures.h"
+#include "sweep_events.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <queue>
+#include <set>
+#include <vector>
+
+/**
+ * @struct BooleanContour
+ * @brief Contorno fechado do resultado, com a relação de buracos
+ */
+struct BooleanContour {
+    std::vector<Point2D> vertices;
+    int parentContour;    // Contorno que contém este diretamente, ou -1
+    int depth;            // 0 = externo, 1 = buraco, 2 = ilha dentro de buraco, ...
+
+    BooleanContour() : parentContour(-1), depth(0) {}
+
+    bool isHole() const {
+        return (depth & 1) != 0;
+    }
+};
+
+/**
+ * @class PolygonBooleanSweep
+ * @brief Calcula A op B com varreduras de eventos, no estilo de Martínez-Rueda-Feito
+ *
+ * 1. Divisão: as arestas dos dois polígonos viram pares de eventos (extremo
+ *    esquerdo e direito) em uma fila de prioridade ordenada por x, y. A linha
+ *    de varredura (std::set) mantém as arestas ordenadas de baixo para cima;
+ *    interseções só são testadas entre vizinhas e cada uma divide as arestas
+ *    envolvidas, criando novos eventos. Os pontos de divisão são racionais
+ *    exatos (ExactSweepPoint), então a ordem da linha é sempre consistente.
+ *    Ao fim da varredura os extremos são arredondados para a grade inteira;
+ *    se algum cruzamento foi arredondado, as partes podem voltar a se cruzar
+ *    perto dele e a divisão é repetida sobre elas até nenhuma passada
+ *    arredondar. Trechos sobrepostos ficam com os mesmos extremos e são
+ *    fundidos, guardando a paridade de cada polígono.
+ * 2. Classificação: com as arestas já sem cruzamentos, uma segunda varredura
+ *    obtém, a partir da vizinha de baixo, se o ponto logo acima de cada aresta
+ *    está dentro de A e de B; a aresta é borda do resultado quando a operação
+ *    dá valores diferentes dos dois lados.
+ * 3. Contornos: as bordas são orientadas com o resultado à esquerda e
+ *    encadeadas em cada vértice pela próxima aresta no sentido horário. O
+ *    contorno que contém cada um é achado pela borda logo abaixo dele.
+ *
+ * O custo é O((n + k) log n) para n arestas e k interseções. Cada polígono é
+ * um único anel interpretado pela regra par-ímpar, como no preenchimento
+ * ET/AET: autointerseções são resolvidas e arestas sobrepostas do mesmo
+ * polígono (pontes de buracos) se cancelam. Depois da divisão todos os
+ * extremos são inteiros, e as orientações em double da classificação são
+ * exatas para coordenadas de até 2^25.
+ */
+class PolygonBooleanSweep {
+private:
+    /**
+     * @brief Paridade da aresta em cada polígono (cópias iguais já foram fundidas)
+     */
+    struct EdgeParity {
+        bool subjectParity;     // A aresta conta em A
+        bool clippingParity;    // ... e em B
+    };
+
+    typedef BasicSweepEvent<EdgeParity> SweepEvent;
+    typedef BasicSweepOrder<SweepEvent> SweepOrder;
+    typedef SweepOrder::EventQueueOrder EventQueueOrder;
+    typedef SweepOrder::SegmentOrder SegmentOrder;
+    typedef std::set<SweepEvent*, SegmentOrder> SweepLine;
+
+    /**
+     * @struct BoundarySegment
+     * @brief Aresta (left < right) com a paridade em A e em B e, após a divisão, a classificação dos dois lados
+     *
+     * Em arestas verticais, "acima" é o lado esquerdo (x menor) e "abaixo" o direito.
+     */
+    struct BoundarySegment {
+        SweepPoint left;
+        SweepPoint right;
+        bool subjectParity;      // A aresta aparece um número ímpar de vezes em A
+        bool clippingParity;     // ... e em B
+        bool aboveInSubject;     // O ponto logo acima da aresta está dentro de A
+        bool aboveInClipping;    // ... dentro de B
+        bool isBoundary;         // Os dois lados diferem no resultado
+        bool resultAbove;        // O resultado fica acima da aresta
+        int boundaryBelow;       // Borda do resultado logo abaixo (arestas não verticais), ou -1
+        int contourId;
+
+        bool isVertical() const {
+            return left.x == right.x;
+        }
+    };
+
+    /**
+     * @brief Ordem das arestas sem cruzamentos na segunda varredura: true se a fica abaixo de b
+     */
+    struct BoundaryOrder {
+        bool operator()(const BoundarySegment* a, const BoundarySegment* b) const {
+            if (a == b) {
+                return false;
+            }
+            if (a->left == b->left) {
+                double area = signedArea(a->left, a->right, b->right);
+                return area != 0.0 ? area > 0.0 : a < b;
+            }
+            if (a->left.x == b->left.x) {
+                return a->left.y < b->left.y;
+            }
+            if (a->left.x < b->left.x) {
+                double area = signedArea(a->left, a->right, b->left);
+                if (area == 0.0) {
+                    area = signedArea(a->left, a->right, b->right);
+                }
+                return area != 0.0 ? area > 0.0 : a < b;
+            }
+            double area = signedArea(b->left, b->right, a->left);
+            if (area == 0.0) {
+                area = signedArea(b->left, b->right, a->right);
+            }
+            return area != 0.0 ? area < 0.0 : a < b;
+        }
+    };
+
+    typedef std::set<const BoundarySegment*, BoundaryOrder> BoundaryLine;
+
+    struct ToggleParity {
+        unsigned char parity;    // Bit 0: aresta de A; bit 1: aresta de B
+    };
+
+    typedef BasicLineToggle<ToggleParity> LineToggle;
+
+    /**
+     * @brief Borda do resultado orientada com o resultado à esquerda
+     */
+    struct DirectedBoundary {
+        int segmentIndex;
+        int startVertex;
+        int endVertex;
+        double angle;    // Direção ao sair de startVertex
+    };
+
+    std::deque<SweepEvent> eventStorage;
+    std::vector<SweepEvent*> sortedEvents;    // Extremos das arestas da passada, ordenados uma vez
+    std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventQueueOrder> eventQueue;    // Só eventos de divisões
+    SweepLine sweepLine;
+    std::vector<SweepLine::iterator> sweepPositions;    // Posição de cada evento esquerdo na linha, por eventId
+    std::vector<BoundarySegment> segments;
+    BooleanOperation operation;
+    size_t roundedDivisionCount;    // Divisões da passada atual em pontos não inteiros
+    size_t splitPassCount;          // Passadas de divisão da última operação
+
+    SweepEvent* createEvent(const ExactSweepPoint& point, bool isLeft, const SweepEvent& source, SweepEvent* otherEvent) {
+        SweepEvent event;
+        event.point = point;
+        event.otherEvent = otherEvent;
+        event.supportLeft = source.supportLeft;
+        event.supportRight = source.supportRight;
+        event.eventId = eventStorage.size();
+        event.isLeft = isLeft;
+        event.subjectParity = source.subjectParity;
+        event.clippingParity = source.clippingParity;
+        eventStorage.push_back(event);
+        return &eventStorage.back();
+    }
+
+    /**
+     * @brief Cria o par de eventos de uma aresta (left < right) entre os extremos a ordenar
+     */
+    void processSegment(const BoundarySegment& segment) {
+        SweepEvent source;
+        source.supportLeft = toPoint(segment.left);
+        source.supportRight = toPoint(segment.right);
+        source.subjectParity = segment.subjectParity;
+        source.clippingParity = segment.clippingParity;
+
+        SweepEvent* leftEvent = createEvent(ExactSweepPoint::fromPoint(source.supportLeft), true, source, nullptr);
+        SweepEvent* rightEvent = createEvent(ExactSweepPoint::fromPoint(source.supportRight), false, source, leftEvent);
+        leftEvent->otherEvent = rightEvent;
+
+        sortedEvents.push_back(leftEvent);
+        sortedEvents.push_back(rightEvent);
+    }
+
+    /**
+     * @brief Divide a parte do evento esquerdo em point, estritamente entre os seus extremos
+     */
+    void divideSegment(SweepEvent* leftEvent, const ExactSweepPoint& point) {
+        SweepEvent* rightOfLeftPart = createEvent(point, false, *leftEvent, leftEvent);
+        SweepEvent* leftOfRightPart = createEvent(point, true, *leftEvent, leftEvent->otherEvent);
+
+        leftEvent->otherEvent->otherEvent = leftOfRightPart;
+        leftEvent->otherEvent = rightOfLeftPart;
+        if (!point.isIntegral()) {
+            ++roundedDivisionCount;
+        }
+
+        eventQueue.push(leftOfRightPart);
+        eventQueue.push(rightOfLeftPart);
+    }
+
+    /**
+     * @brief Interseção de duas partes: 0 (nenhuma), 1 (um ponto) ou 2 (sobreposição colinear)
+     *
+     * As orientações são tomadas sobre as arestas inteiras de suporte e o
+     * ponto de cruzamento é exato; só depois se verifica se ele cai dentro
+     * das duas partes.
+     */
+    static int findIntersection(const SweepEvent* le1, const SweepEvent* le2,
+                                ExactSweepPoint& intersection1, ExactSweepPoint& intersection2) {
+        const Point2D& a0 = le1->supportLeft;
+        const Point2D& a1 = le1->supportRight;
+        const Point2D& b0 = le2->supportLeft;
+        const Point2D& b1 = le2->supportRight;
+
+        int orientationB0 = exactOrientation(a0, a1, b0);
+        int orientationB1 = exactOrientation(a0, a1, b1);
+        if (orientationB0 == 0 && orientationB1 == 0) {
+            // Mesma reta: trecho comum das duas partes
+            const ExactSweepPoint& firstPoint = le1->point < le2->point ? le2->point : le1->point;
+            const ExactSweepPoint& lastPoint = le1->otherEvent->point < le2->otherEvent->point
+                ? le1->otherEvent->point : le2->otherEvent->point;
+            if (lastPoint < firstPoint) {
+                return 0;
+            }
+            intersection1 = firstPoint;
+            if (firstPoint == lastPoint) {
+                return 1;
+            }
+            intersection2 = lastPoint;
+            return 2;
+        }
+        if (orientationB0 * orientationB1 > 0) {
+            return 0;
+        }
+        int orientationA0 = exactOrientation(b0, b1, a0);
+        int orientationA1 = exactOrientation(b0, b1, a1);
+        if (orientationA0 * orientationA1 > 0) {
+            return 0;
+        }
+
+        if (orientationB0 == 0) {
+            intersection1 = ExactSweepPoint::fromPoint(b0);
+        } else if (orientationB1 == 0) {
+            intersection1 = ExactSweepPoint::fromPoint(b1);
+        } else if (orientationA0 == 0) {
+            intersection1 = ExactSweepPoint::fromPoint(a0);
+        } else if (orientationA1 == 0) {
+            intersection1 = ExactSweepPoint::fromPoint(a1);
+        } else {
+            intersection1 = exactLineIntersection(a0, a1, b0, b1);
+        }
+        return le1->containsInRange(intersection1) && le2->containsInRange(intersection1) ? 1 : 0;
+    }
+
+    /**
+     * @brief Divide duas arestas vizinhas na linha de varredura onde elas se cruzam ou se sobrepõem
+     *
+     * Em uma sobreposição as arestas são divididas nos extremos uma da outra,
+     * de modo que o trecho comum vire duas arestas com os mesmos extremos.
+     */
+    void handlePossibleIntersection(SweepEvent* le1, SweepEvent* le2) {
+        ExactSweepPoint intersection1 = ExactSweepPoint();
+        ExactSweepPoint intersection2 = ExactSweepPoint();
+        int intersectionCount = findIntersection(le1, le2, intersection1, intersection2);
+        if (intersectionCount == 0) {
+            return;
+        }
+
+        if (intersectionCount == 1) {
+            if (le1->point != intersection1 && le1->otherEvent->point != intersection1) {
+                divideSegment(le1, intersection1);
+            }
+            if (le2->point != intersection1 && le2->otherEvent->point != intersection1) {
+                divideSegment(le2, intersection1);
+            }
+            return;
+        }
+
+        bool sharesLeftPoint = le1->point == le2->point;
+        bool sharesRightPoint = le1->otherEvent->point == le2->otherEvent->point;
+        if (sharesLeftPoint && sharesRightPoint) {
+            return;
+        }
+
+        // Sobreposição: extremos em ordem de processamento
+        SweepEvent* firstLeft = SweepOrder::isProcessedAfter(le1, le2) ? le2 : le1;
+        SweepEvent* secondLeft = (firstLeft == le1) ? le2 : le1;
+        SweepEvent* firstRight = SweepOrder::isProcessedAfter(le1->otherEvent, le2->otherEvent) ? le2->otherEvent : le1->otherEvent;
+        SweepEvent* secondRight = (firstRight == le1->otherEvent) ? le2->otherEvent : le1->otherEvent;
+
+        if (sharesLeftPoint) {
+            divideSegment(secondRight->otherEvent, firstRight->point);
+        } else if (sharesRightPoint) {
+            divideSegment(firstLeft, secondLeft->point);
+        } else if (firstLeft == secondRight->otherEvent) {
+            // Uma aresta contém a outra: divide nos dois extremos da menor
+            SweepEvent* containingRight = secondRight;
+            divideSegment(firstLeft, secondLeft->point);
+            divideSegment(containingRight->otherEvent, firstRight->point);
+        } else {
+            divideSegment(firstLeft, secondLeft->point);
+            divideSegment(secondLeft, firstRight->point);
+        }
+    }
+
+    SweepLine::iterator previousOf(SweepLine::iterator position) {
+        if (position == sweepLine.begin()) {
+            return sweepLine.end();
+        }
+        return --position;
+    }
+
+    /**
+     * @brief Primeira varredura: divide as arestas até não restarem cruzamentos nem sobreposições parciais
+     */
+    void splitSegments() {
+        std::sort(sortedEvents.begin(), sortedEvents.end(), [](const SweepEvent* e1, const SweepEvent* e2) {
+            return SweepOrder::isProcessedAfter(e2, e1);
+        });
+        size_t sortedIndex = 0;
+        while (sortedIndex < sortedEvents.size() || !eventQueue.empty()) {
+            SweepEvent* event;
+            if (eventQueue.empty() ||
+                (sortedIndex < sortedEvents.size() && !SweepOrder::isProcessedAfter(sortedEvents[sortedIndex], eventQueue.top()))) {
+                event = sortedEvents[sortedIndex++];
+            } else {
+                event = eventQueue.top();
+                eventQueue.pop();
+            }
+
+            if (event->isLeft) {
+                // A ordem é exata: nenhuma parte é equivalente a outra e a inserção sempre ocorre
+                SweepLine::iterator position = sweepLine.insert(event).first;
+                if (sweepPositions.size() <= event->eventId) {
+                    sweepPositions.resize(eventStorage.size(), sweepLine.end());
+                }
+                sweepPositions[event->eventId] = position;
+                SweepLine::iterator previous = previousOf(position);
+                SweepLine::iterator next = position;
+                ++next;
+
+                if (next != sweepLine.end()) {
+                    handlePossibleIntersection(event, *next);
+                }
+                if (previous != sweepLine.end()) {
+                    handlePossibleIntersection(*previous, event);
+                }
+            } else {
+                // Remove pela posição guardada, sem nova busca na árvore
+                SweepLine::iterator position = sweepPositions[event->otherEvent->eventId];
+                sweepPositions[event->otherEvent->eventId] = sweepLine.end();
+
+                SweepLine::iterator previous = previousOf(position);
+                SweepLine::iterator next = position;
+                ++next;
+                sweepLine.erase(position);
+
+                if (previous != sweepLine.end() && next != sweepLine.end()) {
+                    handlePossibleIntersection(*previous, *next);
+                }
+            }
+        }
+        sweepLine.clear();
+        sweepPositions.clear();
+        sortedEvents.clear();
+    }
+
+    /**
+     * @brief Acrescenta a aresta start-end com extremos inteiros; arestas de comprimento zero não separam regiões
+     */
+    void addSegment(const Point2D& start, const Point2D& end, bool subjectParity, bool clippingParity) {
+        if (start == end) {
+            return;
+        }
+        BoundarySegment segment;
+        segment.left = std::min(toSweepPoint(start), toSweepPoint(end));
+        segment.right = std::max(toSweepPoint(start), toSweepPoint(end));
+        segment.subjectParity = subjectParity;
+        segment.clippingParity = clippingParity;
+        segment.aboveInSubject = false;
+        segment.aboveInClipping = false;
+        segment.isBoundary = false;
+        segment.resultAbove = false;
+        segment.boundaryBelow = -1;
+        segment.contourId = -1;
+        segments.push_back(segment);
+    }
+
+    static SweepPoint toSweepPoint(const Point2D& point) {
+        SweepPoint sweepPoint = { static_cast<double>(point.coordinateX), static_cast<double>(point.coordinateY) };
+        return sweepPoint;
+    }
+
+    static Point2D toPoint(const SweepPoint& point) {
+        return Point2D(static_cast<int>(point.x), static_cast<int>(point.y));
+    }
+
+    /**
+     * @brief Registra os dois extremos de cada aresta do polígono na sua reta de suporte
+     */
+    static void addPolygonToggles(const std::vector<Point2D>& polygonVertices, unsigned char parity,
+                                  std::vector<LineToggle>& toggles) {
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& start = polygonVertices[vertexIndex];
+            const Point2D& end = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            if (start == end) {
+                continue;
+            }
+            ToggleParity toggleParity;
+            toggleParity.parity = parity;
+            LineToggle::appendEdge(start, end, toggleParity, toggleParity, toggles);
+        }
+    }
+
+    /**
+     * @brief Sobrepõe de forma exata as arestas de entrada que estão na mesma reta
+     *
+     * As arestas são agrupadas pela reta de suporte (direção reduzida e
+     * deslocamento inteiros) e cada grupo é percorrido ao longo da reta com a
+     * paridade de A e de B. Trechos cobertos um número par de vezes por cada
+     * polígono (pontes de buracos, pontas que voltam sobre si) somem, e os
+     * demais viram arestas disjuntas; a varredura não precisa dividir
+     * sobreposições calculadas em ponto flutuante.
+     */
+    void resolveCollinearEdges(std::vector<LineToggle>& toggles) {
+        unsigned char currentParity = 0;
+        Point2D intervalStart;
+        LineToggle::forEachPosition(toggles, [&](std::vector<LineToggle>::const_iterator first,
+                                                 std::vector<LineToggle>::const_iterator last) {
+            unsigned char newParity = currentParity;
+            for (std::vector<LineToggle>::const_iterator toggle = first; toggle != last; ++toggle) {
+                newParity ^= toggle->parity;
+            }
+
+            if (newParity != currentParity) {
+                if (currentParity != 0) {
+                    addSegment(intervalStart, first->point,
+                               (currentParity & 1) != 0, (currentParity & 2) != 0);
+                }
+                intervalStart = first->point;
+                currentParity = newParity;
+            }
+        });
+    }
+
+    /**
+     * @brief Junta as arestas divididas que ficaram com os mesmos extremos, guardando a paridade de A e de B
+     */
+    void mergeDuplicateSegments() {
+        std::sort(segments.begin(), segments.end(), [](const BoundarySegment& a, const BoundarySegment& b) {
+            return a.left < b.left || (a.left == b.left && a.right < b.right);
+        });
+
+        size_t mergedCount = 0;
+        for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
+            if (mergedCount > 0 && segments[mergedCount - 1].left == segments[segmentIndex].left &&
+                segments[mergedCount - 1].right == segments[segmentIndex].right) {
+                segments[mergedCount - 1].subjectParity ^= segments[segmentIndex].subjectParity;
+                segments[mergedCount - 1].clippingParity ^= segments[segmentIndex].clippingParity;
+            } else {
+                segments[mergedCount++] = segments[segmentIndex];
+            }
+        }
+        segments.resize(mergedCount);
+
+        // Arestas que se cancelam nos dois polígonos não separam regiões
+        segments.erase(std::remove_if(segments.begin(), segments.end(), [](const BoundarySegment& segment) {
+            return !segment.subjectParity && !segment.clippingParity;
+        }), segments.end());
+    }
+
+    bool isInResult(bool insideSubject, bool insideClipping) const {
+        switch (operation) {
+            case BooleanOperation::UNION:
+                return insideSubject || insideClipping;
+            case BooleanOperation::INTERSECTION:
+                return insideSubject && insideClipping;
+            case BooleanOperation::DIFFERENCE:
+                return insideSubject && !insideClipping;
+            case BooleanOperation::XOR:
+                return insideSubject != insideClipping;
+        }
+        return false;
+    }
+
+    void classifySegment(BoundarySegment& segment, const BoundarySegment* below) {
+        bool belowInSubject = below != nullptr && below->aboveInSubject;
+        bool belowInClipping = below != nullptr && below->aboveInClipping;
+        segment.aboveInSubject = belowInSubject != segment.subjectParity;
+        segment.aboveInClipping = belowInClipping != segment.clippingParity;
+
+        segment.resultAbove = isInResult(segment.aboveInSubject, segment.aboveInClipping);
+        segment.isBoundary = segment.resultAbove != isInResult(belowInSubject, belowInClipping);
+
+        if (below != nullptr) {
+            segment.boundaryBelow = below->isBoundary ? static_cast<int>(below - segments.data()) : below->boundaryBelow;
+        }
+    }
+
+    /**
+     * @brief Segunda varredura: classifica os dois lados de cada aresta pela vizinha de baixo
+     *
+     * Em cada x as arestas que terminam saem antes de as que começam entrarem
+     * (de baixo para cima); as verticais nesse x são classificadas depois,
+     * pela aresta logo abaixo do seu ponto médio (o lado direito delas).
+     */
+    void classifySegments() {
+        std::vector<int> insertionOrder;
+        std::vector<int> removalOrder;
+        insertionOrder.reserve(segments.size());
+        removalOrder.reserve(segments.size());
+        for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
+            insertionOrder.push_back(static_cast<int>(segmentIndex));
+            if (!segments[segmentIndex].isVertical()) {
+                removalOrder.push_back(static_cast<int>(segmentIndex));
+            }
+        }
+
+        BoundaryOrder segmentOrder;
+        std::sort(insertionOrder.begin(), insertionOrder.end(), [&](int a, int b) {
+            const BoundarySegment& first = segments[a];
+            const BoundarySegment& second = segments[b];
+            if (first.left != second.left) {
+                return first.left < second.left;
+            }
+            if (first.isVertical() != second.isVertical()) {
+                return second.isVertical();
+            }
+            return segmentOrder(&first, &second);
+        });
+        std::sort(removalOrder.begin(), removalOrder.end(), [&](int a, int b) {
+            return segments[a].right.x < segments[b].right.x;
+        });
+
+        BoundaryLine activeSegments;
+        std::vector<BoundaryLine::iterator> positions(segments.size());
+        std::vector<int> verticalSegments;
+        size_t insertionIndex = 0;
+        size_t removalIndex = 0;
+
+        while (insertionIndex < insertionOrder.size()) {
+            double sweepX = segments[insertionOrder[insertionIndex]].left.x;
+
+            while (removalIndex < removalOrder.size() && segments[removalOrder[removalIndex]].right.x <= sweepX) {
+                activeSegments.erase(positions[removalOrder[removalIndex]]);
+                ++removalIndex;
+            }
+
+            verticalSegments.clear();
+            while (insertionIndex < insertionOrder.size() && segments[insertionOrder[insertionIndex]].left.x == sweepX) {
+                int segmentIndex = insertionOrder[insertionIndex++];
+                BoundarySegment& segment = segments[segmentIndex];
+                if (segment.isVertical()) {
+                    verticalSegments.push_back(segmentIndex);
+                    continue;
+                }
+
+                positions[segmentIndex] = activeSegments.insert(&segment).first;
+                BoundaryLine::iterator below = positions[segmentIndex];
+                classifySegment(segment, below == activeSegments.begin() ? nullptr : *--below);
+            }
+
+            for (int segmentIndex : verticalSegments) {
+                BoundarySegment& segment = segments[segmentIndex];
+                BoundarySegment probe = segment;
+                probe.left.y = 0.5 * (segment.left.y + segment.right.y);
+                probe.right.x = segment.left.x + 1.0;
+                probe.right.y = probe.left.y;
+
+                BoundaryLine::iterator above = activeSegments.lower_bound(&probe);
+                classifySegment(segment, above == activeSegments.begin() ? nullptr : *--above);
+                segment.boundaryBelow = -1;
+            }
+        }
+    }
+
+    static double ringSignedArea(const std::vector<SweepPoint>& ring) {
+        double area = 0.0;
+        for (size_t vertexIndex = 0; vertexIndex < ring.size(); ++vertexIndex) {
+            const SweepPoint& current = ring[vertexIndex];
+            const SweepPoint& next = ring[(vertexIndex + 1) % ring.size()];
+            area += current.x * next.y - next.x * current.y;
+        }
+        return 0.5 * area;
+    }
+
+    static long long crossProduct(const Point2D& origin, const Point2D& first, const Point2D& second) {
+        return static_cast<long long>(first.coordinateX - origin.coordinateX) * (second.coordinateY - origin.coordinateY) -
+               static_cast<long long>(first.coordinateY - origin.coordinateY) * (second.coordinateX - origin.coordinateX);
+    }
+
+    /**
+     * @brief Arredonda o contorno para inteiros e remove vértices repetidos e colineares
+     * @return Vértices do contorno, ou vazio se restarem menos de 3
+     */
+    static std::vector<Point2D> roundRing(const std::vector<SweepPoint>& ring) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(ring.size());
+        for (const SweepPoint& point : ring) {
+            vertices.push_back(Point2D(static_cast<int>(std::lround(point.x)), static_cast<int>(std::lround(point.y))));
+            if (vertices.size() == 2 && vertices[0] == vertices[1]) {
+                vertices.pop_back();
+            }
+            while (vertices.size() >= 3 &&
+                   crossProduct(vertices[vertices.size() - 3], vertices[vertices.size() - 2], vertices.back()) == 0) {
+                vertices.erase(vertices.end() - 2);
+            }
+        }
+
+        // Fechamento: os últimos e os primeiros vértices também podem ser colineares
+        size_t firstIndex = 0;
+        bool isChanged = true;
+        while (isChanged && vertices.size() - firstIndex >= 3) {
+            isChanged = false;
+            if (crossProduct(vertices[vertices.size() - 2], vertices.back(), vertices[firstIndex]) == 0) {
+                vertices.pop_back();
+                isChanged = true;
+            } else if (crossProduct(vertices.back(), vertices[firstIndex], vertices[firstIndex + 1]) == 0) {
+                ++firstIndex;
+                isChanged = true;
+            }
+        }
+        vertices.erase(vertices.begin(), vertices.begin() + firstIndex);
+
+        if (vertices.size() < 3) {
+            vertices.clear();
+        }
+        return vertices;
+    }
+
+    /**
+     * @brief Encadeia as bordas do resultado em contornos e monta a relação de buracos
+     */
+    void connectBoundaries(std::vector<BooleanContour>& contours) {
+        std::vector<SweepPoint> vertexPoints;
+        for (const BoundarySegment& segment : segments) {
+            if (segment.isBoundary) {
+                vertexPoints.push_back(segment.left);
+                vertexPoints.push_back(segment.right);
+            }
+        }
+        std::sort(vertexPoints.begin(), vertexPoints.end());
+        vertexPoints.erase(std::unique(vertexPoints.begin(), vertexPoints.end()), vertexPoints.end());
+
+        // Resultado acima: percorre da esquerda para a direita (verticais: de baixo para cima)
+        std::vector<DirectedBoundary> boundaries;
+        for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex) {
+            const BoundarySegment& segment = segments[segmentIndex];
+            if (!segment.isBoundary) {
+                continue;
+            }
+            const SweepPoint& start = segment.resultAbove ? segment.left : segment.right;
+            const SweepPoint& end = segment.resultAbove ? segment.right : segment.left;
+
+            DirectedBoundary boundary;
+            boundary.segmentIndex = static_cast<int>(segmentIndex);
+            boundary.startVertex = static_cast<int>(std::lower_bound(vertexPoints.begin(), vertexPoints.end(), start) - vertexPoints.begin());
+            boundary.endVertex = static_cast<int>(std::lower_bound(vertexPoints.begin(), vertexPoints.end(), end) - vertexPoints.begin());
+            boundary.angle = std::atan2(end.y - start.y, end.x - start.x);
+            boundaries.push_back(boundary);
+        }
+
+        // Bordas que saem de cada vértice, em ordem de ângulo
+        std::sort(boundaries.begin(), boundaries.end(), [](const DirectedBoundary& a, const DirectedBoundary& b) {
+            return a.startVertex < b.startVertex || (a.startVertex == b.startVertex && a.angle < b.angle);
+        });
+        std::vector<size_t> firstOutgoing(vertexPoints.size() + 1, 0);
+        for (const DirectedBoundary& boundary : boundaries) {
+            firstOutgoing[boundary.startVertex + 1]++;
+        }
+        for (size_t vertexIndex = 0; vertexIndex < vertexPoints.size(); ++vertexIndex) {
+            firstOutgoing[vertexIndex + 1] += firstOutgoing[vertexIndex];
+        }
+
+        const double pi = 3.14159265358979323846;
+        std::vector<std::vector<SweepPoint> > rings;
+        std::vector<int> ringLowestSegment;    // Aresta mais baixa que sai do vértice mais à esquerda
+        std::vector<bool> isUsed(boundaries.size(), false);
+        for (size_t boundaryIndex = 0; boundaryIndex < boundaries.size(); ++boundaryIndex) {
+            if (isUsed[boundaryIndex]) {
+                continue;
+            }
+
+            int ringId = static_cast<int>(rings.size());
+            rings.push_back(std::vector<SweepPoint>());
+            std::vector<SweepPoint>& ring = rings.back();
+            int lowestSegment = -1;
+
+            size_t current = boundaryIndex;
+            while (!isUsed[current]) {
+                isUsed[current] = true;
+                const DirectedBoundary& boundary = boundaries[current];
+                BoundarySegment& segment = segments[boundary.segmentIndex];
+                segment.contourId = ringId;
+                ring.push_back(vertexPoints[boundary.startVertex]);
+
+                if (!segment.isVertical() &&
+                    (lowestSegment < 0 || segment.left < segments[lowestSegment].left ||
+                     (segment.left == segments[lowestSegment].left && BoundaryOrder()(&segment, &segments[lowestSegment])))) {
+                    lowestSegment = boundary.segmentIndex;
+                }
+
+                // Próxima borda: a primeira no sentido horário a partir da direção de volta
+                size_t begin = firstOutgoing[boundary.endVertex];
+                size_t end = firstOutgoing[boundary.endVertex + 1];
+                if (begin == end) {
+                    break;
+                }
+                double backAngle = boundary.angle > 0.0 ? boundary.angle - pi : boundary.angle + pi;
+                size_t next = begin;
+                while (next < end && boundaries[next].angle < backAngle) {
+                    ++next;
+                }
+                current = (next == begin) ? end - 1 : next - 1;
+            }
+            ringLowestSegment.push_back(lowestSegment);
+        }
+
+        // Contornos em ordem do vértice mais à esquerda: o contorno da borda logo abaixo já foi visto
+        std::vector<int> ringOrder(rings.size());
+        for (size_t ringIndex = 0; ringIndex < rings.size(); ++ringIndex) {
+            ringOrder[ringIndex] = static_cast<int>(ringIndex);
+        }
+        std::sort(ringOrder.begin(), ringOrder.end(), [&](int a, int b) {
+            int first = ringLowestSegment[a];
+            int second = ringLowestSegment[b];
+            if (first < 0 || second < 0) {
+                return first < second;
+            }
+            if (segments[first].left != segments[second].left) {
+                return segments[first].left < segments[second].left;
+            }
+            return BoundaryOrder()(&segments[first], &segments[second]);
+        });
+
+        // Sentido de cada anel, calculado uma vez: muitos contornos podem ter a mesma borda de baixo
+        std::vector<bool> isRingCounterClockwise(rings.size());
+        for (size_t ringIndex = 0; ringIndex < rings.size(); ++ringIndex) {
+            isRingCounterClockwise[ringIndex] = ringSignedArea(rings[ringIndex]) > 0.0;
+        }
+
+        contours.assign(rings.size(), BooleanContour());
+        for (int ringIndex : ringOrder) {
+            BooleanContour& contour = contours[ringIndex];
+            contour.vertices = roundRing(rings[ringIndex]);
+
+            int lowestSegment = ringLowestSegment[ringIndex];
+            int boundaryBelow = lowestSegment >= 0 ? segments[lowestSegment].boundaryBelow : -1;
+            if (boundaryBelow < 0) {
+                continue;
+            }
+
+            // O ponto logo acima da borda de baixo está dentro do contorno dela se o
+            // resultado acima coincide com o sentido anti-horário; senão, é irmão dele
+            int belowRing = segments[boundaryBelow].contourId;
+            contour.parentContour = (segments[boundaryBelow].resultAbove == isRingCounterClockwise[belowRing])
+                ? belowRing : contours[belowRing].parentContour;
+            contour.depth = contour.parentContour >= 0 ? contours[contour.parentContour].depth + 1 : 0;
+        }
+    }
+
+    static void computeBounds(const std::vector<Point2D>& polygonVertices, int bounds[4]) {
+        bounds[0] = bounds[2] = polygonVertices[0].coordinateX;
+        bounds[1] = bounds[3] = polygonVertices[0].coordinateY;
+        for (const Point2D& vertex : polygonVertices) {
+            bounds[0] = std::min(bounds[0], vertex.coordinateX);
+            bounds[1] = std::min(bounds[1], vertex.coordinateY);
+            bounds[2] = std::max(bounds[2], vertex.coordinateX);
+            bounds[3] = std::max(bounds[3], vertex.coordinateY);
+        }
+    }
+
+    static bool areBoundsDisjoint(const std::vector<Point2D>& subjectVertices, const std::vector<Point2D>& clippingVertices) {
+        if (subjectVertices.size() < 3 || clippingVertices.size() < 3) {
+            return true;
+        }
+        int subjectBounds[4];
+        int clippingBounds[4];
+        computeBounds(subjectVertices, subjectBounds);
+        computeBounds(clippingVertices, clippingBounds);
+        return subjectBounds[0] > clippingBounds[2] || clippingBounds[0] > subjectBounds[2] ||
+               subjectBounds[1] > clippingBounds[3] || clippingBounds[1] > subjectBounds[3];
+    }
+
+public:
+    PolygonBooleanSweep() : operation(BooleanOperation::UNION), roundedDivisionCount(0), splitPassCount(0) {}
+
+    /**
+     * @brief Passadas de divisão da última operação (1 quando nenhum cruzamento precisou de arredondamento)
+     */
+    size_t getSplitPassCount() const {
+        return splitPassCount;
+    }
+
+    /**
+     * @brief Calcula subject op clipping como contornos fechados com relação de buracos
+     * @param subjectVertices Polígono A (anel único, regra par-ímpar)
+     * @param clippingVertices Polígono B (anel único, regra par-ímpar)
+     * @param booleanOperation Operação desejada
+     * @param contours Contornos do resultado (substituídos); os que o arredondamento
+     *                 reduziu a menos de 3 vértices ficam vazios
+     */
+    void computeContours(const std::vector<Point2D>& subjectVertices,
+                         const std::vector<Point2D>& clippingVertices,
+                         BooleanOperation booleanOperation,
+                         std::vector<BooleanContour>& contours) {
+        contours.clear();
+        operation = booleanOperation;
+
+        // Caixas envolventes disjuntas: a interseção é vazia e a diferença não depende de B
+        bool areDisjoint = areBoundsDisjoint(subjectVertices, clippingVertices);
+        if (operation == BooleanOperation::INTERSECTION && areDisjoint) {
+            return;
+        }
+
+        std::vector<LineToggle> toggles;
+        if (subjectVertices.size() >= 3) {
+            addPolygonToggles(subjectVertices, 1, toggles);
+        }
+        if (clippingVertices.size() >= 3 && !(operation == BooleanOperation::DIFFERENCE && areDisjoint)) {
+            addPolygonToggles(clippingVertices, 2, toggles);
+        }
+        segments.clear();
+        resolveCollinearEdges(toggles);
+
+        // Cada passada divide as arestas de forma exata e arredonda as partes
+        // para a grade; só cruzamentos arredondados podem deixar trabalho para a próxima
+        splitPassCount = 0;
+        do {
+            eventStorage.clear();
+            eventQueue = std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventQueueOrder>();
+            for (const BoundarySegment& segment : segments) {
+                processSegment(segment);
+            }
+            roundedDivisionCount = 0;
+            splitSegments();
+            ++splitPassCount;
+
+            segments.clear();
+            for (const SweepEvent& event : eventStorage) {
+                if (event.isLeft) {
+                    addSegment(event.point.rounded(), event.otherEvent->point.rounded(),
+                               event.subjectParity, event.clippingParity);
+                }
+            }
+            eventStorage.clear();
+            mergeDuplicateSegments();
+        } while (roundedDivisionCount > 0);
+
+        classifySegments();
+        connectBoundaries(contours);
+        segments.clear();
+    }
+
+    /**
+     * @brief Junta cada contorno externo com seus buracos em um único anel (pontes de ida e volta)
+     *
+     * Uma ponte é percorrida nos dois sentidos, então suas duas arestas se
+     * cancelam na regra par-ímpar e o anel preenche exatamente a região com
+     * buracos no ET/AET. A ponte sai do vértice mais à esquerda do contorno
+     * externo. Ilhas dentro de buracos viram anéis próprios.
+     * @param ringContours Se não for nulo, recebe os índices dos contornos de cada anel (o externo primeiro),
+     *                     para desenhar o contorno sem as pontes
+     */
+    static std::vector<std::vector<Point2D> > mergeHolesIntoRings(const std::vector<BooleanContour>& contours,
+                                                                  std::vector<std::vector<size_t> >* ringContours = nullptr) {
+        std::vector<std::vector<int> > holesByContour(contours.size());
+        for (size_t contourIndex = 0; contourIndex < contours.size(); ++contourIndex) {
+            const BooleanContour& contour = contours[contourIndex];
+            if (contour.isHole() && contour.parentContour >= 0 && !contour.vertices.empty()) {
+                holesByContour[contour.parentContour].push_back(static_cast<int>(contourIndex));
+            }
+        }
+
+        std::vector<std::vector<Point2D> > rings;
+        if (ringContours) {
+            ringContours->clear();
+        }
+        for (size_t contourIndex = 0; contourIndex < contours.size(); ++contourIndex) {
+            const BooleanContour& contour = contours[contourIndex];
+            if (contour.vertices.empty() || contour.isHole()) {
+                continue;
+            }
+            if (ringContours) {
+                ringContours->push_back(std::vector<size_t>(1, contourIndex));
+            }
+
+            const std::vector<Point2D>& outer = contour.vertices;
+            size_t leftmostIndex = 0;
+            for (size_t vertexIndex = 1; vertexIndex < outer.size(); ++vertexIndex) {
+                if (outer[vertexIndex].coordinateX < outer[leftmostIndex].coordinateX) {
+                    leftmostIndex = vertexIndex;
+                }
+            }
+
+            std::vector<Point2D> ring;
+            for (size_t vertexOffset = 0; vertexOffset < outer.size(); ++vertexOffset) {
+                ring.push_back(outer[(leftmostIndex + vertexOffset) % outer.size()]);
+            }
+
+            const Point2D bridgeStart = outer[leftmostIndex];
+            for (int holeIndex : holesByContour[contourIndex]) {
+                const std::vector<Point2D>& hole = contours[holeIndex].vertices;
+                size_t holeLeftmostIndex = 0;
+                for (size_t vertexIndex = 1; vertexIndex < hole.size(); ++vertexIndex) {
+                    if (hole[vertexIndex].coordinateX < hole[holeLeftmostIndex].coordinateX) {
+                        holeLeftmostIndex = vertexIndex;
+                    }
+                }
+
+                ring.push_back(bridgeStart);
+                for (size_t vertexOffset = 0; vertexOffset <= hole.size(); ++vertexOffset) {
+                    ring.push_back(hole[(holeLeftmostIndex + vertexOffset) % hole.size()]);
+                }
+                if (ringContours) {
+                    ringContours->back().push_back(static_cast<size_t>(holeIndex));
+                }
+            }
+
+            rings.push_back(ring);
+        }
+
+        return rings;
+    }
+
+    /**
+     * @brief Calcula subject op clipping como anéis prontos para o preenchimento par-ímpar
+     * @return Um anel por região externa, com os buracos ligados por pontes
+     */
+    std::vector<std::vector<Point2D> > compute(const std::vector<Point2D>& subjectVertices,
+                                               const std::vector<Point2D>& clippingVertices,
+                                               BooleanOperation booleanOperation) {
+        std::vector<BooleanContour> contours;
+        computeContours(subjectVertices, clippingVertices, booleanOperation, contours);
+        return mergeHolesIntoRings(contours);
+    }
+};
+
+#endif // POLYGON_BOOLEAN_H
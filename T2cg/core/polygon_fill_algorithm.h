@@ -9,15 +9,29 @@
 #define POLYGON_FILL_ALGORITHM_H
 
 #include "data_structures.h"
+#include "simd_active_edge_table.h"
 #include <algorithm>
-#include <GL/gl.h> // Adicionado para chamadas OpenGL
+#include <limits>
 
 /**
  * @class PolygonFillAlgorithm
  * @brief Classe responsável pelo algoritmo de preenchimento de polígonos usando ET/AET
+ *
+ * A saída do algoritmo é uma política de compilação (SpanSink): qualquer tipo
+ * que exponha emitSpan(scanLine, startX, endX, color), com endX inclusivo.
+ * Ver GLSpanSink (gl_span_sink.h), GLSpanBatcher (gl_span_batcher.h) e FramebufferSpanSink (cpu_framebuffer.h).
  */
 class PolygonFillAlgorithm {
 private:
+    ActiveEdgeOrdering activeEdgeOrdering;
+    EdgeSteppingMode edgeSteppingMode;
+    ActiveEdgeLayout activeEdgeLayout;
+    FillRule fillRule;
+    int clipLeft;    // Primeira coluna emitida (ver setClipOrigin)
+    int clipTop;     // Primeira scanline emitida
+    mutable CompactEdgeTable structureOfArraysEdgeTable;        // Reaproveitada entre preenchimentos no layout SoA
+    mutable SoAActiveEdgeTable structureOfArraysActiveEdges;    // Idem; esvaziada no início de cada preenchimento
+
     /**
      * @brief Calcula o inverso da inclinação entre dois pontos
      * @param point1 Primeiro ponto da aresta
@@ -35,18 +49,54 @@ private:
         return deltaX / deltaY;
     }
 
-public:
     /**
-     * @brief Constrói a Edge Table (ET) a partir dos vértices do polígono
+     * @brief Colunas que substituem arestas inteiramente fora da janela em X
+     *
+     * Uma aresta toda à esquerda da coluna clipLeft só altera a paridade/winding
+     * dos pixels visíveis, e uma toda à direita de maxWidth não os altera; ambas
+     * viram arestas verticais (avanço nulo) nessas colunas, sem mudar nenhum span.
+     */
+    static int offscreenLeftColumn(int clipLeftColumn) {
+        return clipLeftColumn - 2;
+    }
+
+    /**
+     * @brief Recorta em X a aresta (x0, x1 são as pontas): true se ela foi colapsada
+     */
+    static bool collapseOffscreenEdge(int x0, int x1, int clipLeftColumn, int maxWidth, int& collapsedX) {
+        if (x0 < clipLeftColumn && x1 < clipLeftColumn) {
+            collapsedX = offscreenLeftColumn(clipLeftColumn);
+            return true;
+        }
+        if (x0 >= maxWidth && x1 >= maxWidth) {
+            collapsedX = maxWidth;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gera as arestas do polígono já recortadas e ajustadas para a ET
+     *
+     * Trata picos e vales (vértices locais de mínimo Y). Arestas que começam
+     * acima da janela têm o X inicial avançado até a scanline clipTop; as que
+     * começam abaixo de maxHeight ou terminam antes de clipTop são
+     * descartadas, e as que ficam inteiras fora da janela em X viram arestas
+     * verticais logo fora dela. Cada aresta resultante é entregue ao
+     * visitante, que decide como armazená-la.
      * @param polygonVertices Vetor com os vértices do polígono
      * @param maxHeight Altura máxima da área de desenho
-     * @return Edge Table organizada por coordenada Y
+     * @param maxWidth Largura máxima da área de desenho
+     * @param edgeVisitor Chamado com cada EdgeData gerado e os índices dos vértices
+     *                    de cima e de baixo da aresta (para interpolar atributos)
      */
-    EdgeTable buildEdgeTable(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
-        EdgeTable edgeTable(maxHeight);
-        
+    template <typename EdgeVisitor>
+    void forEachPolygonEdge(const std::vector<Point2D>& polygonVertices, 
+                            int maxHeight, 
+                            int maxWidth,
+                            EdgeVisitor&& edgeVisitor) const {
         if (polygonVertices.size() < 2) {
-            return edgeTable;
+            return;
         }
 
         for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
@@ -57,20 +107,27 @@ public:
                 int minY = currentVertex.coordinateY;
                 int maxY = nextVertex.coordinateY;
                 double initX = static_cast<double>(currentVertex.coordinateX);
+                int collapsedX = 0;
+                if (collapseOffscreenEdge(currentVertex.coordinateX, nextVertex.coordinateX, clipLeft, maxWidth, collapsedX)) {
+                    initX = static_cast<double>(collapsedX);
+                }
                 
-                if (minY >= 0 && minY < maxHeight) {
-                    edgeTable[minY].push_back(
-                        EdgeData(maxY, initX, 0.0, minY)
-                    );
+                if (minY >= clipTop && minY < maxHeight) {
+                    // Aresta horizontal: participa da paridade, mas não altera o winding
+                    edgeVisitor(EdgeData(maxY, initX, 0.0, minY, 0), vertexIndex, vertexIndex);
                 }
                 continue;
             }
 
             Point2D minYPoint = currentVertex;
             Point2D maxYPoint = nextVertex;
+            size_t minYIndex = vertexIndex;
+            size_t maxYIndex = (vertexIndex + 1) % polygonVertices.size();
+            int windingDirection = (currentVertex.coordinateY < nextVertex.coordinateY) ? 1 : -1;
 
             if (currentVertex.coordinateY > nextVertex.coordinateY) {
                 std::swap(minYPoint, maxYPoint);
+                std::swap(minYIndex, maxYIndex);
             }
 
             double inverseSlope = calculateInverseSlope(minYPoint, maxYPoint);
@@ -78,7 +135,7 @@ public:
             int maximumY = maxYPoint.coordinateY;
             int minimumY = minYPoint.coordinateY;
             
-            if (minimumY >= 0 && minimumY < maxHeight) {
+            if (minimumY >= clipTop && minimumY < maxHeight) {
                 Point2D prevVertex, nextAdjacentVertex;
                 
                 if (minYPoint.coordinateX == currentVertex.coordinateX && 
@@ -104,107 +161,1404 @@ public:
                 }
             }
 
-            if (minimumY >= 0 && minimumY < maxHeight) {
-                edgeTable[minimumY].push_back(
-                    EdgeData(maximumY, initialX, inverseSlope, minimumY)
-                );
+            // Vértice acima da janela: avança a aresta até a scanline clipTop
+            if (minimumY < clipTop && maximumY > clipTop) {
+                initialX += inverseSlope * (clipTop - minimumY);
+                minimumY = clipTop;
+            }
+            
+            int collapsedX = 0;
+            if (collapseOffscreenEdge(minYPoint.coordinateX, maxYPoint.coordinateX, clipLeft, maxWidth, collapsedX)) {
+                initialX = static_cast<double>(collapsedX);
+                inverseSlope = 0.0;
+            }
+
+            if (minimumY >= clipTop && minimumY < maxHeight) {
+                edgeVisitor(EdgeData(maximumY, initialX, inverseSlope, minimumY, windingDirection), minYIndex, maxYIndex);
+            }
+        }
+    }
+
+public:
+    // Blocos da ET/AET reutilizados pelos rasterizadores de múltiplos polígonos
+
+    /**
+     * @brief Ordena as arestas por minimumY com radix sort LSD (8 bits por passada)
+     *
+     * O custo é O(arestas) por passada e o número de passadas depende apenas
+     * da extensão Y do polígono, nunca da altura da janela.
+     */
+    template <typename Edge>
+    void radixSortByMinimumY(BasicCompactEdgeTable<Edge>& compactTable) const {
+        std::vector<Edge>& edges = compactTable.edges;
+        std::vector<Edge>& scratch = compactTable.sortScratch;
+        
+        unsigned int keyRange = static_cast<unsigned int>(compactTable.lastScanLine - compactTable.firstScanLine);
+        if (edges.size() < 2 || keyRange == 0) {
+            return;
+        }
+        
+        scratch.resize(edges.size(), edges.front());
+        
+        for (unsigned int shift = 0; shift < 32 && (keyRange >> shift) != 0; shift += 8) {
+            size_t bucketOffsets[257] = {0};
+            
+            for (const Edge& edge : edges) {
+                unsigned int key = static_cast<unsigned int>(edge.minimumY - compactTable.firstScanLine);
+                bucketOffsets[((key >> shift) & 0xFF) + 1]++;
             }
+            for (int bucket = 0; bucket < 256; ++bucket) {
+                bucketOffsets[bucket + 1] += bucketOffsets[bucket];
+            }
+            for (const Edge& edge : edges) {
+                unsigned int key = static_cast<unsigned int>(edge.minimumY - compactTable.firstScanLine);
+                scratch[bucketOffsets[(key >> shift) & 0xFF]++] = edge;
+            }
+            
+            edges.swap(scratch);
+        }
+    }
+
+    /**
+     * @brief Acrescenta uma aresta à ET compacta atualizando a extensão Y
+     */
+    template <typename Edge>
+    static void appendCompactEdge(BasicCompactEdgeTable<Edge>& compactTable, const Edge& edge) {
+        if (compactTable.edges.empty()) {
+            compactTable.firstScanLine = edge.minimumY;
+            compactTable.lastScanLine = edge.minimumY;
+        } else {
+            compactTable.firstScanLine = std::min(compactTable.firstScanLine, edge.minimumY);
+            compactTable.lastScanLine = std::max(compactTable.lastScanLine, edge.minimumY);
+        }
+        compactTable.edges.push_back(edge);
+    }
+
+    /**
+     * @brief Divisão inteira com arredondamento para baixo (também para negativos)
+     */
+    static long long floorDivide(long long numerator, long long denominator) {
+        long long quotient = numerator / denominator;
+        if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0))) {
+            quotient--;
+        }
+        return quotient;
+    }
+
+    /**
+     * @brief Cria a aresta inteira para o segmento (x0, y0)-(x1, y1), com y0 < y1
+     *
+     * A aresta cobre as scanlines y com y0 <= y + 0.5 < y1, ou seja [y0, y1 - 1],
+     * começando em startScanLine (>= y0) para já pular o que está acima da janela.
+     * windingDirection é +1 se o polígono percorre o segmento de (x0, y0) para
+     * (x1, y1) e -1 no sentido contrário.
+     */
+    static FixedEdgeData makeFixedEdge(int x0, int y0, int x1, int y1, int startScanLine, int windingDirection = 1) {
+        long long deltaX = static_cast<long long>(x1) - x0;
+        long long deltaY = static_cast<long long>(y1) - y0;
+        long long denominator = 2 * deltaY;
+        
+        // N(y) = (2 * x0 - 1) * dy + (2 * (y - y0) + 1) * dx, interseção = N / D + 0.5
+        long long numerator = (2LL * x0 - 1) * deltaY + (2LL * (startScanLine - y0) + 1) * deltaX;
+        long long startX = -floorDivide(-numerator, denominator);
+        long long stepWhole = floorDivide(2 * deltaX, denominator);
+        
+        return FixedEdgeData(y1,
+                             static_cast<int>(startX),
+                             static_cast<int>(startX * denominator - numerator),
+                             static_cast<int>(stepWhole),
+                             static_cast<int>(2 * deltaX - stepWhole * denominator),
+                             static_cast<int>(denominator),
+                             startScanLine,
+                             windingDirection);
+    }
+
+    /**
+     * @brief Primeira scanline cujo centro (y + 0.5) fica em ou abaixo de fixedY (24.8)
+     */
+    static int firstSubpixelScanLine(int fixedY) {
+        const long long halfPixel = SubpixelPoint2D::ONE_PIXEL / 2;
+        return static_cast<int>(-floorDivide(halfPixel - fixedY, SubpixelPoint2D::ONE_PIXEL));
+    }
+
+    /**
+     * @brief Cria a aresta inteira para o segmento 24.8 (x0, y0)-(x1, y1), com y0 < y1
+     *
+     * Mesma amostragem de makeFixedEdge: a aresta cobre as scanlines com
+     * y0 <= 256 * y + 128 < y1 e currentX é o primeiro centro de pixel em ou à
+     * direita da interseção. Com N(y) = (x0 - 128) * dy + (256 * y + 128 - y0) * dx,
+     * currentX = ceil(N / (256 * dy)) = ceil(ceil(N / 256) / dy); como N avança
+     * 256 * dx por scanline, o numerador ceil(N / 256) avança exatamente dx e o
+     * denominador fica dy, o que mantém os campos de FixedEdgeData em int.
+     */
+    static FixedEdgeData makeSubpixelEdge(int x0, int y0, int x1, int y1, int startScanLine, int windingDirection = 1) {
+        const long long onePixel = SubpixelPoint2D::ONE_PIXEL;
+        const long long halfPixel = onePixel / 2;
+        long long deltaX = static_cast<long long>(x1) - x0;
+        long long deltaY = static_cast<long long>(y1) - y0;
+        
+        long long scaledNumerator = (x0 - halfPixel) * deltaY + 
+                                    (onePixel * startScanLine + halfPixel - y0) * deltaX;
+        long long numerator = -floorDivide(-scaledNumerator, onePixel);
+        long long startX = -floorDivide(-numerator, deltaY);
+        long long stepWhole = floorDivide(deltaX, deltaY);
+        
+        return FixedEdgeData(firstSubpixelScanLine(y1),
+                             static_cast<int>(startX),
+                             static_cast<int>(startX * deltaY - numerator),
+                             static_cast<int>(stepWhole),
+                             static_cast<int>(deltaX - stepWhole * deltaY),
+                             static_cast<int>(deltaY),
+                             startScanLine,
+                             windingDirection);
+    }
+
+private:
+    /**
+     * @brief Acrescenta à ET a aresta top-bottom se ela cruzar a faixa [bandStart, bandEnd)
+     */
+    static void appendFixedSegment(FixedCompactEdgeTable& compactTable, 
+                                   const Point2D& topVertex, 
+                                   const Point2D& bottomVertex,
+                                   int windingDirection,
+                                   int bandStart,
+                                   int bandEnd,
+                                   int clipLeftColumn,
+                                   int maxWidth) {
+        int startScanLine = std::max(topVertex.coordinateY, bandStart);
+        if (startScanLine >= bottomVertex.coordinateY || startScanLine >= bandEnd) {
+            return;
+        }
+        
+        int collapsedX = 0;
+        if (collapseOffscreenEdge(topVertex.coordinateX, bottomVertex.coordinateX, clipLeftColumn, maxWidth, collapsedX)) {
+            appendCompactEdge(compactTable, makeFixedEdge(collapsedX, topVertex.coordinateY,
+                                                          collapsedX, bottomVertex.coordinateY,
+                                                          startScanLine, windingDirection));
+            return;
+        }
+        
+        appendCompactEdge(compactTable, makeFixedEdge(topVertex.coordinateX, topVertex.coordinateY,
+                                                      bottomVertex.coordinateX, bottomVertex.coordinateY,
+                                                      startScanLine, windingDirection));
+    }
+
+    /**
+     * @brief Versão 24.8 de appendFixedSegment (recorte em X pelas pontas em subpixels)
+     */
+    static void appendSubpixelSegment(FixedCompactEdgeTable& compactTable, 
+                                      const SubpixelPoint2D& topVertex, 
+                                      const SubpixelPoint2D& bottomVertex,
+                                      int windingDirection,
+                                      int bandStart,
+                                      int bandEnd,
+                                      int clipLeftColumn,
+                                      int maxWidth) {
+        int startScanLine = std::max(firstSubpixelScanLine(topVertex.fixedY), bandStart);
+        if (startScanLine >= firstSubpixelScanLine(bottomVertex.fixedY) || startScanLine >= bandEnd) {
+            return;
+        }
+        
+        long long leftLimit = static_cast<long long>(clipLeftColumn) * SubpixelPoint2D::ONE_PIXEL;
+        long long rightLimit = static_cast<long long>(maxWidth) * SubpixelPoint2D::ONE_PIXEL;
+        int collapsedX = 0;
+        bool isCollapsed = false;
+        if (topVertex.fixedX < leftLimit && bottomVertex.fixedX < leftLimit) {
+            collapsedX = offscreenLeftColumn(clipLeftColumn);
+            isCollapsed = true;
+        } else if (topVertex.fixedX >= rightLimit && bottomVertex.fixedX >= rightLimit) {
+            collapsedX = maxWidth;
+            isCollapsed = true;
         }
+        
+        if (isCollapsed) {
+            // Aresta vertical sobre a borda esquerda do pixel: currentX = collapsedX
+            int fixedX = collapsedX * SubpixelPoint2D::ONE_PIXEL;
+            appendCompactEdge(compactTable, makeSubpixelEdge(fixedX, topVertex.fixedY,
+                                                             fixedX, bottomVertex.fixedY,
+                                                             startScanLine, windingDirection));
+            return;
+        }
+        
+        appendCompactEdge(compactTable, makeSubpixelEdge(topVertex.fixedX, topVertex.fixedY,
+                                                         bottomVertex.fixedX, bottomVertex.fixedY,
+                                                         startScanLine, windingDirection));
+    }
+
+public:
+    PolygonFillAlgorithm() 
+        : activeEdgeOrdering(ActiveEdgeOrdering::INCREMENTAL_INSERTION),
+          edgeSteppingMode(EdgeSteppingMode::FLOATING_POINT),
+          activeEdgeLayout(ActiveEdgeLayout::ARRAY_OF_STRUCTURES),
+          fillRule(FillRule::EVEN_ODD),
+          clipLeft(0),
+          clipTop(0) {}
+
+    /**
+     * @brief Define como a AET é mantida ordenada entre scanlines
+     * @param ordering FULL_SORT (std::sort a cada scanline) ou INCREMENTAL_INSERTION
+     */
+    void setActiveEdgeOrdering(ActiveEdgeOrdering ordering) {
+        activeEdgeOrdering = ordering;
+    }
+
+    ActiveEdgeOrdering getActiveEdgeOrdering() const {
+        return activeEdgeOrdering;
+    }
+
+    /**
+     * @brief Define a representação das arestas durante a varredura
+     * @param steppingMode FLOATING_POINT (EdgeData) ou INTEGER_DDA (FixedEdgeData)
+     */
+    void setEdgeSteppingMode(EdgeSteppingMode steppingMode) {
+        edgeSteppingMode = steppingMode;
+    }
+
+    EdgeSteppingMode getEdgeSteppingMode() const {
+        return edgeSteppingMode;
+    }
+
+    /**
+     * @brief true se fillConvexPolygon pinta os mesmos pixels que fillPolygon (modo INTEGER_DDA)
+     */
+    bool isConvexFastPathExact() const {
+        return edgeSteppingMode == EdgeSteppingMode::INTEGER_DDA;
+    }
+
+    /**
+     * @brief Define o layout da AET no modo FLOATING_POINT
+     * @param layout ARRAY_OF_STRUCTURES (vetor de EdgeData) ou STRUCTURE_OF_ARRAYS (SoAActiveEdgeTable)
+     */
+    void setActiveEdgeLayout(ActiveEdgeLayout layout) {
+        activeEdgeLayout = layout;
+    }
+
+    ActiveEdgeLayout getActiveEdgeLayout() const {
+        return activeEdgeLayout;
+    }
+
+    /**
+     * @brief Define a regra de preenchimento
+     * @param rule EVEN_ODD (pares de arestas) ou NONZERO (soma das direções das arestas)
+     */
+    void setFillRule(FillRule rule) {
+        fillRule = rule;
+    }
+
+    FillRule getFillRule() const {
+        return fillRule;
+    }
+
+    /**
+     * @brief Define o canto superior esquerdo da área recortada (padrão: 0, 0)
+     *
+     * Colunas à esquerda de clipLeftColumn e scanlines acima de clipTopScanLine
+     * não são emitidas; maxWidth e maxHeight continuam sendo os limites direito
+     * e inferior (exclusivos). Arestas que começam acima de clipTopScanLine
+     * são avançadas até ela, como as que começam acima da janela com origem
+     * em 0, o que permite varrer além da janela sem transladar os vértices
+     * (transladar muda o arredondamento no modo FLOATING_POINT).
+     * clipTopScanLine pode ser negativa (PolygonSpanMask varre as linhas acima
+     * da janela): as arestas passam a ter minimumY < 0, e as ETs são
+     * indexadas a partir de clipTop.
+     */
+    void setClipOrigin(int clipLeftColumn, int clipTopScanLine) {
+        clipLeft = clipLeftColumn;
+        clipTop = clipTopScanLine;
+    }
+
+    int getClipLeft() const {
+        return clipLeft;
+    }
+
+    int getClipTop() const {
+        return clipTop;
+    }
+
+    /**
+     * @brief Constrói a Edge Table (ET) a partir dos vértices do polígono
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @return Edge Table organizada por coordenada Y; o bucket i guarda as arestas que começam em clipTop + i
+     */
+    EdgeTable buildEdgeTable(const std::vector<Point2D>& polygonVertices, int maxHeight) const {
+        EdgeTable edgeTable(static_cast<size_t>(std::max(maxHeight - clipTop, 0)));
+        
+        const int firstScanLine = clipTop;
+        forEachPolygonEdge(polygonVertices, maxHeight, std::numeric_limits<int>::max(), 
+                           [&edgeTable, firstScanLine](const EdgeData& edge, size_t, size_t) {
+            edgeTable[edge.minimumY - firstScanLine].push_back(edge);
+        });
 
         return edgeTable;
     }
 
+    /**
+     * @brief Constrói a ET compacta: todas as arestas em um único vetor ordenado por minimumY
+     *
+     * Diferente de buildEdgeTable, não aloca um bucket por scanline da janela;
+     * o custo é proporcional ao número de arestas. A memória de compactTable
+     * é reaproveitada entre chamadas.
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @param compactTable ET compacta de saída
+     */
+    void buildCompactEdgeTable(const std::vector<Point2D>& polygonVertices, 
+                               int maxHeight,
+                               CompactEdgeTable& compactTable) const {
+        buildCompactEdgeTable(polygonVertices, maxHeight, std::numeric_limits<int>::max(), compactTable);
+    }
+
+    /**
+     * @brief Constrói a ET compacta recortada também em X (ver forEachPolygonEdge)
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param compactTable ET compacta de saída
+     */
+    void buildCompactEdgeTable(const std::vector<Point2D>& polygonVertices, 
+                               int maxHeight,
+                               int maxWidth,
+                               CompactEdgeTable& compactTable) const {
+        compactTable.clear();
+        compactTable.edges.reserve(polygonVertices.size());
+        
+        forEachPolygonEdge(polygonVertices, maxHeight, maxWidth, [&compactTable](const EdgeData& edge, size_t, size_t) {
+            appendCompactEdge(compactTable, edge);
+        });
+        
+        radixSortByMinimumY(compactTable);
+    }
+
+    /**
+     * @brief Constrói a ET compacta de arestas inteiras (modo INTEGER_DDA)
+     *
+     * Usa a regra de amostragem no centro do pixel com intervalos semiabertos,
+     * o que dispensa o tratamento especial de picos e vales e descarta as
+     * arestas horizontais. Arestas que começam acima da janela são avançadas
+     * exatamente até a scanline clipTop em vez de serem descartadas.
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param maxHeight Altura máxima da área de desenho
+     * @param compactTable ET compacta de saída
+     * @param maxWidth Largura da área de desenho para o recorte em X (padrão: sem recorte)
+     */
+    void buildFixedEdgeTable(const std::vector<Point2D>& polygonVertices, 
+                             int maxHeight,
+                             FixedCompactEdgeTable& compactTable,
+                             int maxWidth = std::numeric_limits<int>::max()) const {
+        buildFixedEdgeTable(polygonVertices, clipTop, maxHeight, compactTable, maxWidth);
+    }
+
+    /**
+     * @brief Constrói a ET inteira restrita à faixa de scanlines [bandStart, bandEnd)
+     *
+     * Cada aresta que cruza a faixa é semeada exatamente na primeira scanline
+     * da faixa, então faixas diferentes podem ser varridas de forma independente.
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param bandStart Primeira scanline da faixa
+     * @param bandEnd Scanline seguinte à última da faixa
+     * @param compactTable ET compacta de saída
+     * @param maxWidth Largura da área de desenho para o recorte em X (padrão: sem recorte)
+     */
+    void buildFixedEdgeTable(const std::vector<Point2D>& polygonVertices, 
+                             int bandStart,
+                             int bandEnd,
+                             FixedCompactEdgeTable& compactTable,
+                             int maxWidth = std::numeric_limits<int>::max()) const {
+        compactTable.clear();
+        compactTable.edges.reserve(polygonVertices.size());
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            if (currentVertex.coordinateY < nextVertex.coordinateY) {
+                appendFixedSegment(compactTable, currentVertex, nextVertex, 1, bandStart, bandEnd, clipLeft, maxWidth);
+            } else if (nextVertex.coordinateY < currentVertex.coordinateY) {
+                appendFixedSegment(compactTable, nextVertex, currentVertex, -1, bandStart, bandEnd, clipLeft, maxWidth);
+            }
+        }
+        
+        radixSortByMinimumY(compactTable);
+    }
+
+    /**
+     * @brief Constrói a ET inteira da faixa [bandStart, bandEnd) a partir de arestas já extraídas
+     *
+     * Permite que quem varre o mesmo polígono várias vezes (por faixa ou por
+     * tile) passe apenas as arestas relevantes em vez de todos os vértices.
+     * @param edgeSegments Arestas não horizontais (ver collectEdgeSegments)
+     * @param bandStart Primeira scanline da faixa
+     * @param bandEnd Scanline seguinte à última da faixa
+     * @param compactTable ET compacta de saída
+     * @param maxWidth Largura da área de desenho para o recorte em X (padrão: sem recorte)
+     */
+    void buildFixedEdgeTable(const std::vector<EdgeSegment>& edgeSegments, 
+                             int bandStart,
+                             int bandEnd,
+                             FixedCompactEdgeTable& compactTable,
+                             int maxWidth = std::numeric_limits<int>::max()) const {
+        compactTable.clear();
+        compactTable.edges.reserve(edgeSegments.size());
+        
+        for (const EdgeSegment& segment : edgeSegments) {
+            appendFixedSegment(compactTable, segment.topVertex, segment.bottomVertex, 
+                               segment.windingDirection, bandStart, bandEnd, clipLeft, maxWidth);
+        }
+        
+        radixSortByMinimumY(compactTable);
+    }
+
+    /**
+     * @brief Versão 24.8 de buildFixedEdgeTable por arestas já extraídas
+     */
+    void buildFixedEdgeTable(const std::vector<SubpixelEdgeSegment>& edgeSegments, 
+                             int bandStart,
+                             int bandEnd,
+                             FixedCompactEdgeTable& compactTable,
+                             int maxWidth = std::numeric_limits<int>::max()) const {
+        compactTable.clear();
+        compactTable.edges.reserve(edgeSegments.size());
+        
+        for (const SubpixelEdgeSegment& segment : edgeSegments) {
+            appendSubpixelSegment(compactTable, segment.topVertex, segment.bottomVertex, 
+                                  segment.windingDirection, bandStart, bandEnd, clipLeft, maxWidth);
+        }
+        
+        radixSortByMinimumY(compactTable);
+    }
+
+    /**
+     * @brief Constrói a ET inteira da faixa [bandStart, bandEnd) a partir de vértices 24.8
+     *
+     * As arestas são semeadas no centro da scanline sem passar por ponto
+     * flutuante (ver makeSubpixelEdge), então os spans são exatos também para
+     * geometria que não cai em pixels inteiros. Arestas que não cruzam nenhum
+     * centro de scanline são descartadas.
+     * @param polygonVertices Vértices do polígono em ponto fixo 24.8
+     * @param bandStart Primeira scanline da faixa
+     * @param bandEnd Scanline seguinte à última da faixa
+     * @param compactTable ET compacta de saída
+     * @param maxWidth Largura da área de desenho para o recorte em X (padrão: sem recorte)
+     */
+    void buildFixedEdgeTable(const std::vector<SubpixelPoint2D>& polygonVertices, 
+                             int bandStart,
+                             int bandEnd,
+                             FixedCompactEdgeTable& compactTable,
+                             int maxWidth = std::numeric_limits<int>::max()) const {
+        compactTable.clear();
+        compactTable.edges.reserve(polygonVertices.size());
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const SubpixelPoint2D& currentVertex = polygonVertices[vertexIndex];
+            const SubpixelPoint2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            if (currentVertex.fixedY < nextVertex.fixedY) {
+                appendSubpixelSegment(compactTable, currentVertex, nextVertex, 1, bandStart, bandEnd, clipLeft, maxWidth);
+            } else if (nextVertex.fixedY < currentVertex.fixedY) {
+                appendSubpixelSegment(compactTable, nextVertex, currentVertex, -1, bandStart, bandEnd, clipLeft, maxWidth);
+            }
+        }
+        
+        radixSortByMinimumY(compactTable);
+    }
+
+    /**
+     * @brief Extrai as arestas não horizontais do polígono, orientadas de cima para baixo
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param edgeSegments Vetor de saída (conteúdo anterior é descartado)
+     */
+    static void collectEdgeSegments(const std::vector<Point2D>& polygonVertices, 
+                                    std::vector<EdgeSegment>& edgeSegments) {
+        edgeSegments.clear();
+        edgeSegments.reserve(polygonVertices.size());
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            if (currentVertex.coordinateY < nextVertex.coordinateY) {
+                edgeSegments.push_back(EdgeSegment(currentVertex, nextVertex, 1));
+            } else if (nextVertex.coordinateY < currentVertex.coordinateY) {
+                edgeSegments.push_back(EdgeSegment(nextVertex, currentVertex, -1));
+            }
+        }
+    }
+
+    /**
+     * @brief Teste de referência ponto-no-polígono (par-ímpar) no centro do pixel
+     *
+     * Conta as arestas cuja interseção com y + 0.5 fica em x <= x + 0.5, usando
+     * apenas aritmética inteira. O modo INTEGER_DDA preenche exatamente os
+     * pixels para os quais este teste retorna true.
+     * @param polygonVertices Vetor com os vértices do polígono
+     * @param pixelX Coluna do pixel
+     * @param pixelY Linha do pixel
+     * @return true se o centro do pixel está dentro do polígono
+     */
+    static bool isPixelCenterInside(const std::vector<Point2D>& polygonVertices, int pixelX, int pixelY) {
+        bool isInside = false;
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            const Point2D& topVertex = (currentVertex.coordinateY < nextVertex.coordinateY) ? currentVertex : nextVertex;
+            const Point2D& bottomVertex = (currentVertex.coordinateY < nextVertex.coordinateY) ? nextVertex : currentVertex;
+            
+            if (!(topVertex.coordinateY <= pixelY && pixelY < bottomVertex.coordinateY)) {
+                continue;
+            }
+            
+            long long deltaX = static_cast<long long>(bottomVertex.coordinateX) - topVertex.coordinateX;
+            long long deltaY = static_cast<long long>(bottomVertex.coordinateY) - topVertex.coordinateY;
+            
+            // x0 + (y + 0.5 - y0) * dx / dy <= x + 0.5, multiplicado por 2 * dy > 0
+            long long intersectionTimesTwoDy = 2LL * topVertex.coordinateX * deltaY + 
+                                               (2LL * (pixelY - topVertex.coordinateY) + 1) * deltaX;
+            if (intersectionTimesTwoDy <= (2LL * pixelX + 1) * deltaY) {
+                isInside = !isInside;
+            }
+        }
+        
+        return isInside;
+    }
+
+    /**
+     * @brief Número de winding no centro do pixel (referência da regra NONZERO)
+     *
+     * Soma +1/-1 das arestas cuja interseção com y + 0.5 fica em x <= x + 0.5,
+     * com o mesmo critério de isPixelCenterInside.
+     * @return Diferente de zero se o centro do pixel é interior pela regra NONZERO
+     */
+    static int pixelCenterWindingNumber(const std::vector<Point2D>& polygonVertices, int pixelX, int pixelY) {
+        int windingNumber = 0;
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            bool isDescending = currentVertex.coordinateY < nextVertex.coordinateY;
+            const Point2D& topVertex = isDescending ? currentVertex : nextVertex;
+            const Point2D& bottomVertex = isDescending ? nextVertex : currentVertex;
+            
+            if (!(topVertex.coordinateY <= pixelY && pixelY < bottomVertex.coordinateY)) {
+                continue;
+            }
+            
+            long long deltaX = static_cast<long long>(bottomVertex.coordinateX) - topVertex.coordinateX;
+            long long deltaY = static_cast<long long>(bottomVertex.coordinateY) - topVertex.coordinateY;
+            long long intersectionTimesTwoDy = 2LL * topVertex.coordinateX * deltaY + 
+                                               (2LL * (pixelY - topVertex.coordinateY) + 1) * deltaX;
+            if (intersectionTimesTwoDy <= (2LL * pixelX + 1) * deltaY) {
+                windingNumber += isDescending ? 1 : -1;
+            }
+        }
+        
+        return windingNumber;
+    }
+
+    /**
+     * @brief Número de winding no centro do pixel para vértices 24.8
+     *
+     * Mesmo critério de pixelCenterWindingNumber com o centro em
+     * (256 * x + 128, 256 * y + 128); é a referência de fillPolygon com
+     * SubpixelPoint2D.
+     */
+    static int pixelCenterWindingNumber(const std::vector<SubpixelPoint2D>& polygonVertices, int pixelX, int pixelY) {
+        const long long halfPixel = SubpixelPoint2D::ONE_PIXEL / 2;
+        long long sampleX = static_cast<long long>(pixelX) * SubpixelPoint2D::ONE_PIXEL + halfPixel;
+        long long sampleY = static_cast<long long>(pixelY) * SubpixelPoint2D::ONE_PIXEL + halfPixel;
+        int windingNumber = 0;
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const SubpixelPoint2D& currentVertex = polygonVertices[vertexIndex];
+            const SubpixelPoint2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            
+            bool isDescending = currentVertex.fixedY < nextVertex.fixedY;
+            const SubpixelPoint2D& topVertex = isDescending ? currentVertex : nextVertex;
+            const SubpixelPoint2D& bottomVertex = isDescending ? nextVertex : currentVertex;
+            
+            if (!(topVertex.fixedY <= sampleY && sampleY < bottomVertex.fixedY)) {
+                continue;
+            }
+            
+            // x0 + (sy - y0) * dx / dy <= sx, multiplicado por dy > 0
+            long long deltaX = static_cast<long long>(bottomVertex.fixedX) - topVertex.fixedX;
+            long long deltaY = static_cast<long long>(bottomVertex.fixedY) - topVertex.fixedY;
+            long long intersectionTimesDy = static_cast<long long>(topVertex.fixedX) * deltaY + 
+                                            (sampleY - topVertex.fixedY) * deltaX;
+            if (intersectionTimesDy <= sampleX * deltaY) {
+                windingNumber += isDescending ? 1 : -1;
+            }
+        }
+        
+        return windingNumber;
+    }
+
+    /**
+     * @brief Teste par-ímpar no centro do pixel para vértices 24.8
+     */
+    static bool isPixelCenterInside(const std::vector<SubpixelPoint2D>& polygonVertices, int pixelX, int pixelY) {
+        // Cada aresta cruzada soma +1 ou -1: a paridade da soma é a do número de arestas
+        return (pixelCenterWindingNumber(polygonVertices, pixelX, pixelY) & 1) != 0;
+    }
+
     /**
      * @brief Executa o algoritmo de preenchimento ET/AET
+     * @tparam SpanSink Destino dos spans gerados (GL, framebuffer em CPU, ...)
      * @param polygonVertices Vetor com os vértices do polígono
      * @param fillColor Cor do preenchimento
      * @param maxHeight Altura máxima da área de desenho
      * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans (scanLine, startX, endX, cor)
      */
+    template <typename SpanSink>
     void fillPolygon(const std::vector<Point2D>& polygonVertices, 
                     const ColorRGB& fillColor, 
                     int maxHeight,
-                    int maxWidth) const {
+                    int maxWidth,
+                    SpanSink& spanSink) const {
         if (polygonVertices.size() < 3) {
             return;
         }
         
-        EdgeTable edgeTable = buildEdgeTable(polygonVertices, maxHeight);
+        if (edgeSteppingMode == EdgeSteppingMode::INTEGER_DDA) {
+            fillPolygonIntegerDDA(polygonVertices, fillColor, maxHeight, maxWidth, spanSink);
+            return;
+        }
         
-        int currentScanLine = 0;
-        while (currentScanLine < edgeTable.size() && edgeTable[currentScanLine].empty()) {
-            currentScanLine++;
+        if (activeEdgeLayout == ActiveEdgeLayout::STRUCTURE_OF_ARRAYS) {
+            fillPolygonStructureOfArrays(polygonVertices, fillColor, maxHeight, maxWidth, spanSink);
+            return;
         }
         
-        if (currentScanLine >= edgeTable.size()) {
+        CompactEdgeTable edgeTable;
+        buildCompactEdgeTable(polygonVertices, maxHeight, maxWidth, edgeTable);
+        
+        if (edgeTable.edges.empty()) {
             return;
         }
         
         std::vector<EdgeData> activeEdgeTable;
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        bool incrementalOrdering = (activeEdgeOrdering == ActiveEdgeOrdering::INCREMENTAL_INSERTION);
         
-        glColor3f(fillColor.redComponent, fillColor.greenComponent, fillColor.blueComponent);
-        
-        while (currentScanLine < edgeTable.size() || !activeEdgeTable.empty()) {
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
             
-            if (currentScanLine < edgeTable.size() && !edgeTable[currentScanLine].empty()) {
-                for (const EdgeData& edge : edgeTable[currentScanLine]) {
-                    activeEdgeTable.push_back(edge);
-                }
+            // Sem arestas ativas: salta direto para o próximo evento da ET
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
             }
             
-            std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
-                [](const EdgeData& edge1, const EdgeData& edge2) {
-                    return edge1.currentX < edge2.currentX;
-                });
+            if (currentScanLine >= maxHeight) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                if (incrementalOrdering) {
+                    insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                } else {
+                    activeEdgeTable.push_back(edgeTable.edges[nextEdgeIndex]);
+                }
+                nextEdgeIndex++;
+            }
+            
+            if (!incrementalOrdering) {
+                std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [](const EdgeData& edge1, const EdgeData& edge2) {
+                        return edge1.currentX < edge2.currentX;
+                    });
+            }
             
             if (activeEdgeTable.size() >= 2) {
-                glBegin(GL_LINES); // Usar linhas para preencher o span horizontal
-                for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size() - 1; edgeIndex += 2) {
-                    int x1 = static_cast<int>(activeEdgeTable[edgeIndex].currentX + 0.5);
-                    int x2 = static_cast<int>(activeEdgeTable[edgeIndex + 1].currentX + 0.5);
+                emitScanLineSpans(activeEdgeTable, currentScanLine, fillColor, maxHeight, maxWidth, spanSink);
+            }
+            
+            currentScanLine++;
+            
+            for (EdgeData& edge : activeEdgeTable) {
+                edge.currentX += edge.inverseSlope;
+            }
+            
+            if (incrementalOrdering) {
+                restoreActiveEdgeOrder(activeEdgeTable);
+            }
+            
+            activeEdgeTable.erase(
+                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [currentScanLine](const EdgeData& edge) { 
+                        return edge.maximumY <= currentScanLine; 
+                    }),
+                activeEdgeTable.end()
+            );
+        }
+    }
+
+    /**
+     * @brief Preenche um polígono com vértices em ponto fixo 24.8
+     *
+     * Sempre usa as arestas inteiras do modo INTEGER_DDA, independentemente de
+     * edgeSteppingMode: os spans são exatamente os centros de pixel aceitos
+     * por pixelCenterWindingNumber (ou isPixelCenterInside) para os vértices
+     * 24.8, sem conversão para ponto flutuante. Respeita a regra de
+     * preenchimento e a ordenação da AET.
+     * @param polygonVertices Vértices do polígono em ponto fixo 24.8
+     * @param fillColor Cor do preenchimento
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans
+     */
+    template <typename SpanSink>
+    void fillPolygon(const std::vector<SubpixelPoint2D>& polygonVertices, 
+                     const ColorRGB& fillColor, 
+                     int maxHeight,
+                     int maxWidth,
+                     SpanSink& spanSink) const {
+        if (polygonVertices.size() < 3) {
+            return;
+        }
+        
+        FixedCompactEdgeTable edgeTable;
+        buildFixedEdgeTable(polygonVertices, clipTop, maxHeight, edgeTable, maxWidth);
+        scanConvertFixedEdgeTable(edgeTable, fillColor, maxHeight, maxWidth, spanSink);
+    }
+
+    /**
+     * @brief Varredura ET/AET com arestas inteiras (modo INTEGER_DDA)
+     *
+     * Cada par de arestas (a, b) da AET vira o span [a.currentX, b.currentX - 1]:
+     * exatamente os centros de pixel com a <= x + 0.5 < b. Com FillRule::NONZERO
+     * os spans vão de onde o winding deixa zero até onde volta a zero, o que
+     * coincide com pixelCenterWindingNumber. A varredura para em scanLineEnd
+     * (altura da janela ou fim de uma faixa).
+     * @param edgeTable ET inteira (ver buildFixedEdgeTable); seu vetor activeEdges é usado como AET
+     * @param fillColor Cor do preenchimento
+     * @param scanLineEnd Scanline seguinte à última a ser varrida
+     * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans
+     */
+    template <typename SpanSink>
+    void scanConvertFixedEdgeTable(FixedCompactEdgeTable& edgeTable, 
+                                   const ColorRGB& fillColor, 
+                                   int scanLineEnd,
+                                   int maxWidth,
+                                   SpanSink& spanSink) const {
+        if (edgeTable.edges.empty()) {
+            return;
+        }
+        
+        std::vector<FixedEdgeData>& activeEdgeTable = edgeTable.activeEdges;
+        activeEdgeTable.clear();
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        bool incrementalOrdering = (activeEdgeOrdering == ActiveEdgeOrdering::INCREMENTAL_INSERTION);
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= scanLineEnd) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                if (incrementalOrdering) {
+                    insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                } else {
+                    activeEdgeTable.push_back(edgeTable.edges[nextEdgeIndex]);
+                }
+                nextEdgeIndex++;
+            }
+            
+            if (!incrementalOrdering) {
+                std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [](const FixedEdgeData& edge1, const FixedEdgeData& edge2) {
+                        return edge1.currentX < edge2.currentX;
+                    });
+            }
+            
+            if (fillRule == FillRule::NONZERO) {
+                // Span do ponto em que o winding deixa 0 até o ponto em que volta a 0
+                int windingNumber = 0;
+                int spanStartX = 0;
+                for (const FixedEdgeData& edge : activeEdgeTable) {
+                    int previousWinding = windingNumber;
+                    windingNumber += edge.windingDirection;
                     
-                    if (x1 > x2) {
-                        std::swap(x1, x2);
+                    if (previousWinding == 0) {
+                        spanStartX = edge.currentX;
+                    } else if (windingNumber == 0) {
+                        int x1 = std::max(spanStartX, clipLeft);
+                        int x2 = std::min(edge.currentX - 1, maxWidth - 1);
+                        if (x1 <= x2) {
+                            spanSink.emitSpan(currentScanLine, x1, x2, fillColor);
+                        }
                     }
+                }
+            } else {
+                for (size_t edgeIndex = 0; edgeIndex + 1 < activeEdgeTable.size(); edgeIndex += 2) {
+                    int x1 = std::max(activeEdgeTable[edgeIndex].currentX, clipLeft);
+                    int x2 = std::min(activeEdgeTable[edgeIndex + 1].currentX - 1, maxWidth - 1);
                     
-                    // Clamping
-                    if (x1 < 0) x1 = 0;
-                    if (x2 >= maxWidth) x2 = maxWidth - 1;
-                    
-                    if (x1 <= x2 && currentScanLine >= 0 && currentScanLine < maxHeight) {
-                         glVertex2i(x1, currentScanLine);
-                         glVertex2i(x2 + 1, currentScanLine); 
+                    if (x1 <= x2) {
+                        spanSink.emitSpan(currentScanLine, x1, x2, fillColor);
                     }
                 }
-                glEnd();
+            }
+            
+            currentScanLine++;
+            
+            for (FixedEdgeData& edge : activeEdgeTable) {
+                edge.advance();
+            }
+            
+            if (incrementalOrdering) {
+                restoreActiveEdgeOrder(activeEdgeTable);
+            }
+            
+            activeEdgeTable.erase(
+                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [currentScanLine](const FixedEdgeData& edge) { 
+                        return edge.maximumY <= currentScanLine; 
+                    }),
+                activeEdgeTable.end()
+            );
+        }
+    }
+
+    /**
+     * @brief Preenche o polígono interpolando as cores dos vértices (Gouraud 2D)
+     *
+     * Usa as mesmas arestas (e portanto os mesmos spans) do modo FLOATING_POINT
+     * com AET em vetor, respeitando a regra de preenchimento e a ordenação da
+     * AET. Cada aresta carrega a cor e o incremento por scanline; em cada
+     * span a cor das pontas é interpolada entre as duas arestas e o destino
+     * recebe emitShadedSpan(scanLine, startX, endX, corInicial, corFinal),
+     * com as cores nos centros dos pixels startX e endX.
+     * @param vertexColors Uma cor por vértice (mesmo tamanho de polygonVertices)
+     */
+    template <typename ShadedSpanSink>
+    void fillPolygonGouraud(const std::vector<Point2D>& polygonVertices, 
+                            const std::vector<ColorRGB>& vertexColors,
+                            int maxHeight,
+                            int maxWidth,
+                            ShadedSpanSink& spanSink) const {
+        if (polygonVertices.size() < 3 || vertexColors.size() != polygonVertices.size()) {
+            return;
+        }
+        
+        BasicCompactEdgeTable<ShadedEdgeData> edgeTable;
+        edgeTable.edges.reserve(polygonVertices.size());
+        // Sem colapsar arestas fora da janela em X: a aresta movida perderia a
+        // cor correta na nova coluna. O recorte fica a cargo dos spans.
+        forEachPolygonEdge(polygonVertices, maxHeight, std::numeric_limits<int>::max(), 
+            [&](const EdgeData& edge, size_t topIndex, size_t bottomIndex) {
+                const ColorRGB& topColor = vertexColors[topIndex];
+                const ColorRGB& bottomColor = vertexColors[bottomIndex];
+                int topY = polygonVertices[topIndex].coordinateY;
+                int edgeHeight = polygonVertices[bottomIndex].coordinateY - topY;
+                double colorScale = edgeHeight > 0 ? 1.0 / edgeHeight : 0.0;
+                double redStep = (bottomColor.redComponent - topColor.redComponent) * colorScale;
+                double greenStep = (bottomColor.greenComponent - topColor.greenComponent) * colorScale;
+                double blueStep = (bottomColor.blueComponent - topColor.blueComponent) * colorScale;
+                // Arestas ajustadas (vale, recorte no topo) começam abaixo do vértice
+                int skippedScanLines = edge.minimumY - topY;
                 
-                if (activeEdgeTable.size() % 2 == 1) {
-                    int x = static_cast<int>(activeEdgeTable[activeEdgeTable.size() - 1].currentX + 0.5);
-                    if (x >= 0 && x < maxWidth && currentScanLine >= 0 && currentScanLine < maxHeight) {
-                        glBegin(GL_POINTS);
-                        glVertex2i(x, currentScanLine);
-                        glEnd();
-                    }
+                appendCompactEdge(edgeTable, ShadedEdgeData(edge,
+                    topColor.redComponent + redStep * skippedScanLines,
+                    topColor.greenComponent + greenStep * skippedScanLines,
+                    topColor.blueComponent + blueStep * skippedScanLines,
+                    redStep, greenStep, blueStep));
+            });
+        radixSortByMinimumY(edgeTable);
+        
+        if (edgeTable.edges.empty()) {
+            return;
+        }
+        
+        std::vector<ShadedEdgeData>& activeEdgeTable = edgeTable.activeEdges;
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        bool incrementalOrdering = (activeEdgeOrdering == ActiveEdgeOrdering::INCREMENTAL_INSERTION);
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= maxHeight) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                if (incrementalOrdering) {
+                    insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                } else {
+                    activeEdgeTable.push_back(edgeTable.edges[nextEdgeIndex]);
                 }
+                nextEdgeIndex++;
+            }
+            
+            if (!incrementalOrdering) {
+                std::sort(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [](const ShadedEdgeData& edge1, const ShadedEdgeData& edge2) {
+                        return edge1.currentX < edge2.currentX;
+                    });
+            }
+            
+            if (activeEdgeTable.size() >= 2) {
+                emitShadedScanLineSpans(activeEdgeTable, currentScanLine, maxWidth, spanSink);
             }
             
             currentScanLine++;
             
-            for (EdgeData& edge : activeEdgeTable) {
-                edge.currentX += edge.inverseSlope;
+            for (ShadedEdgeData& edge : activeEdgeTable) {
+                edge.advance();
+            }
+            
+            if (incrementalOrdering) {
+                restoreActiveEdgeOrder(activeEdgeTable);
             }
             
             activeEdgeTable.erase(
                 std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
-                    [currentScanLine](const EdgeData& edge) { 
+                    [currentScanLine](const ShadedEdgeData& edge) { 
                         return edge.maximumY <= currentScanLine; 
                     }),
                 activeEdgeTable.end()
             );
+        }
+    }
+
+private:
+    /**
+     * @brief Varredura ET/AET com a AET em layout SoA (avanço e remoção vetorizados)
+     *
+     * Produz os mesmos spans do caminho ARRAY_OF_STRUCTURES; a AET é sempre
+     * mantida por inserção ordenada, independentemente de activeEdgeOrdering.
+     * ET e faixas da AET são membros reaproveitados, então este caminho não
+     * pode ser chamado por duas threads no mesmo PolygonFillAlgorithm.
+     */
+    template <typename SpanSink>
+    void fillPolygonStructureOfArrays(const std::vector<Point2D>& polygonVertices, 
+                                      const ColorRGB& fillColor, 
+                                      int maxHeight,
+                                      int maxWidth,
+                                      SpanSink& spanSink) const {
+        CompactEdgeTable& edgeTable = structureOfArraysEdgeTable;
+        buildCompactEdgeTable(polygonVertices, maxHeight, maxWidth, edgeTable);
+        
+        if (edgeTable.edges.empty()) {
+            return;
+        }
+        
+        SoAActiveEdgeTable& activeEdgeTable = structureOfArraysActiveEdges;
+        activeEdgeTable.clear();
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= maxHeight) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                activeEdgeTable.insert(edgeTable.edges[nextEdgeIndex]);
+                nextEdgeIndex++;
+            }
+            
+            if (activeEdgeTable.size() >= 2) {
+                emitScanLineSpans(activeEdgeTable, currentScanLine, fillColor, maxHeight, maxWidth, spanSink);
+            }
+            
+            currentScanLine++;
+            
+            activeEdgeTable.advance();
+            activeEdgeTable.restoreOrder();
+            activeEdgeTable.retire(currentScanLine);
+        }
+    }
+
+    /**
+     * @brief Preenchimento no modo INTEGER_DDA
+     */
+    template <typename SpanSink>
+    void fillPolygonIntegerDDA(const std::vector<Point2D>& polygonVertices, 
+                               const ColorRGB& fillColor, 
+                               int maxHeight,
+                               int maxWidth,
+                               SpanSink& spanSink) const {
+        FixedCompactEdgeTable edgeTable;
+        buildFixedEdgeTable(polygonVertices, maxHeight, edgeTable, maxWidth);
+        scanConvertFixedEdgeTable(edgeTable, fillColor, maxHeight, maxWidth, spanSink);
+    }
+
+    /**
+     * @struct ConvexChain
+     * @brief Cadeia lateral (esquerda ou direita) de um polígono convexo
+     */
+    struct ConvexChain {
+        size_t vertexIndex;       // Vértice do topo da aresta corrente
+        size_t stepForward;       // 1 (sentido dos vértices) ou n - 1 (sentido contrário)
+        FixedEdgeData edge;
+
+        ConvexChain(size_t startIndex, size_t step) 
+            : vertexIndex(startIndex), stepForward(step), edge(0, 0, 0, 0, 0, 1, 0) {}
+    };
+
+    /**
+     * @brief Avança a cadeia até a aresta que cobre a scanline e a semeia nela
+     * @return false se a cadeia chegou ao vértice mais baixo
+     */
+    static bool seedConvexChain(const std::vector<Point2D>& polygonVertices, ConvexChain& chain, int scanLine) {
+        const size_t vertexCount = polygonVertices.size();
+        
+        for (size_t guard = 0; guard < vertexCount; ++guard) {
+            const Point2D& fromVertex = polygonVertices[chain.vertexIndex];
+            size_t nextIndex = (chain.vertexIndex + chain.stepForward) % vertexCount;
+            const Point2D& toVertex = polygonVertices[nextIndex];
+            
+            if (toVertex.coordinateY < fromVertex.coordinateY) {
+                return false;
+            }
             
-            if (activeEdgeTable.empty() && currentScanLine >= edgeTable.size()) {
+            // Vértices já percorridos têm y <= scanLine; arestas horizontais são puladas
+            if (toVertex.coordinateY > scanLine) {
+                chain.edge = makeFixedEdge(fromVertex.coordinateX, fromVertex.coordinateY,
+                                           toVertex.coordinateX, toVertex.coordinateY, scanLine);
+                return true;
+            }
+            
+            chain.vertexIndex = nextIndex;
+        }
+        
+        return false;
+    }
+
+public:
+    /**
+     * @brief Preenchimento rápido de polígonos convexos (sem ET nem AET)
+     *
+     * Um polígono convexo tem em cada scanline exatamente duas arestas: uma
+     * da cadeia que desce pelo sentido dos vértices e outra da que desce pelo
+     * sentido contrário. Cada cadeia é percorrida com uma aresta inteira
+     * (mesma amostragem no centro do pixel do modo INTEGER_DDA), sem
+     * ordenação nem alocação por scanline. O resultado é idêntico ao de
+     * fillPolygon no modo INTEGER_DDA, mas não ao do modo FLOATING_POINT
+     * (outro arredondamento): quem alterna entre os dois caminhos deve
+     * consultar isConvexFastPathExact(). O chamador garante a convexidade
+     * (ver PolygonManager::isConvexPolygon).
+     * @param polygonVertices Vértices de um polígono convexo
+     * @param fillColor Cor do preenchimento
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans
+     */
+    template <typename SpanSink>
+    void fillConvexPolygon(const std::vector<Point2D>& polygonVertices, 
+                           const ColorRGB& fillColor, 
+                           int maxHeight,
+                           int maxWidth,
+                           SpanSink& spanSink) const {
+        const size_t vertexCount = polygonVertices.size();
+        if (vertexCount < 3) {
+            return;
+        }
+        
+        size_t topIndex = 0;
+        int topY = polygonVertices[0].coordinateY;
+        int bottomY = topY;
+        for (size_t vertexIndex = 1; vertexIndex < vertexCount; ++vertexIndex) {
+            int vertexY = polygonVertices[vertexIndex].coordinateY;
+            if (vertexY < topY) {
+                topY = vertexY;
+                topIndex = vertexIndex;
+            }
+            bottomY = std::max(bottomY, vertexY);
+        }
+        
+        int currentScanLine = std::max(topY, clipTop);
+        int scanLineEnd = std::min(bottomY, maxHeight);
+        if (currentScanLine >= scanLineEnd) {
+            return;
+        }
+        
+        ConvexChain forwardChain(topIndex, 1);
+        ConvexChain backwardChain(topIndex, vertexCount - 1);
+        if (!seedConvexChain(polygonVertices, forwardChain, currentScanLine) ||
+            !seedConvexChain(polygonVertices, backwardChain, currentScanLine)) {
+            return;
+        }
+        
+        while (true) {
+            int leftX = std::min(forwardChain.edge.currentX, backwardChain.edge.currentX);
+            int rightX = std::max(forwardChain.edge.currentX, backwardChain.edge.currentX);
+            int x1 = std::max(leftX, clipLeft);
+            int x2 = std::min(rightX - 1, maxWidth - 1);
+            if (x1 <= x2) {
+                spanSink.emitSpan(currentScanLine, x1, x2, fillColor);
+            }
+            
+            currentScanLine++;
+            if (currentScanLine >= scanLineEnd) {
                 break;
             }
+            
+            for (ConvexChain* chain : { &forwardChain, &backwardChain }) {
+                if (currentScanLine < chain->edge.maximumY) {
+                    chain->edge.advance();
+                } else if (!seedConvexChain(polygonVertices, *chain, currentScanLine)) {
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Insere uma aresta na AET mantendo a ordenação por currentX
+     */
+    template <typename Edge>
+    void insertActiveEdge(std::vector<Edge>& activeEdgeTable, const Edge& newEdge) const {
+        auto insertPosition = std::upper_bound(activeEdgeTable.begin(), activeEdgeTable.end(), newEdge,
+            [](const Edge& edge1, const Edge& edge2) {
+                return edge1.currentX < edge2.currentX;
+            });
+        activeEdgeTable.insert(insertPosition, newEdge);
+    }
+
+    /**
+     * @brief Reordena a AET após o passo currentX += inverseSlope
+     *
+     * A ordem só muda quando duas arestas se cruzam, então uma passada de
+     * inserção (bolha local) custa O(n) na prática, contra O(n log n) do sort.
+     */
+    template <typename Edge>
+    void restoreActiveEdgeOrder(std::vector<Edge>& activeEdgeTable) const {
+        for (size_t edgeIndex = 1; edgeIndex < activeEdgeTable.size(); ++edgeIndex) {
+            if (!(activeEdgeTable[edgeIndex].currentX < activeEdgeTable[edgeIndex - 1].currentX)) {
+                continue;
+            }
+            
+            Edge displacedEdge = activeEdgeTable[edgeIndex];
+            size_t targetIndex = edgeIndex;
+            while (targetIndex > 0 && displacedEdge.currentX < activeEdgeTable[targetIndex - 1].currentX) {
+                activeEdgeTable[targetIndex] = activeEdgeTable[targetIndex - 1];
+                targetIndex--;
+            }
+            activeEdgeTable[targetIndex] = displacedEdge;
+        }
+    }
+
+private:
+    static double activeEdgeX(const std::vector<EdgeData>& activeEdgeTable, size_t edgeIndex) {
+        return activeEdgeTable[edgeIndex].currentX;
+    }
+
+    static double activeEdgeX(const SoAActiveEdgeTable& activeEdgeTable, size_t edgeIndex) {
+        return activeEdgeTable.getCurrentX(edgeIndex);
+    }
+
+    /**
+     * @brief Arredonda x para o pixel mais próximo (floor(x + 0.5), também para x negativo)
+     */
+    static int roundToPixel(double x) {
+        double shifted = x + 0.5;
+        int truncated = static_cast<int>(shifted);
+        return (shifted < truncated) ? truncated - 1 : truncated;
+    }
+
+    static int activeEdgeWinding(const std::vector<EdgeData>& activeEdgeTable, size_t edgeIndex) {
+        return activeEdgeTable[edgeIndex].windingDirection;
+    }
+
+    static int activeEdgeWinding(const SoAActiveEdgeTable& activeEdgeTable, size_t edgeIndex) {
+        return activeEdgeTable.getWindingDirection(edgeIndex);
+    }
+
+    /**
+     * @brief Emite o span entre as arestas leftEdge e rightEdge com a cor interpolada entre elas
+     *
+     * As pontas são arredondadas como nos spans de cor sólida e recortadas em
+     * [clipLeftColumn, maxWidth - 1]; a cor de cada ponta é a da reta entre as duas arestas
+     * avaliada no pixel (ou na aresta, se o pixel ficou fora dela).
+     */
+    template <typename ShadedSpanSink>
+    static void emitShadedSpanBetween(const ShadedEdgeData& leftEdge,
+                                      const ShadedEdgeData& rightEdge,
+                                      int currentScanLine,
+                                      int clipLeftColumn,
+                                      int maxWidth,
+                                      ShadedSpanSink& spanSink) {
+        const ShadedEdgeData* startEdge = &leftEdge;
+        const ShadedEdgeData* endEdge = &rightEdge;
+        int x1 = roundToPixel(startEdge->currentX);
+        int x2 = roundToPixel(endEdge->currentX);
+        
+        if (x1 > x2) {
+            std::swap(x1, x2);
+            std::swap(startEdge, endEdge);
+        }
+        
+        if (x1 < clipLeftColumn) x1 = clipLeftColumn;
+        if (x2 >= maxWidth) x2 = maxWidth - 1;
+        if (x1 > x2) {
+            return;
+        }
+        
+        double edgeDistance = endEdge->currentX - startEdge->currentX;
+        double inverseDistance = edgeDistance != 0.0 ? 1.0 / edgeDistance : 0.0;
+        // Pesos limitados a [0, 1]: as pontas arredondadas podem cair fora das
+        // arestas e a cor extrapolada sairia da faixa entre as duas cores
+        double startWeight = std::min(1.0, std::max(0.0, (x1 - startEdge->currentX) * inverseDistance));
+        double endWeight = std::min(1.0, std::max(0.0, (x2 - startEdge->currentX) * inverseDistance));
+        double redDelta = endEdge->currentRed - startEdge->currentRed;
+        double greenDelta = endEdge->currentGreen - startEdge->currentGreen;
+        double blueDelta = endEdge->currentBlue - startEdge->currentBlue;
+        
+        spanSink.emitShadedSpan(currentScanLine, x1, x2,
+            ColorRGB(static_cast<float>(startEdge->currentRed + redDelta * startWeight),
+                     static_cast<float>(startEdge->currentGreen + greenDelta * startWeight),
+                     static_cast<float>(startEdge->currentBlue + blueDelta * startWeight)),
+            ColorRGB(static_cast<float>(startEdge->currentRed + redDelta * endWeight),
+                     static_cast<float>(startEdge->currentGreen + greenDelta * endWeight),
+                     static_cast<float>(startEdge->currentBlue + blueDelta * endWeight)));
+    }
+
+    /**
+     * @brief Versão Gouraud de emitScanLineSpans: mesmos pares de arestas, cor interpolada
+     */
+    template <typename ShadedSpanSink>
+    void emitShadedScanLineSpans(const std::vector<ShadedEdgeData>& activeEdgeTable,
+                                 int currentScanLine,
+                                 int maxWidth,
+                                 ShadedSpanSink& spanSink) const {
+        if (currentScanLine < clipTop) {
+            return;
+        }
+        
+        if (fillRule == FillRule::NONZERO) {
+            int windingNumber = 0;
+            size_t spanStartIndex = 0;
+            for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size(); ++edgeIndex) {
+                int previousWinding = windingNumber;
+                windingNumber += activeEdgeTable[edgeIndex].windingDirection;
+                
+                if (previousWinding == 0 && windingNumber != 0) {
+                    spanStartIndex = edgeIndex;
+                } else if (previousWinding != 0 && windingNumber == 0) {
+                    emitShadedSpanBetween(activeEdgeTable[spanStartIndex], activeEdgeTable[edgeIndex], 
+                                          currentScanLine, clipLeft, maxWidth, spanSink);
+                }
+            }
+            return;
+        }
+        
+        for (size_t edgeIndex = 0; edgeIndex + 1 < activeEdgeTable.size(); edgeIndex += 2) {
+            emitShadedSpanBetween(activeEdgeTable[edgeIndex], activeEdgeTable[edgeIndex + 1], 
+                                  currentScanLine, clipLeft, maxWidth, spanSink);
+        }
+        
+        if (activeEdgeTable.size() % 2 == 1) {
+            const ShadedEdgeData& lastEdge = activeEdgeTable.back();
+            emitShadedSpanBetween(lastEdge, lastEdge, currentScanLine, clipLeft, maxWidth, spanSink);
+        }
+    }
+
+    /**
+     * @brief Emite os spans de uma scanline pela regra NONZERO
+     *
+     * Percorre a AET acumulando as direções; um span vai da aresta em que o
+     * winding deixa zero até a aresta em que ele volta a zero.
+     */
+    template <typename ActiveEdges, typename SpanSink>
+    void emitNonZeroScanLineSpans(const ActiveEdges& activeEdgeTable,
+                                  int currentScanLine,
+                                  const ColorRGB& fillColor,
+                                  int maxWidth,
+                                  SpanSink& spanSink) const {
+        int windingNumber = 0;
+        int spanStartX = 0;
+        
+        for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size(); ++edgeIndex) {
+            int previousWinding = windingNumber;
+            windingNumber += activeEdgeWinding(activeEdgeTable, edgeIndex);
+            
+            if (previousWinding == 0 && windingNumber != 0) {
+                spanStartX = roundToPixel(activeEdgeX(activeEdgeTable, edgeIndex));
+            } else if (previousWinding != 0 && windingNumber == 0) {
+                int x1 = spanStartX;
+                int x2 = roundToPixel(activeEdgeX(activeEdgeTable, edgeIndex));
+                
+                if (x1 < clipLeft) x1 = clipLeft;
+                if (x2 >= maxWidth) x2 = maxWidth - 1;
+                
+                if (x1 <= x2) {
+                    spanSink.emitSpan(currentScanLine, x1, x2, fillColor);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Emite os spans de uma scanline a partir da AET já ordenada
+     *
+     * Os pares de arestas viram spans [x1, x2]; se sobrar uma aresta (contagem
+     * ímpar), ela é emitida como um span de um único pixel. Com FillRule::NONZERO
+     * delega para emitNonZeroScanLineSpans.
+     */
+    template <typename ActiveEdges, typename SpanSink>
+    void emitScanLineSpans(const ActiveEdges& activeEdgeTable,
+                           int currentScanLine,
+                           const ColorRGB& fillColor,
+                           int maxHeight,
+                           int maxWidth,
+                           SpanSink& spanSink) const {
+        if (currentScanLine < clipTop || currentScanLine >= maxHeight) {
+            return;
+        }
+        
+        if (fillRule == FillRule::NONZERO) {
+            emitNonZeroScanLineSpans(activeEdgeTable, currentScanLine, fillColor, maxWidth, spanSink);
+            return;
+        }
+        
+        for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size() - 1; edgeIndex += 2) {
+            int x1 = roundToPixel(activeEdgeX(activeEdgeTable, edgeIndex));
+            int x2 = roundToPixel(activeEdgeX(activeEdgeTable, edgeIndex + 1));
+            
+            if (x1 > x2) {
+                std::swap(x1, x2);
+            }
+            
+            // Clamping
+            if (x1 < clipLeft) x1 = clipLeft;
+            if (x2 >= maxWidth) x2 = maxWidth - 1;
+            
+            if (x1 <= x2) {
+                spanSink.emitSpan(currentScanLine, x1, x2, fillColor);
+            }
+        }
+        
+        if (activeEdgeTable.size() % 2 == 1) {
+            int x = roundToPixel(activeEdgeX(activeEdgeTable, activeEdgeTable.size() - 1));
+            if (x >= clipLeft && x < maxWidth) {
+                spanSink.emitSpan(currentScanLine, x, x, fillColor);
+            }
         }
     }
 };
@@ -9,6 +9,11 @@
 #define POLYGON_MANAGER_H
 
 #include "data_structures.h"
+#include "polygon_boolean.h"
+#include "self_intersection.h"
+#include "polygon_simplification.h"
+#include <cmath>
+#include <memory>
 #include <vector>
 
 /**
@@ -19,6 +24,8 @@ class PolygonManager {
 private:
     std::vector<Point2D> polygonVertices;
     bool isPolygonClosed;
+    std::vector<SelfIntersection> selfIntersections;    // Calculadas ao fechar o polígono
+    SelfIntersectionSweep intersectionSweep;
     PolygonConfiguration visualConfiguration;
 
 public:
@@ -26,19 +33,177 @@ public:
         std::vector<Point2D> vertices;
         PolygonConfiguration configuration;
         bool isFilled;
+        bool isConvex;             // Permite o preenchimento rápido de duas cadeias
+        unsigned int polygonId;    // Identidade estável, usada como chave de caches
+        std::shared_ptr<PolygonLevelsOfDetail> levelsOfDetail;    // Compartilhado pelas cópias (mesmos vértices)
+        std::vector<SubpixelPoint2D> subpixelVertices;    // Geometria importada em 24.8; vazio se vertices já é exato
+        std::vector<std::vector<Point2D> > outlineContours;    // Contornos reais quando vertices liga buracos por pontes; vazio se vertices já é o contorno
+        std::shared_ptr<std::vector<PolygonLevelsOfDetail> > outlineLevelsOfDetail;    // Um por contorno de outlineContours
         
         SavedPolygon(const std::vector<Point2D>& verts, const PolygonConfiguration& config, bool filled)
-            : vertices(verts), configuration(config), isFilled(filled) {}
+            : vertices(verts), configuration(config), isFilled(filled), 
+              isConvex(isConvexPolygon(verts)), polygonId(allocatePolygonId()),
+              levelsOfDetail(std::make_shared<PolygonLevelsOfDetail>()) {}
+
+        bool hasSubpixelGeometry() const {
+            return !subpixelVertices.empty();
+        }
+
+        /**
+         * @brief Vértices simplificados para desenho com tolerância de até tolerancePixels (vertices fica intacto)
+         */
+        const std::vector<Point2D>& getSimplifiedVertices(SimplificationMethod method, double tolerancePixels) const {
+            return levelsOfDetail->getLevel(vertices, method, tolerancePixels);
+        }
+
+        /**
+         * @brief Guarda o contorno externo e os buracos separados, para o desenho não mostrar as pontes de vertices
+         */
+        void setOutlineContours(const std::vector<std::vector<Point2D> >& contours) {
+            outlineContours = contours;
+            outlineLevelsOfDetail = std::make_shared<std::vector<PolygonLevelsOfDetail> >(contours.size());
+        }
+
+        /**
+         * @brief Número de linhas fechadas do contorno desenhado (1 se não há buracos)
+         */
+        size_t getOutlineCount() const {
+            return outlineContours.empty() ? 1 : outlineContours.size();
+        }
+
+        /**
+         * @brief Contorno outlineIndex simplificado com tolerância de até tolerancePixels, sem pontes
+         */
+        const std::vector<Point2D>& getSimplifiedOutline(size_t outlineIndex, SimplificationMethod method,
+                                                         double tolerancePixels) const {
+            if (outlineContours.empty()) {
+                return getSimplifiedVertices(method, tolerancePixels);
+            }
+            return (*outlineLevelsOfDetail)[outlineIndex].getLevel(outlineContours[outlineIndex], method, tolerancePixels);
+        }
+
+    private:
+        static unsigned int allocatePolygonId() {
+            static unsigned int nextPolygonId = 0;
+            return ++nextPolygonId;
+        }
     };
     
 private:
     std::vector<SavedPolygon> savedPolygons;
+    int selectedPolygonIndex;    // Polígono salvo selecionado, -1 se nenhum
+
+    /**
+     * @brief Salva os vértices como um polígono ou como as peças simples da sua região par-ímpar
+     */
+    size_t addSavedPolygon(const std::vector<Point2D>& vertices, const PolygonConfiguration& configuration,
+                           bool isFilled, bool splitIntoSimplePieces) {
+        if (!splitIntoSimplePieces) {
+            savedPolygons.push_back(SavedPolygon(vertices, configuration, isFilled));
+            return 1;
+        }
+        // Mesmas peças de SelfIntersectionSweep::splitIntoSimplePieces, com os contornos guardados
+        PolygonBooleanSweep booleanSweep;
+        std::vector<BooleanContour> contours;
+        booleanSweep.computeContours(vertices, std::vector<Point2D>(), BooleanOperation::UNION, contours);
+        std::vector<SavedPolygon> pieces;
+        appendRegions(contours, configuration, isFilled, pieces);
+        savedPolygons.insert(savedPolygons.end(), pieces.begin(), pieces.end());
+        return pieces.size();
+    }
+
+    /**
+     * @brief Acrescenta um SavedPolygon por região dos contornos de uma operação booleana
+     *
+     * O polígono preenchido é o anel com pontes de
+     * PolygonBooleanSweep::mergeHolesIntoRings; regiões com buracos guardam
+     * também os contornos separados, que são os desenhados.
+     */
+    static void appendRegions(const std::vector<BooleanContour>& contours, const PolygonConfiguration& configuration,
+                              bool isFilled, std::vector<SavedPolygon>& regions) {
+        std::vector<std::vector<size_t> > ringContours;
+        std::vector<std::vector<Point2D> > rings = PolygonBooleanSweep::mergeHolesIntoRings(contours, &ringContours);
+        for (size_t ringIndex = 0; ringIndex < rings.size(); ++ringIndex) {
+            if (rings[ringIndex].size() < 3) {
+                continue;
+            }
+            regions.push_back(SavedPolygon(rings[ringIndex], configuration, isFilled));
+            if (ringContours[ringIndex].size() > 1) {
+                std::vector<std::vector<Point2D> > outline;
+                for (size_t contourIndex : ringContours[ringIndex]) {
+                    outline.push_back(contours[contourIndex].vertices);
+                }
+                regions.back().setOutlineContours(outline);
+            }
+        }
+    }
 
 public:
     /**
      * @brief Construtor da classe PolygonManager
      */
-    PolygonManager() : isPolygonClosed(false) {}
+    PolygonManager() : isPolygonClosed(false), selectedPolygonIndex(-1) {}
+
+    /**
+     * @brief Verifica se o polígono (fechado implicitamente) é convexo
+     *
+     * Todas as curvas entre arestas consecutivas têm o mesmo sentido (curvas
+     * nulas são ignoradas) e a direção vertical inverte no máximo duas vezes,
+     * o que exclui polígonos estrelados que dão mais de uma volta. Polígonos
+     * degenerados (colineares) contam como convexos.
+     * @param vertices Vértices do polígono
+     * @return true se o polígono é convexo
+     */
+    static bool isConvexPolygon(const std::vector<Point2D>& vertices) {
+        const size_t vertexCount = vertices.size();
+        if (vertexCount < 3) {
+            return false;
+        }
+        
+        int turnSign = 0;
+        int verticalReversals = 0;
+        int previousVerticalDirection = 0;
+        int firstVerticalDirection = 0;
+        
+        for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+            const Point2D& currentVertex = vertices[vertexIndex];
+            const Point2D& nextVertex = vertices[(vertexIndex + 1) % vertexCount];
+            const Point2D& followingVertex = vertices[(vertexIndex + 2) % vertexCount];
+            
+            long long crossProduct = 
+                static_cast<long long>(nextVertex.coordinateX - currentVertex.coordinateX) * 
+                (followingVertex.coordinateY - nextVertex.coordinateY) -
+                static_cast<long long>(nextVertex.coordinateY - currentVertex.coordinateY) * 
+                (followingVertex.coordinateX - nextVertex.coordinateX);
+            
+            if (crossProduct != 0) {
+                int currentSign = (crossProduct > 0) ? 1 : -1;
+                if (turnSign == 0) {
+                    turnSign = currentSign;
+                } else if (currentSign != turnSign) {
+                    return false;
+                }
+            }
+            
+            int deltaY = nextVertex.coordinateY - currentVertex.coordinateY;
+            if (deltaY != 0) {
+                int verticalDirection = (deltaY > 0) ? 1 : -1;
+                if (previousVerticalDirection == 0) {
+                    firstVerticalDirection = verticalDirection;
+                } else if (verticalDirection != previousVerticalDirection) {
+                    verticalReversals++;
+                }
+                previousVerticalDirection = verticalDirection;
+            }
+        }
+        
+        // Fecha o ciclo: a última direção volta para a primeira
+        if (previousVerticalDirection != 0 && previousVerticalDirection != firstVerticalDirection) {
+            verticalReversals++;
+        }
+        
+        return verticalReversals <= 2;
+    }
 
     /**
      * @brief Adiciona um novo vértice ao polígono
@@ -47,6 +212,7 @@ public:
     void addVertex(const Point2D& newVertex) {
         polygonVertices.push_back(newVertex);
         isPolygonClosed = false;
+        selfIntersections.clear();
     }
 
     /**
@@ -56,15 +222,20 @@ public:
         if (!polygonVertices.empty()) {
             polygonVertices.pop_back();
             isPolygonClosed = false;
+            selfIntersections.clear();
         }
     }
 
     /**
      * @brief Fecha o polígono conectando o último vértice ao primeiro
+     *
+     * Também procura autointerseções (Bentley-Ottmann, O((n + k) log n));
+     * os pontos ficam em getSelfIntersections().
      */
     void closePolygon() {
         if (polygonVertices.size() >= 3) {
             isPolygonClosed = true;
+            intersectionSweep.findIntersections(polygonVertices, selfIntersections);
         }
     }
 
@@ -74,6 +245,7 @@ public:
     void clearPolygon() {
         polygonVertices.clear();
         isPolygonClosed = false;
+        selfIntersections.clear();
     }
 
     /**
@@ -84,6 +256,21 @@ public:
         return isPolygonClosed;
     }
 
+    /**
+     * @brief Indica se o polígono fechado não tem autointerseções (calculado em closePolygon)
+     */
+    bool isPolygonCurrentlySimple() const {
+        return isPolygonClosed && selfIntersections.empty();
+    }
+
+    /**
+     * @brief Pontos onde arestas do polígono fechado se cruzam ou se tocam
+     * @return Vazio se o polígono está aberto ou é simples
+     */
+    const std::vector<SelfIntersection>& getSelfIntersections() const {
+        return selfIntersections;
+    }
+
     /**
      * @brief Retorna o número de vértices do polígono
      * @return Número de vértices
@@ -123,9 +310,20 @@ public:
      * @param redComponent Componente vermelho (0.0 - 1.0)
      * @param greenComponent Componente verde (0.0 - 1.0)
      * @param blueComponent Componente azul (0.0 - 1.0)
+     *
+     * A opacidade atual do preenchimento é mantida.
      */
     void setFillColor(float redComponent, float greenComponent, float blueComponent) {
-        visualConfiguration.fillColor = ColorRGB(redComponent, greenComponent, blueComponent);
+        visualConfiguration.fillColor = ColorRGB(redComponent, greenComponent, blueComponent,
+                                                 visualConfiguration.getFillOpacity());
+    }
+
+    /**
+     * @brief Define a opacidade do preenchimento do polígono
+     * @param opacity Opacidade (0.0 = transparente, 1.0 = opaco); fora do intervalo é limitada
+     */
+    void setFillOpacity(float opacity) {
+        visualConfiguration.setFillOpacity(opacity);
     }
 
     /**
@@ -163,6 +361,8 @@ public:
     /**
      * @brief Aplica uma cor predefinida ao preenchimento
      * @param colorIndex Índice da cor (1-6)
+     *
+     * Com um polígono salvo selecionado, ele também recebe a nova cor.
      */
     void applyPresetFillColor(int colorIndex) {
         switch (colorIndex) {
@@ -185,7 +385,11 @@ public:
                 setFillColor(0.0f, 1.0f, 1.0f);
                 break;
             default:
-                break;
+                return;
+        }
+        
+        if (selectedPolygonIndex >= 0) {
+            savedPolygons[selectedPolygonIndex].configuration.fillColor = visualConfiguration.fillColor;
         }
     }
 
@@ -201,6 +405,16 @@ public:
         }
     }
 
+    /**
+     * @brief Ajusta a opacidade do preenchimento em passos de 10%
+     * @param increase true para aumentar, false para diminuir
+     */
+    void adjustFillOpacity(bool increase) {
+        float opacity = visualConfiguration.getFillOpacity() + (increase ? 0.1f : -0.1f);
+        // Arredonda para o passo mais próximo para não acumular erro de ponto flutuante
+        setFillOpacity(std::round(opacity * 10.0f) / 10.0f);
+    }
+
     /**
      * @brief Alterna a visibilidade dos vértices
      */
@@ -218,6 +432,74 @@ public:
         }
     }
 
+    /**
+     * @brief Salva o polígono atual dividido em peças sem autointerseções
+     * @param isFilled Indica se o polígono foi preenchido
+     * @return Número de polígonos salvos
+     *
+     * As peças cobrem a mesma região que o preenchimento par-ímpar do
+     * polígono original; um polígono simples é salvo sem alterações.
+     */
+    size_t saveCurrentPolygonAsSimplePieces(bool isFilled = false) {
+        if (polygonVertices.size() < 3 || !isPolygonClosed) {
+            return 0;
+        }
+        return addSavedPolygon(polygonVertices, visualConfiguration, isFilled, !selfIntersections.empty());
+    }
+
+    /**
+     * @brief Importa um polígono pronto como polígono salvo, verificando autointerseções
+     * @param importedVertices Vértices do polígono (fechado implicitamente)
+     * @param isFilled Indica se o polígono deve ser preenchido
+     * @param splitIntoSimplePieces Divide polígonos com autointerseções em peças simples
+     * @param intersections Se não for nulo, recebe as autointerseções encontradas
+     * @return Número de polígonos salvos
+     */
+    size_t importPolygon(const std::vector<Point2D>& importedVertices, bool isFilled, bool splitIntoSimplePieces,
+                         std::vector<SelfIntersection>* intersections = nullptr) {
+        if (importedVertices.size() < 3) {
+            return 0;
+        }
+        std::vector<SelfIntersection> foundIntersections;
+        bool isSimple = intersectionSweep.findIntersections(importedVertices, foundIntersections);
+        if (intersections) {
+            intersections->swap(foundIntersections);
+        }
+        return addSavedPolygon(importedVertices, visualConfiguration, isFilled, splitIntoSimplePieces && !isSimple);
+    }
+
+    /**
+     * @brief Importa um polígono com vértices em ponto fixo 24.8, sem arredondá-los para o pixel
+     * @param importedVertices Vértices do polígono em 1/256 de pixel (fechado implicitamente)
+     * @param isFilled Indica se o polígono deve ser preenchido
+     * @param intersections Se não for nulo, recebe as autointerseções encontradas
+     * @return Número de polígonos salvos (0 ou 1)
+     *
+     * O preenchimento usa os vértices 24.8; contorno, seleção, operações
+     * booleanas e níveis de detalhe usam os vértices arredondados para o
+     * pixel mais próximo, nos quais também é feita a verificação de
+     * autointerseções.
+     */
+    size_t importSubpixelPolygon(const std::vector<SubpixelPoint2D>& importedVertices, bool isFilled,
+                                 std::vector<SelfIntersection>* intersections = nullptr) {
+        if (importedVertices.size() < 3) {
+            return 0;
+        }
+        std::vector<Point2D> roundedVertices;
+        roundedVertices.reserve(importedVertices.size());
+        for (const SubpixelPoint2D& vertex : importedVertices) {
+            roundedVertices.push_back(vertex.toNearestPixel());
+        }
+        std::vector<SelfIntersection> foundIntersections;
+        intersectionSweep.findIntersections(roundedVertices, foundIntersections);
+        if (intersections) {
+            intersections->swap(foundIntersections);
+        }
+        savedPolygons.push_back(SavedPolygon(roundedVertices, visualConfiguration, isFilled));
+        savedPolygons.back().subpixelVertices = importedVertices;
+        return 1;
+    }
+
     /**
      * @brief Retorna uma referência constante aos polígonos salvos
      * @return Referência constante ao vetor de polígonos salvos
@@ -231,11 +513,63 @@ public:
      */
     void clearSavedPolygons() {
         savedPolygons.clear();
+        selectedPolygonIndex = -1;
+    }
+
+    /**
+     * @brief Seleciona o polígono salvo na posição indicada (-1 ou índice inválido limpa a seleção)
+     *
+     * O índice vem normalmente de GraphicsRenderer::findSavedPolygonAt.
+     */
+    void selectSavedPolygon(int polygonIndex) {
+        bool isValid = polygonIndex >= 0 && static_cast<size_t>(polygonIndex) < savedPolygons.size();
+        selectedPolygonIndex = isValid ? polygonIndex : -1;
+    }
+
+    int getSelectedPolygonIndex() const {
+        return selectedPolygonIndex;
     }
 
     size_t getSavedPolygonCount() const {
         return savedPolygons.size();
     }
+
+    /**
+     * @brief Substitui dois polígonos salvos pelo resultado de uma operação booleana entre eles
+     * @param subjectIndex Índice do polígono A
+     * @param clippingIndex Índice do polígono B
+     * @param booleanOperation A op B (DIFFERENCE é A - B)
+     * @return Número de polígonos criados (0 se o resultado é vazio ou os índices são inválidos)
+     *
+     * Cada região do resultado vira um SavedPolygon com a configuração e o
+     * estado de preenchimento de A; buracos ficam ligados ao contorno externo
+     * por pontes no preenchimento, mas o contorno desenhado é o dos contornos
+     * separados. Os novos polígonos ocupam a posição do menor índice.
+     */
+    size_t combineSavedPolygons(size_t subjectIndex, size_t clippingIndex, BooleanOperation booleanOperation) {
+        if (subjectIndex == clippingIndex || subjectIndex >= savedPolygons.size() ||
+            clippingIndex >= savedPolygons.size()) {
+            return 0;
+        }
+        
+        PolygonBooleanSweep booleanSweep;
+        std::vector<BooleanContour> contours;
+        booleanSweep.computeContours(savedPolygons[subjectIndex].vertices, savedPolygons[clippingIndex].vertices,
+                                     booleanOperation, contours);
+        
+        const PolygonConfiguration configuration = savedPolygons[subjectIndex].configuration;
+        const bool isFilled = savedPolygons[subjectIndex].isFilled;
+        const size_t insertIndex = std::min(subjectIndex, clippingIndex);
+        
+        savedPolygons.erase(savedPolygons.begin() + std::max(subjectIndex, clippingIndex));
+        savedPolygons.erase(savedPolygons.begin() + insertIndex);
+        selectedPolygonIndex = -1;
+        
+        std::vector<SavedPolygon> results;
+        appendRegions(contours, configuration, isFilled, results);
+        savedPolygons.insert(savedPolygons.begin() + insertIndex, results.begin(), results.end());
+        return results.size();
+    }
 };
 
 #endif // POLYGON_MANAGER_H
\ No newline at end of file
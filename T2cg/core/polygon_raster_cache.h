@@ -0,0 +1,250 @@
+/**
+ * @file polygon_raster_cache.h
+ * @brief Cache dos spans já convertidos de cada polígono salvo
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef POLYGON_RASTER_CACHE_H
+#define POLYGON_RASTER_CACHE_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "polygon_manager.h"
+#include "gl_span_batcher.h"
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct CachedSpan
+ * @brief Run horizontal [startX, endX] de uma scanline
+ */
+struct CachedSpan {
+    int scanLine;
+    int startX;
+    int endX;    // Inclusivo
+};
+
+/**
+ * @class PolygonRasterCache
+ * @brief Guarda os spans de cada polígono salvo e os reemite sem refazer ET/AET
+ *
+ * Polígonos salvos não mudam depois de salvos, então a conversão por
+ * scanlines só precisa ser refeita quando a janela muda de tamanho ou
+ * quando o polígono passa a ser preenchido. As entradas são indexadas por
+ * polygonId, então remover ou reordenar polígonos não refaz os demais, e a
+ * cor fica fora da chave: trocá-la só recolore os vértices guardados.
+ * Alterações nos modos do PolygonFillAlgorithm exigem invalidate().
+ *
+ * Para o GLSpanBatcher cada entrada guarda também o vertex array já montado,
+ * e o quadro copia esses arrays para o lote em vez de reemitir os spans.
+ */
+class PolygonRasterCache {
+private:
+    struct CacheEntry {
+        bool isFilled;
+        ColorRGB fillColor;
+        std::vector<CachedSpan> spans;
+        std::vector<SpanBatchVertex> batchVertices;    // Montado no primeiro quadro em GL; esvaziado ao recolorir
+        size_t lastRenderPass;
+
+        CacheEntry() : isFilled(false), lastRenderPass(0) {}
+    };
+
+    /**
+     * @brief Destino de spans que apenas grava no vetor da entrada
+     */
+    struct RecordingSpanSink {
+        std::vector<CachedSpan>* spans;
+
+        void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+            CachedSpan span = { scanLine, startX, endX };
+            spans->push_back(span);
+        }
+    };
+
+    std::unordered_map<unsigned int, CacheEntry> entries;    // Por polygonId
+    int cachedHeight;
+    int cachedWidth;
+    size_t rebuildCount;
+    size_t renderPass;
+    SimplificationMethod simplificationMethod;
+    double simplificationTolerance;    // Pixels; 0 preenche os vértices originais
+
+    void rebuildEntry(CacheEntry& entry, 
+                      const PolygonManager::SavedPolygon& savedPolygon,
+                      const PolygonFillAlgorithm& fillAlgorithm) {
+        entry.isFilled = savedPolygon.isFilled;
+        entry.fillColor = savedPolygon.configuration.fillColor;
+        entry.spans.clear();
+        entry.batchVertices.clear();
+        
+        const std::vector<Point2D>& fillVertices = 
+            savedPolygon.getSimplifiedVertices(simplificationMethod, simplificationTolerance);
+        if (savedPolygon.isFilled && fillVertices.size() >= 3) {
+            RecordingSpanSink recordingSink;
+            recordingSink.spans = &entry.spans;
+            // Preenchimento exato usa a geometria 24.8; com tolerância o nível de detalhe já é aproximado
+            if (savedPolygon.hasSubpixelGeometry() && simplificationTolerance <= 0.0) {
+                fillAlgorithm.fillPolygon(savedPolygon.subpixelVertices, entry.fillColor, 
+                                          cachedHeight, cachedWidth, recordingSink);
+            } else if (savedPolygon.isConvex && fillAlgorithm.isConvexFastPathExact()) {
+                // Subconjunto dos vértices de um polígono convexo continua convexo
+                fillAlgorithm.fillConvexPolygon(fillVertices, entry.fillColor, 
+                                                cachedHeight, cachedWidth, recordingSink);
+            } else {
+                fillAlgorithm.fillPolygon(fillVertices, entry.fillColor, 
+                                          cachedHeight, cachedWidth, recordingSink);
+            }
+            entry.spans.shrink_to_fit();
+        }
+        
+        rebuildCount++;
+    }
+
+    /**
+     * @brief Atualiza a entrada de cada polígono salvo e chama visit(entrada) na ordem de pintura
+     *
+     * Entradas de polígonos que saíram da lista são descartadas.
+     */
+    template <typename Visitor>
+    void forEachCurrentEntry(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                             const PolygonFillAlgorithm& fillAlgorithm,
+                             int maxHeight,
+                             int maxWidth,
+                             Visitor&& visit) {
+        if (maxHeight != cachedHeight || maxWidth != cachedWidth) {
+            invalidate();
+            cachedHeight = maxHeight;
+            cachedWidth = maxWidth;
+        }
+        
+        ++renderPass;
+        for (const PolygonManager::SavedPolygon& savedPolygon : savedPolygons) {
+            auto insertion = entries.emplace(savedPolygon.polygonId, CacheEntry());
+            CacheEntry& entry = insertion.first->second;
+            if (insertion.second || entry.isFilled != savedPolygon.isFilled) {
+                rebuildEntry(entry, savedPolygon, fillAlgorithm);
+            } else if (entry.fillColor != savedPolygon.configuration.fillColor) {
+                entry.fillColor = savedPolygon.configuration.fillColor;
+                entry.batchVertices.clear();
+            }
+            entry.lastRenderPass = renderPass;
+            
+            visit(entry);
+        }
+        
+        if (entries.size() > savedPolygons.size()) {
+            for (auto entryIterator = entries.begin(); entryIterator != entries.end();) {
+                entryIterator = (entryIterator->second.lastRenderPass != renderPass) ? entries.erase(entryIterator)
+                                                                                      : std::next(entryIterator);
+            }
+        }
+    }
+
+    /**
+     * @brief Monta o vertex array GL_LINES da entrada a partir dos spans, na cor atual
+     */
+    static void buildBatchVertices(CacheEntry& entry) {
+        SpanBatchVertex vertex = { GLVertexBatch::toColorByte(entry.fillColor.redComponent),
+                                   GLVertexBatch::toColorByte(entry.fillColor.greenComponent),
+                                   GLVertexBatch::toColorByte(entry.fillColor.blueComponent),
+                                   GLVertexBatch::toColorByte(entry.fillColor.alphaComponent), 0.0f, 0.0f };
+        entry.batchVertices.clear();
+        entry.batchVertices.reserve(2 * entry.spans.size());
+        for (const CachedSpan& span : entry.spans) {
+            vertex.coordinateX = static_cast<GLfloat>(span.startX);
+            vertex.coordinateY = static_cast<GLfloat>(span.scanLine);
+            entry.batchVertices.push_back(vertex);
+            vertex.coordinateX = static_cast<GLfloat>(span.endX + 1);
+            entry.batchVertices.push_back(vertex);
+        }
+    }
+
+public:
+    PolygonRasterCache() 
+        : cachedHeight(-1), cachedWidth(-1), rebuildCount(0), renderPass(0),
+          simplificationMethod(SimplificationMethod::DOUGLAS_PEUCKER), simplificationTolerance(0.0) {}
+
+    /**
+     * @brief Preenche cada polígono pelo nível de detalhe da tolerância (0 = vértices originais)
+     *
+     * Com tolerância abaixo de meio pixel os spans mudam pouco e a conversão
+     * de contornos densos passa a depender do tamanho na tela, não do número
+     * de vértices. Descarta o cache se algo mudou.
+     */
+    void setSimplification(SimplificationMethod method, double tolerancePixels) {
+        if (method != simplificationMethod || tolerancePixels != simplificationTolerance) {
+            simplificationMethod = method;
+            simplificationTolerance = tolerancePixels;
+            invalidate();
+        }
+    }
+
+    /**
+     * @brief Descarta todos os spans guardados (ex.: reshape da janela)
+     */
+    void invalidate() {
+        entries.clear();
+        cachedHeight = -1;
+        cachedWidth = -1;
+    }
+
+    /**
+     * @brief Número de conversões por scanlines feitas desde a criação do cache
+     */
+    size_t getRebuildCount() const {
+        return rebuildCount;
+    }
+
+    /**
+     * @brief Total de spans guardados
+     */
+    size_t getCachedSpanCount() const {
+        size_t spanCount = 0;
+        for (const auto& idAndEntry : entries) {
+            spanCount += idAndEntry.second.spans.size();
+        }
+        return spanCount;
+    }
+
+    /**
+     * @brief Reemite os spans dos polígonos salvos, convertendo apenas os que mudaram
+     * @param savedPolygons Polígonos salvos, em ordem de pintura
+     * @param fillAlgorithm Algoritmo usado para converter entradas desatualizadas
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans
+     */
+    template <typename SpanSink>
+    void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                             const PolygonFillAlgorithm& fillAlgorithm,
+                             int maxHeight,
+                             int maxWidth,
+                             SpanSink& spanSink) {
+        forEachCurrentEntry(savedPolygons, fillAlgorithm, maxHeight, maxWidth, [&](const CacheEntry& entry) {
+            for (const CachedSpan& span : entry.spans) {
+                spanSink.emitSpan(span.scanLine, span.startX, span.endX, entry.fillColor);
+            }
+        });
+    }
+
+    /**
+     * @brief Copia para o lote o vertex array guardado de cada polígono (montado uma vez por cor)
+     */
+    void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                             const PolygonFillAlgorithm& fillAlgorithm,
+                             int maxHeight,
+                             int maxWidth,
+                             GLSpanBatcher& spanBatcher) {
+        forEachCurrentEntry(savedPolygons, fillAlgorithm, maxHeight, maxWidth, [&](CacheEntry& entry) {
+            if (entry.batchVertices.size() != 2 * entry.spans.size()) {
+                buildBatchVertices(entry);
+            }
+            spanBatcher.appendVertices(entry.batchVertices);
+        });
+    }
+};
+
+#endif // POLYGON_RASTER_CACHE_H
@@ -0,0 +1,331 @@
+/**
+ * @file polygon_simplification.h
+ * @brief Simplificação de polígonos (Douglas-Peucker e Visvalingam-Whyatt) em níveis de detalhe
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef POLYGON_SIMPLIFICATION_H
+#define POLYGON_SIMPLIFICATION_H
+
+#include "data_structures.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <vector>
+
+/**
+ * @class PolygonSimplifier
+ * @brief Ordena os vértices de um polígono fechado por importância
+ *
+ * Os dois algoritmos atribuem a cada vértice o maior limiar em que ele
+ * ainda sobrevive, então a simplificação com qualquer tolerância é só um
+ * filtro O(n) sobre as importâncias (os níveis ficam aninhados). Os três
+ * vértices mais importantes recebem importância infinita para que todo
+ * nível continue sendo um polígono.
+ */
+class PolygonSimplifier {
+private:
+    static double squaredSegmentDistance(const Point2D& point, const Point2D& segmentStart, const Point2D& segmentEnd) {
+        double deltaX = static_cast<double>(segmentEnd.coordinateX) - segmentStart.coordinateX;
+        double deltaY = static_cast<double>(segmentEnd.coordinateY) - segmentStart.coordinateY;
+        double offsetX = static_cast<double>(point.coordinateX) - segmentStart.coordinateX;
+        double offsetY = static_cast<double>(point.coordinateY) - segmentStart.coordinateY;
+        double squaredLength = deltaX * deltaX + deltaY * deltaY;
+        if (squaredLength > 0.0) {
+            double t = std::max(0.0, std::min(1.0, (offsetX * deltaX + offsetY * deltaY) / squaredLength));
+            offsetX -= t * deltaX;
+            offsetY -= t * deltaY;
+        }
+        return offsetX * offsetX + offsetY * offsetY;
+    }
+
+    static double triangleArea(const Point2D& p0, const Point2D& p1, const Point2D& p2) {
+        double cross = (static_cast<double>(p1.coordinateX) - p0.coordinateX) * (static_cast<double>(p2.coordinateY) - p0.coordinateY) -
+                       (static_cast<double>(p1.coordinateY) - p0.coordinateY) * (static_cast<double>(p2.coordinateX) - p0.coordinateX);
+        return 0.5 * std::fabs(cross);
+    }
+
+    /**
+     * @brief Garante pelo menos três vértices com importância infinita
+     */
+    static void keepTriangle(std::vector<double>& importance) {
+        const double infinity = std::numeric_limits<double>::infinity();
+        size_t infiniteCount = static_cast<size_t>(std::count(importance.begin(), importance.end(), infinity));
+        while (infiniteCount < 3 && infiniteCount < importance.size()) {
+            size_t bestIndex = importance.size();
+            for (size_t vertexIndex = 0; vertexIndex < importance.size(); ++vertexIndex) {
+                if (importance[vertexIndex] != infinity &&
+                    (bestIndex == importance.size() || importance[vertexIndex] > importance[bestIndex])) {
+                    bestIndex = vertexIndex;
+                }
+            }
+            importance[bestIndex] = infinity;
+            ++infiniteCount;
+        }
+    }
+
+public:
+    /**
+     * @brief Importância de Douglas-Peucker: distância do vértice ao segmento que ele divide
+     * @param importance Uma entrada por vértice (substituída)
+     *
+     * O anel é aberto no vértice 0 e no vértice mais distante dele; a
+     * recursão usa uma pilha explícita (contornos com 10^5 vértices). A
+     * importância de um vértice é limitada pela do vértice que o dividiu,
+     * como na recursão, que só desce se o pai passou na tolerância.
+     */
+    static void computeDouglasPeuckerImportance(const std::vector<Point2D>& polygonVertices,
+                                                std::vector<double>& importance) {
+        const size_t vertexCount = polygonVertices.size();
+        const double infinity = std::numeric_limits<double>::infinity();
+        importance.assign(vertexCount, 0.0);
+        if (vertexCount <= 3) {
+            std::fill(importance.begin(), importance.end(), infinity);
+            return;
+        }
+
+        size_t farthestIndex = 0;
+        double farthestDistance = -1.0;
+        for (size_t vertexIndex = 1; vertexIndex < vertexCount; ++vertexIndex) {
+            double deltaX = static_cast<double>(polygonVertices[vertexIndex].coordinateX) - polygonVertices[0].coordinateX;
+            double deltaY = static_cast<double>(polygonVertices[vertexIndex].coordinateY) - polygonVertices[0].coordinateY;
+            if (deltaX * deltaX + deltaY * deltaY > farthestDistance) {
+                farthestDistance = deltaX * deltaX + deltaY * deltaY;
+                farthestIndex = vertexIndex;
+            }
+        }
+        importance[0] = infinity;
+        importance[farthestIndex] = infinity;
+
+        // Trechos (first, last) do anel; last == vertexCount é o vértice 0 de novo
+        struct PendingSection {
+            size_t first;
+            size_t last;
+            double parentImportance;
+        };
+        std::vector<PendingSection> pendingSections;
+        pendingSections.push_back({ 0, farthestIndex, infinity });
+        pendingSections.push_back({ farthestIndex, vertexCount, infinity });
+
+        while (!pendingSections.empty()) {
+            PendingSection section = pendingSections.back();
+            pendingSections.pop_back();
+            if (section.last - section.first < 2) {
+                continue;
+            }
+
+            const Point2D& sectionStart = polygonVertices[section.first];
+            const Point2D& sectionEnd = polygonVertices[section.last % vertexCount];
+            size_t splitIndex = section.first + 1;
+            double splitDistance = -1.0;
+            for (size_t vertexIndex = section.first + 1; vertexIndex < section.last; ++vertexIndex) {
+                double squaredDistance = squaredSegmentDistance(polygonVertices[vertexIndex], sectionStart, sectionEnd);
+                if (squaredDistance > splitDistance) {
+                    splitDistance = squaredDistance;
+                    splitIndex = vertexIndex;
+                }
+            }
+
+            double splitImportance = std::min(std::sqrt(splitDistance), section.parentImportance);
+            importance[splitIndex] = splitImportance;
+            pendingSections.push_back({ section.first, splitIndex, splitImportance });
+            pendingSections.push_back({ splitIndex, section.last, splitImportance });
+        }
+
+        keepTriangle(importance);
+    }
+
+    /**
+     * @brief Importância de Visvalingam-Whyatt: área efetiva na ordem de remoção
+     * @param importance Uma entrada por vértice (substituída)
+     *
+     * Remove sempre o vértice de menor triângulo com os vizinhos atuais (fila
+     * de prioridade com entradas vencidas descartadas pela versão) e
+     * recalcula só os dois vizinhos: O(n log n). A importância nunca é menor
+     * que a do vértice removido antes, para que os níveis fiquem aninhados.
+     */
+    static void computeVisvalingamImportance(const std::vector<Point2D>& polygonVertices,
+                                             std::vector<double>& importance) {
+        const size_t vertexCount = polygonVertices.size();
+        const double infinity = std::numeric_limits<double>::infinity();
+        importance.assign(vertexCount, infinity);
+        if (vertexCount <= 3) {
+            return;
+        }
+
+        struct AreaEntry {
+            double area;
+            size_t vertexIndex;
+            unsigned int version;
+
+            bool operator>(const AreaEntry& other) const {
+                return area > other.area || (area == other.area && vertexIndex > other.vertexIndex);
+            }
+        };
+
+        std::vector<size_t> previousVertex(vertexCount);
+        std::vector<size_t> nextVertex(vertexCount);
+        std::vector<unsigned int> versions(vertexCount, 0);
+        std::vector<AreaEntry> initialEntries;
+        initialEntries.reserve(vertexCount);
+        for (size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+            previousVertex[vertexIndex] = (vertexIndex + vertexCount - 1) % vertexCount;
+            nextVertex[vertexIndex] = (vertexIndex + 1) % vertexCount;
+            initialEntries.push_back({ triangleArea(polygonVertices[previousVertex[vertexIndex]],
+                                                    polygonVertices[vertexIndex],
+                                                    polygonVertices[nextVertex[vertexIndex]]),
+                                       vertexIndex, 0 });
+        }
+        std::priority_queue<AreaEntry, std::vector<AreaEntry>, std::greater<AreaEntry> >
+            areaQueue(std::greater<AreaEntry>(), std::move(initialEntries));
+
+        size_t remainingCount = vertexCount;
+        double lastArea = 0.0;
+        while (remainingCount > 3 && !areaQueue.empty()) {
+            AreaEntry entry = areaQueue.top();
+            areaQueue.pop();
+            if (entry.version != versions[entry.vertexIndex] || importance[entry.vertexIndex] != infinity) {
+                continue;
+            }
+
+            lastArea = std::max(lastArea, entry.area);
+            importance[entry.vertexIndex] = lastArea;
+            --remainingCount;
+
+            size_t previous = previousVertex[entry.vertexIndex];
+            size_t next = nextVertex[entry.vertexIndex];
+            nextVertex[previous] = next;
+            previousVertex[next] = previous;
+
+            const size_t neighbours[2] = { previous, next };
+            for (size_t neighbour : neighbours) {
+                ++versions[neighbour];
+                areaQueue.push({ triangleArea(polygonVertices[previousVertex[neighbour]],
+                                              polygonVertices[neighbour],
+                                              polygonVertices[nextVertex[neighbour]]),
+                                 neighbour, versions[neighbour] });
+            }
+        }
+    }
+
+    /**
+     * @brief Copia, em ordem, os vértices com importância acima do limiar
+     */
+    static void selectVertices(const std::vector<Point2D>& polygonVertices, const std::vector<double>& importance,
+                               double threshold, std::vector<Point2D>& selectedVertices) {
+        selectedVertices.clear();
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            if (importance[vertexIndex] > threshold) {
+                selectedVertices.push_back(polygonVertices[vertexIndex]);
+            }
+        }
+    }
+
+    /**
+     * @brief Limiar de importância equivalente a uma tolerância em pixels
+     *
+     * Douglas-Peucker compara distâncias; Visvalingam-Whyatt compara áreas,
+     * com o quadrado da tolerância.
+     */
+    static double thresholdForTolerance(SimplificationMethod method, double tolerancePixels) {
+        return method == SimplificationMethod::DOUGLAS_PEUCKER ? tolerancePixels : tolerancePixels * tolerancePixels;
+    }
+
+    static std::vector<Point2D> simplify(const std::vector<Point2D>& polygonVertices, SimplificationMethod method,
+                                         double tolerancePixels) {
+        std::vector<double> importance;
+        if (method == SimplificationMethod::DOUGLAS_PEUCKER) {
+            computeDouglasPeuckerImportance(polygonVertices, importance);
+        } else {
+            computeVisvalingamImportance(polygonVertices, importance);
+        }
+        std::vector<Point2D> simplifiedVertices;
+        selectVertices(polygonVertices, importance, thresholdForTolerance(method, tolerancePixels), simplifiedVertices);
+        return simplifiedVertices;
+    }
+};
+
+/**
+ * @class PolygonLevelsOfDetail
+ * @brief Níveis de detalhe de um polígono salvo, montados sob demanda
+ *
+ * O nível L tem tolerância minimumTolerance * 2^L pixels; um pedido usa o
+ * maior nível que não passa da tolerância pedida. Em Douglas-Peucker a
+ * tolerância é uma distância, então o erro desenhado nunca excede o pedido;
+ * em Visvalingam-Whyatt ela só limita a área dos triângulos removidos
+ * (tolerância ao quadrado), e um vértice em uma ponta fina pode ficar mais
+ * longe que isso do contorno simplificado. As importâncias de cada método
+ * são calculadas uma vez e cada nível custa um filtro O(n) na primeira vez
+ * que é usado.
+ * Os vértices não ficam guardados aqui (o SavedPolygon mantém os originais
+ * para exportação e operações booleanas) e são passados em cada consulta.
+ */
+class PolygonLevelsOfDetail {
+public:
+    static constexpr double minimumTolerance = 0.25;
+    static constexpr int levelCount = 16;
+    static constexpr size_t minimumVertexCount = 16;    // Abaixo disso o original é sempre usado
+
+private:
+    struct MethodLevels {
+        std::vector<double> importance;
+        std::vector<Point2D> levels[levelCount];
+        bool isLevelBuilt[levelCount];
+        bool isLevelOriginal[levelCount];    // Nenhum vértice removido: devolve o original
+
+        MethodLevels() {
+            std::fill(isLevelBuilt, isLevelBuilt + levelCount, false);
+            std::fill(isLevelOriginal, isLevelOriginal + levelCount, false);
+        }
+    };
+
+    MethodLevels methodLevels[2];
+
+public:
+    /**
+     * @brief Índice do nível para uma tolerância, ou -1 se ela é menor que a do nível 0
+     */
+    static int levelForTolerance(double tolerancePixels) {
+        if (!(tolerancePixels >= minimumTolerance)) {
+            return -1;
+        }
+        int level = static_cast<int>(std::floor(std::log2(tolerancePixels / minimumTolerance)));
+        return std::min(level, levelCount - 1);
+    }
+
+    /**
+     * @brief Vértices do polígono simplificados com tolerância de até tolerancePixels (distância só em Douglas-Peucker)
+     * @param polygonVertices Vértices originais (os mesmos em todas as consultas)
+     */
+    const std::vector<Point2D>& getLevel(const std::vector<Point2D>& polygonVertices, SimplificationMethod method,
+                                         double tolerancePixels) {
+        int level = levelForTolerance(tolerancePixels);
+        if (level < 0 || polygonVertices.size() < minimumVertexCount) {
+            return polygonVertices;
+        }
+
+        MethodLevels& levels = methodLevels[method == SimplificationMethod::DOUGLAS_PEUCKER ? 0 : 1];
+        if (!levels.isLevelBuilt[level]) {
+            if (levels.importance.size() != polygonVertices.size()) {
+                if (method == SimplificationMethod::DOUGLAS_PEUCKER) {
+                    PolygonSimplifier::computeDouglasPeuckerImportance(polygonVertices, levels.importance);
+                } else {
+                    PolygonSimplifier::computeVisvalingamImportance(polygonVertices, levels.importance);
+                }
+            }
+            double threshold = PolygonSimplifier::thresholdForTolerance(method, minimumTolerance * std::ldexp(1.0, level));
+            PolygonSimplifier::selectVertices(polygonVertices, levels.importance, threshold, levels.levels[level]);
+            levels.isLevelOriginal[level] = levels.levels[level].size() == polygonVertices.size();
+            if (levels.isLevelOriginal[level]) {
+                levels.levels[level].clear();
+            }
+            levels.levels[level].shrink_to_fit();
+            levels.isLevelBuilt[level] = true;
+        }
+        return levels.isLevelOriginal[level] ? polygonVertices : levels.levels[level];
+    }
+};
+
+#endif // POLYGON_SIMPLIFICATION_H
@@ -0,0 +1,416 @@
+/**
+ * @file polygon_span_mask.h
+ * @brief Máscara run-length (runs por scanline) dos polígonos salvos, para teste de ponto e estatísticas de área
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef POLYGON_SPAN_MASK_H
+#define POLYGON_SPAN_MASK_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "polygon_manager.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct SpanRun
+ * @brief Run horizontal semiaberto [startX, endX) de uma linha da máscara
+ */
+struct SpanRun {
+    int startX;
+    int endX;    // Exclusivo
+};
+
+/**
+ * @class PolygonSpanMask
+ * @brief Pixels cobertos por um polígono, guardados como runs ordenados por scanline
+ *
+ * A máscara é gerada pela mesma varredura ET/AET do preenchimento, então
+ * contains(x, y) responde exatamente se o pixel (x, y) seria pintado, com
+ * o mesmo modo de arestas e regra de preenchimento do PolygonFillAlgorithm
+ * usado. A varredura não é recortada pela janela (ver
+ * PolygonFillAlgorithm::setClipOrigin), então a área vale para o polígono
+ * inteiro.
+ *
+ * Layout: rowStarts[linha] .. rowStarts[linha + 1] indexa os runs da linha
+ * em runs, ordenados e disjuntos. O teste de ponto é um acesso direto à
+ * linha mais uma busca binária entre os seus runs.
+ */
+class PolygonSpanMask {
+private:
+    int firstScanLine;
+    int minimumX;
+    int maximumX;                          // Exclusivo
+    std::vector<std::uint32_t> rowStarts;  // Uma entrada por linha + sentinela final
+    std::vector<SpanRun> runs;
+    std::uint64_t coveredArea;
+
+    /**
+     * @brief Destino de spans que junta os spans de cada linha em runs ordenados e disjuntos
+     */
+    struct RunBuildingSink {
+        PolygonSpanMask* mask;
+        int firstRowScanLine;      // Scanline da varredura que corresponde à linha 0
+        int currentRow;
+        size_t rowFirstRun;
+        
+        void finishRow() {
+            std::vector<SpanRun>& runs = mask->runs;
+            bool isSorted = std::is_sorted(runs.begin() + rowFirstRun, runs.end(),
+                [](const SpanRun& run1, const SpanRun& run2) { return run1.startX < run2.startX; });
+            if (!isSorted) {
+                std::sort(runs.begin() + rowFirstRun, runs.end(),
+                    [](const SpanRun& run1, const SpanRun& run2) { return run1.startX < run2.startX; });
+            }
+            
+            // Spans que se tocam ou se sobrepõem viram um único run
+            size_t writeIndex = rowFirstRun;
+            for (size_t readIndex = rowFirstRun; readIndex < runs.size(); ++readIndex) {
+                if (writeIndex > rowFirstRun && runs[readIndex].startX <= runs[writeIndex - 1].endX) {
+                    runs[writeIndex - 1].endX = std::max(runs[writeIndex - 1].endX, runs[readIndex].endX);
+                } else {
+                    runs[writeIndex++] = runs[readIndex];
+                }
+            }
+            runs.resize(writeIndex);
+            rowFirstRun = runs.size();
+        }
+        
+        void advanceToRow(int row) {
+            while (currentRow < row) {
+                finishRow();
+                currentRow++;
+                mask->rowStarts.push_back(static_cast<std::uint32_t>(mask->runs.size()));
+            }
+        }
+        
+        void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+            advanceToRow(scanLine - firstRowScanLine);
+            SpanRun run = { startX, endX + 1 };
+            mask->runs.push_back(run);
+        }
+    };
+
+    std::uint64_t sumRunLengths() const {
+        std::uint64_t area = 0;
+        for (const SpanRun& run : runs) {
+            area += static_cast<std::uint64_t>(run.endX - run.startX);
+        }
+        return area;
+    }
+
+public:
+    PolygonSpanMask() : firstScanLine(0), minimumX(0), maximumX(0), coveredArea(0) {}
+
+    /**
+     * @brief Gera a máscara de um polígono
+     * @param polygonVertices Vértices do polígono
+     * @param fillAlgorithm Algoritmo (modo de arestas e regra) igual ao usado no desenho
+     */
+    void build(const std::vector<Point2D>& polygonVertices,
+               const PolygonFillAlgorithm& fillAlgorithm) {
+        runs.clear();
+        rowStarts.clear();
+        coveredArea = 0;
+        firstScanLine = 0;
+        minimumX = 0;
+        maximumX = 0;
+        if (polygonVertices.size() < 3) {
+            return;
+        }
+        
+        int minimumY = polygonVertices[0].coordinateY;
+        int maximumY = polygonVertices[0].coordinateY;
+        minimumX = polygonVertices[0].coordinateX;
+        maximumX = polygonVertices[0].coordinateX;
+        for (const Point2D& vertex : polygonVertices) {
+            minimumX = std::min(minimumX, vertex.coordinateX);
+            maximumX = std::max(maximumX, vertex.coordinateX);
+            minimumY = std::min(minimumY, vertex.coordinateY);
+            maximumY = std::max(maximumY, vertex.coordinateY);
+        }
+        
+        firstScanLine = minimumY;
+        rowStarts.push_back(0);
+        RunBuildingSink buildingSink = { this, minimumY, 0, 0 };
+        PolygonFillAlgorithm scanAlgorithm(fillAlgorithm);
+        
+        // Linhas acima da janela: faixa própria, a partir do topo do polígono
+        if (minimumY < 0) {
+            scanAlgorithm.setClipOrigin(minimumX, minimumY);
+            scanAlgorithm.fillPolygon(polygonVertices, ColorRGB(), std::min(maximumY, 0), 
+                                      maximumX + 1, buildingSink);
+        }
+        
+        // Da scanline 0 para baixo as arestas são avançadas até ela como no
+        // desenho, então os pixels da janela são exatamente os pintados
+        scanAlgorithm.setClipOrigin(minimumX, 0);
+        scanAlgorithm.fillPolygon(polygonVertices, ColorRGB(), maximumY, maximumX + 1, buildingSink);
+        buildingSink.advanceToRow(maximumY - minimumY);
+        
+        runs.shrink_to_fit();
+        rowStarts.shrink_to_fit();
+        maximumX++;
+        coveredArea = sumRunLengths();
+    }
+
+    /**
+     * @brief true se o pixel (x, y) é pintado pelo preenchimento do polígono
+     */
+    bool contains(int x, int y) const {
+        int row = y - firstScanLine;
+        if (row < 0 || row >= getRowCount() || x < minimumX || x >= maximumX) {
+            return false;
+        }
+        
+        const SpanRun* rowBegin = runs.data() + rowStarts[row];
+        const SpanRun* rowEnd = runs.data() + rowStarts[row + 1];
+        const SpanRun* nextRun = std::upper_bound(rowBegin, rowEnd, x,
+            [](int value, const SpanRun& run) { return value < run.startX; });
+        return nextRun != rowBegin && x < (nextRun - 1)->endX;
+    }
+
+    /**
+     * @brief Número de pixels cobertos (calculado na geração)
+     */
+    std::uint64_t getArea() const {
+        return coveredArea;
+    }
+
+    /**
+     * @brief Número de pixels cobertos ao mesmo tempo pelas duas máscaras
+     *
+     * Percorre só as linhas comuns, intercalando os runs de cada linha.
+     */
+    static std::uint64_t computeOverlapArea(const PolygonSpanMask& first, const PolygonSpanMask& second) {
+        if (first.maximumX <= second.minimumX || second.maximumX <= first.minimumX) {
+            return 0;
+        }
+        
+        int firstRow = std::max(first.firstScanLine, second.firstScanLine);
+        int endRow = std::min(first.firstScanLine + first.getRowCount(), second.firstScanLine + second.getRowCount());
+        std::uint64_t overlapArea = 0;
+        
+        for (int scanLine = firstRow; scanLine < endRow; ++scanLine) {
+            const SpanRun* firstRun = first.getRowBegin(scanLine);
+            const SpanRun* firstEnd = first.getRowEnd(scanLine);
+            const SpanRun* secondRun = second.getRowBegin(scanLine);
+            const SpanRun* secondEnd = second.getRowEnd(scanLine);
+            
+            while (firstRun != firstEnd && secondRun != secondEnd) {
+                int overlapStart = std::max(firstRun->startX, secondRun->startX);
+                int overlapEnd = std::min(firstRun->endX, secondRun->endX);
+                if (overlapStart < overlapEnd) {
+                    overlapArea += static_cast<std::uint64_t>(overlapEnd - overlapStart);
+                }
+                
+                if (firstRun->endX < secondRun->endX) {
+                    ++firstRun;
+                } else {
+                    ++secondRun;
+                }
+            }
+        }
+        
+        return overlapArea;
+    }
+
+    /**
+     * @brief Primeira scanline da máscara e número de linhas
+     */
+    int getFirstScanLine() const { return firstScanLine; }
+    int getRowCount() const { return rowStarts.empty() ? 0 : static_cast<int>(rowStarts.size()) - 1; }
+
+    /**
+     * @brief Caixa envolvente em x, [minimumX, maximumX)
+     */
+    int getMinimumX() const { return minimumX; }
+    int getMaximumX() const { return maximumX; }
+
+    /**
+     * @brief Runs da scanline (intervalo vazio fora da máscara)
+     */
+    const SpanRun* getRowBegin(int scanLine) const {
+        int row = scanLine - firstScanLine;
+        return (row < 0 || row >= getRowCount()) ? runs.data() : runs.data() + rowStarts[row];
+    }
+
+    const SpanRun* getRowEnd(int scanLine) const {
+        int row = scanLine - firstScanLine;
+        return (row < 0 || row >= getRowCount()) ? runs.data() : runs.data() + rowStarts[row + 1];
+    }
+
+    size_t getRunCount() const {
+        return runs.size();
+    }
+
+    /**
+     * @brief Memória ocupada pelos runs e pelo índice de linhas
+     */
+    size_t getMemoryBytes() const {
+        return runs.capacity() * sizeof(SpanRun) + rowStarts.capacity() * sizeof(std::uint32_t);
+    }
+};
+
+/**
+ * @class PolygonHitTester
+ * @brief Mantém uma PolygonSpanMask por polígono salvo preenchido e responde qual polígono está sob um ponto
+ *
+ * Como no PolygonRasterCache, as máscaras são indexadas por polygonId: só
+ * polígonos novos (ou que passaram a ser preenchidos) geram máscara, e
+ * remover ou reordenar polígonos não refaz as demais. Polígonos sem
+ * preenchimento não são selecionáveis pelo interior. As máscaras não
+ * dependem do tamanho da janela; alterações nos modos do
+ * PolygonFillAlgorithm exigem invalidate(). Se a lista não mudou desde a
+ * última consulta, a consulta só percorre as caixas envolventes do topo
+ * para baixo, guardadas em sequência, e faz a busca binária apenas nos
+ * polígonos cuja caixa contém o ponto.
+ */
+class PolygonHitTester {
+private:
+    struct MaskEntry {
+        PolygonSpanMask mask;
+        size_t lastSynchronization;
+        
+        MaskEntry() : lastSynchronization(0) {}
+    };
+
+    /**
+     * @brief Caixa envolvente de um polígono preenchido, na ordem de pintura
+     */
+    struct HitCandidate {
+        int polygonIndex;
+        int minimumX;
+        int maximumX;         // Exclusivo
+        int firstScanLine;
+        int endScanLine;      // Exclusivo
+        const PolygonSpanMask* mask;
+    };
+
+    std::unordered_map<unsigned int, MaskEntry> entries;    // Por polygonId
+    std::vector<HitCandidate> candidates;
+    std::vector<unsigned int> synchronizedIds;    // polygonId por posição na última sincronização, 0 se sem preenchimento
+    size_t rebuildCount;
+    size_t synchronizationCount;
+
+public:
+    PolygonHitTester() : rebuildCount(0), synchronizationCount(0) {}
+
+    /**
+     * @brief Descarta todas as máscaras
+     */
+    void invalidate() {
+        entries.clear();
+        candidates.clear();
+        synchronizedIds.clear();
+    }
+
+    /**
+     * @brief true se a lista tem os mesmos polígonos preenchidos, na mesma ordem, da última sincronização
+     */
+    bool isSynchronized(const std::vector<PolygonManager::SavedPolygon>& savedPolygons) const {
+        if (savedPolygons.size() != synchronizedIds.size()) {
+            return false;
+        }
+        for (size_t polygonIndex = 0; polygonIndex < savedPolygons.size(); ++polygonIndex) {
+            const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[polygonIndex];
+            if (synchronizedIds[polygonIndex] != (savedPolygon.isFilled ? savedPolygon.polygonId : 0u)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gera as máscaras que faltam e refaz a lista de caixas na ordem de pintura
+     */
+    void synchronize(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                     const PolygonFillAlgorithm& fillAlgorithm) {
+        if (isSynchronized(savedPolygons)) {
+            return;
+        }
+        
+        ++synchronizationCount;
+        candidates.clear();
+        synchronizedIds.assign(savedPolygons.size(), 0u);
+        
+        for (size_t polygonIndex = 0; polygonIndex < savedPolygons.size(); ++polygonIndex) {
+            const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[polygonIndex];
+            if (!savedPolygon.isFilled) {
+                continue;
+            }
+            synchronizedIds[polygonIndex] = savedPolygon.polygonId;
+            
+            auto insertion = entries.emplace(savedPolygon.polygonId, MaskEntry());
+            MaskEntry& entry = insertion.first->second;
+            if (insertion.second) {
+                entry.mask.build(savedPolygon.vertices, fillAlgorithm);
+                rebuildCount++;
+            }
+            entry.lastSynchronization = synchronizationCount;
+            
+            if (entry.mask.getRunCount() > 0) {
+                HitCandidate candidate = { static_cast<int>(polygonIndex), 
+                                           entry.mask.getMinimumX(), entry.mask.getMaximumX(),
+                                           entry.mask.getFirstScanLine(), 
+                                           entry.mask.getFirstScanLine() + entry.mask.getRowCount(),
+                                           &entry.mask };
+                candidates.push_back(candidate);
+            }
+        }
+        
+        // Referências a elementos do unordered_map sobrevivem às remoções dos demais
+        if (entries.size() > candidates.size()) {
+            for (auto entryIterator = entries.begin(); entryIterator != entries.end();) {
+                entryIterator = (entryIterator->second.lastSynchronization != synchronizationCount) 
+                    ? entries.erase(entryIterator) : std::next(entryIterator);
+            }
+        }
+    }
+
+    /**
+     * @brief Índice do polígono salvo preenchido mais acima que cobre o pixel (x, y), ou -1
+     * @param savedPolygons Polígonos salvos, em ordem de pintura
+     * @param fillAlgorithm Algoritmo usado para gerar as máscaras que faltam
+     */
+    int findPolygonAt(const std::vector<PolygonManager::SavedPolygon>& savedPolygons,
+                      const PolygonFillAlgorithm& fillAlgorithm,
+                      int x, int y) {
+        synchronize(savedPolygons, fillAlgorithm);
+        
+        for (size_t candidateIndex = candidates.size(); candidateIndex > 0; --candidateIndex) {
+            const HitCandidate& candidate = candidates[candidateIndex - 1];
+            if (x < candidate.minimumX || x >= candidate.maximumX || 
+                y < candidate.firstScanLine || y >= candidate.endScanLine) {
+                continue;
+            }
+            if (candidate.mask->contains(x, y)) {
+                return candidate.polygonIndex;
+            }
+        }
+        
+        return -1;
+    }
+
+    /**
+     * @brief Máscara do polígono salvo com o polygonId indicado, ou nullptr se ele não tem máscara
+     */
+    const PolygonSpanMask* findMask(unsigned int polygonId) const {
+        auto entryIterator = entries.find(polygonId);
+        return (entryIterator == entries.end()) ? nullptr : &entryIterator->second.mask;
+    }
+
+    /**
+     * @brief Número de máscaras geradas desde a criação
+     */
+    size_t getRebuildCount() const {
+        return rebuildCount;
+    }
+};
+
+#endif // POLYGON_SPAN_MASK_H
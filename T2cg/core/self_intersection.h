@@ -0,0 +1,438 @@
+/**
+ * @file self_intersection.h
+ * @brief Detecção de autointerseções de polígonos por varredura (Bentley-Ottmann)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SELF_INTERSECTION_H
+#define SELF_INTERSECTION_H
+
+#include "data_structures.h"
+#include "polygon_boolean.h"
+#include "sweep_events.h"
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <set>
+#include <vector>
+
+/**
+ * @struct SelfIntersection
+ * @brief Ponto onde duas arestas não consecutivas do polígono se tocam
+ *
+ * A aresta i vai do vértice i ao vértice (i + 1) % n. Sobreposições
+ * colineares aparecem com os dois extremos do trecho comum.
+ */
+struct SelfIntersection {
+    double coordinateX;
+    double coordinateY;
+    size_t firstEdge;     // Menor índice de aresta
+    size_t secondEdge;
+
+    bool operator<(const SelfIntersection& other) const {
+        if (firstEdge != other.firstEdge) return firstEdge < other.firstEdge;
+        if (secondEdge != other.secondEdge) return secondEdge < other.secondEdge;
+        if (coordinateX != other.coordinateX) return coordinateX < other.coordinateX;
+        return coordinateY < other.coordinateY;
+    }
+
+    bool operator==(const SelfIntersection& other) const {
+        return firstEdge == other.firstEdge && secondEdge == other.secondEdge &&
+               coordinateX == other.coordinateX && coordinateY == other.coordinateY;
+    }
+};
+
+/**
+ * @class SelfIntersectionSweep
+ * @brief Encontra as interseções entre arestas de um polígono em O((n + k) log n)
+ *
+ * Mesma varredura da divisão em PolygonBooleanSweep: eventos de extremo
+ * esquerdo e direito em ordem de x, y, linha de varredura em std::set e
+ * teste de interseção só entre arestas vizinhas. Os extremos das arestas são
+ * ordenados uma vez em um vetor e só os eventos criados por divisões passam
+ * pela fila de prioridade, que fica vazia em polígonos simples. Cada
+ * contato divide as arestas envolvidas no ponto racional exato, sem
+ * arredondar, e todas as comparações usam a aresta original como suporte;
+ * assim as partes nunca trocam de ordem na linha e toda aresta que toca um
+ * ponto tem um evento nele. Cada parte guarda as arestas originais do seu
+ * trecho; os pares com evento no mesmo ponto são relatados, exceto o vértice
+ * comum de duas arestas consecutivas.
+ *
+ * Um polígono simples custa uma varredura O(n log n) sem divisões, o que
+ * permite fazer a verificação a cada fechamento mesmo com 10^5 arestas. Os
+ * predicados são exatos para coordenadas de até 2^25; as coordenadas
+ * relatadas são o ponto exato convertido para double.
+ */
+class SelfIntersectionSweep {
+private:
+    struct RunReference {
+        size_t runIndex;    // Trecho colinear de origem (partes divididas mantêm o índice)
+    };
+
+    typedef BasicSweepEvent<RunReference> SweepEvent;
+    typedef BasicSweepOrder<SweepEvent> SweepOrder;
+    typedef SweepOrder::EventQueueOrder EventQueueOrder;
+    typedef SweepOrder::SegmentOrder SegmentOrder;
+    typedef std::set<SweepEvent*, SegmentOrder> SweepLine;
+
+    /**
+     * @brief Trecho de reta entre extremos inteiros coberto pelas mesmas arestas
+     *
+     * As partes divididas de um trecho guardam o seu índice e têm o trecho
+     * como aresta de suporte dos eventos.
+     */
+    struct CollinearRun {
+        Point2D left;
+        Point2D right;
+        size_t firstEdge;    // Arestas originais sobre o trecho: runEdges[firstEdge, endEdge)
+        size_t endEdge;
+    };
+
+    struct ToggleEdge {
+        size_t edgeIndex;
+        bool isStart;
+    };
+
+    typedef BasicLineToggle<ToggleEdge> LineToggle;
+
+    std::deque<SweepEvent> eventStorage;
+    std::vector<SweepEvent*> sortedEvents;    // Extremos das arestas, ordenados uma vez
+    std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventQueueOrder> eventQueue;    // Só eventos de divisões
+    SweepLine sweepLine;
+    std::vector<SweepLine::iterator> sweepPositions;    // Posição de cada evento esquerdo na linha, por eventId
+    std::vector<CollinearRun> collinearRuns;
+    std::vector<size_t> runEdges;
+    std::vector<size_t> nextEdge;                       // Próxima aresta não degenerada, por índice de aresta
+    std::vector<Point2D> edgeEnds;                      // Vértice final de cada aresta
+    std::vector<SelfIntersection>* output;
+
+    SweepEvent* createEvent(const ExactSweepPoint& point, bool isLeft, size_t runIndex, SweepEvent* otherEvent) {
+        SweepEvent event;
+        event.point = point;
+        event.otherEvent = otherEvent;
+        event.supportLeft = collinearRuns[runIndex].left;
+        event.supportRight = collinearRuns[runIndex].right;
+        event.eventId = eventStorage.size();
+        event.runIndex = runIndex;
+        event.isLeft = isLeft;
+        eventStorage.push_back(event);
+        return &eventStorage.back();
+    }
+
+    /**
+     * @brief Divide a parte do evento esquerdo em point, estritamente entre os seus extremos
+     */
+    void divideSegment(SweepEvent* leftEvent, const ExactSweepPoint& point) {
+        SweepEvent* rightOfLeftPart = createEvent(point, false, leftEvent->runIndex, leftEvent);
+        SweepEvent* leftOfRightPart = createEvent(point, true, leftEvent->runIndex, leftEvent->otherEvent);
+
+        leftEvent->otherEvent->otherEvent = leftOfRightPart;
+        leftEvent->otherEvent = rightOfLeftPart;
+
+        eventQueue.push(leftOfRightPart);
+        eventQueue.push(rightOfLeftPart);
+    }
+
+    /**
+     * @brief Ponto de contato de duas partes de aresta, calculado sobre os trechos originais
+     * @return false se os trechos não se tocam ou o contato fica fora de uma das partes
+     *
+     * O teste usa orientações exatas sobre extremos inteiros, um toque em um
+     * extremo devolve o próprio extremo e o ponto de um cruzamento próprio é
+     * racional exato. Trechos de mesma reta são disjuntos depois de
+     * resolveCollinearEdges, então colineares só se tocam em um extremo.
+     */
+    bool findIntersection(const SweepEvent* le1, const SweepEvent* le2, ExactSweepPoint& intersection) const {
+        if (le1->runIndex == le2->runIndex) {
+            return false;
+        }
+        const CollinearRun* run1 = &collinearRuns[le1->runIndex];
+        const CollinearRun* run2 = &collinearRuns[le2->runIndex];
+
+        const Point2D& a0 = run1->left;
+        const Point2D& a1 = run1->right;
+        const Point2D& b0 = run2->left;
+        const Point2D& b1 = run2->right;
+
+        int orientationB0 = exactOrientation(a0, a1, b0);
+        int orientationB1 = exactOrientation(a0, a1, b1);
+        int orientationA0 = exactOrientation(b0, b1, a0);
+        int orientationA1 = exactOrientation(b0, b1, a1);
+
+        if (orientationB0 == 0 && orientationB1 == 0) {
+            if (a1 == b0 || b1 == a0) {
+                intersection = ExactSweepPoint::fromPoint(a1 == b0 ? a1 : a0);
+            } else {
+                return false;
+            }
+        } else {
+            if (orientationB0 * orientationB1 > 0 || orientationA0 * orientationA1 > 0) {
+                return false;
+            }
+            if (orientationB0 == 0) {
+                intersection = ExactSweepPoint::fromPoint(b0);
+            } else if (orientationB1 == 0) {
+                intersection = ExactSweepPoint::fromPoint(b1);
+            } else if (orientationA0 == 0) {
+                intersection = ExactSweepPoint::fromPoint(a0);
+            } else if (orientationA1 == 0) {
+                intersection = ExactSweepPoint::fromPoint(a1);
+            } else {
+                intersection = exactLineIntersection(a0, a1, b0, b1);
+            }
+        }
+
+        return le1->containsInRange(intersection) && le2->containsInRange(intersection);
+    }
+
+    void addSegment(const Point2D& start, const Point2D& end, const std::vector<size_t>& edges) {
+        CollinearRun run;
+        run.left = start;
+        run.right = end;
+        run.firstEdge = runEdges.size();
+        runEdges.insert(runEdges.end(), edges.begin(), edges.end());
+        run.endEdge = runEdges.size();
+        collinearRuns.push_back(run);
+        SweepEvent* leftEvent = createEvent(ExactSweepPoint::fromPoint(start), true, collinearRuns.size() - 1, nullptr);
+        SweepEvent* rightEvent = createEvent(ExactSweepPoint::fromPoint(end), false, collinearRuns.size() - 1, leftEvent);
+        leftEvent->otherEvent = rightEvent;
+        sortedEvents.push_back(leftEvent);
+        sortedEvents.push_back(rightEvent);
+    }
+
+    /**
+     * @brief Quebra as arestas de cada reta de suporte em trechos disjuntos
+     *
+     * Os extremos são percorridos com BasicLineToggle::forEachPosition, como
+     * em PolygonBooleanSweep::resolveCollinearEdges. Cada trecho vira um
+     * segmento da varredura com a lista de arestas que o cobrem, então arestas
+     * sobrepostas não precisam ser divididas em ponto flutuante e um
+     * cruzamento com o trecho atinge todas elas de uma vez.
+     */
+    void resolveCollinearEdges(std::vector<LineToggle>& toggles) {
+        std::vector<size_t> activeEdges;
+        Point2D intervalStart;
+        LineToggle::forEachPosition(toggles, [&](std::vector<LineToggle>::const_iterator first,
+                                                 std::vector<LineToggle>::const_iterator last) {
+            if (!activeEdges.empty()) {
+                addSegment(intervalStart, first->point, activeEdges);
+            }
+
+            for (std::vector<LineToggle>::const_iterator toggle = first; toggle != last; ++toggle) {
+                if (toggle->isStart) {
+                    activeEdges.push_back(toggle->edgeIndex);
+                } else {
+                    activeEdges.erase(std::find(activeEdges.begin(), activeEdges.end(), toggle->edgeIndex));
+                }
+            }
+            intervalStart = first->point;
+        });
+    }
+
+    /**
+     * @brief true se o ponto é só o vértice compartilhado por duas arestas consecutivas
+     */
+    bool isSharedVertex(size_t edgeA, size_t edgeB, const ExactSweepPoint& point) const {
+        if (nextEdge[edgeA] == edgeB) {
+            return point == ExactSweepPoint::fromPoint(edgeEnds[edgeA]);
+        }
+        if (nextEdge[edgeB] == edgeA) {
+            return point == ExactSweepPoint::fromPoint(edgeEnds[edgeB]);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Relata cada par de arestas diferentes com extremo no mesmo ponto da varredura
+     */
+    void reportEventPoint(const ExactSweepPoint& point, std::vector<size_t>& pointEdges) {
+        std::sort(pointEdges.begin(), pointEdges.end());
+        pointEdges.erase(std::unique(pointEdges.begin(), pointEdges.end()), pointEdges.end());
+        SweepPoint coordinates = point.toSweepPoint();
+        for (size_t firstIndex = 0; firstIndex < pointEdges.size(); ++firstIndex) {
+            for (size_t secondIndex = firstIndex + 1; secondIndex < pointEdges.size(); ++secondIndex) {
+                if (isSharedVertex(pointEdges[firstIndex], pointEdges[secondIndex], point)) {
+                    continue;
+                }
+                SelfIntersection intersection;
+                intersection.coordinateX = coordinates.x;
+                intersection.coordinateY = coordinates.y;
+                intersection.firstEdge = pointEdges[firstIndex];
+                intersection.secondEdge = pointEdges[secondIndex];
+                output->push_back(intersection);
+            }
+        }
+        pointEdges.clear();
+    }
+
+    /**
+     * @brief Divide duas arestas vizinhas na linha de varredura onde elas se tocam
+     *
+     * Depois da divisão toda aresta que passa por um ponto de contato tem um
+     * extremo nele, e o encontro é relatado ao processar os eventos do ponto.
+     */
+    void handlePossibleIntersection(SweepEvent* le1, SweepEvent* le2) {
+        ExactSweepPoint intersection = ExactSweepPoint();
+        if (!findIntersection(le1, le2, intersection)) {
+            return;
+        }
+        if (le1->point != intersection && le1->otherEvent->point != intersection) {
+            divideSegment(le1, intersection);
+        }
+        if (le2->point != intersection && le2->otherEvent->point != intersection) {
+            divideSegment(le2, intersection);
+        }
+    }
+
+    SweepLine::iterator previousOf(SweepLine::iterator position) {
+        if (position == sweepLine.begin()) {
+            return sweepLine.end();
+        }
+        return --position;
+    }
+
+    void sweep() {
+        // Eventos de um mesmo ponto saem juntos da fila, inclusive os criados por divisões nele
+        ExactSweepPoint eventPoint = ExactSweepPoint();
+        std::vector<size_t> pointEdges;
+        std::sort(sortedEvents.begin(), sortedEvents.end(), [](const SweepEvent* e1, const SweepEvent* e2) {
+            return SweepOrder::isProcessedAfter(e2, e1);
+        });
+        size_t sortedIndex = 0;
+        while (sortedIndex < sortedEvents.size() || !eventQueue.empty()) {
+            SweepEvent* event;
+            if (eventQueue.empty() ||
+                (sortedIndex < sortedEvents.size() && !SweepOrder::isProcessedAfter(sortedEvents[sortedIndex], eventQueue.top()))) {
+                event = sortedEvents[sortedIndex++];
+            } else {
+                event = eventQueue.top();
+                eventQueue.pop();
+            }
+            if (!pointEdges.empty() && event->point != eventPoint) {
+                reportEventPoint(eventPoint, pointEdges);
+            }
+            eventPoint = event->point;
+            const CollinearRun& run = collinearRuns[event->runIndex];
+            pointEdges.insert(pointEdges.end(), runEdges.begin() + run.firstEdge, runEdges.begin() + run.endEdge);
+
+            if (event->isLeft) {
+                SweepLine::iterator position = sweepLine.insert(event).first;
+                if (sweepPositions.size() <= event->eventId) {
+                    sweepPositions.resize(eventStorage.size(), sweepLine.end());
+                }
+                sweepPositions[event->eventId] = position;
+                SweepLine::iterator previous = previousOf(position);
+                SweepLine::iterator next = position;
+                ++next;
+
+                if (next != sweepLine.end()) {
+                    handlePossibleIntersection(event, *next);
+                }
+                if (previous != sweepLine.end()) {
+                    handlePossibleIntersection(*previous, event);
+                }
+            } else {
+                // Remove pela posição guardada, como em PolygonBooleanSweep
+                SweepLine::iterator position = sweepPositions[event->otherEvent->eventId];
+                sweepPositions[event->otherEvent->eventId] = sweepLine.end();
+
+                SweepLine::iterator previous = previousOf(position);
+                SweepLine::iterator next = position;
+                ++next;
+                sweepLine.erase(position);
+
+                if (previous != sweepLine.end() && next != sweepLine.end()) {
+                    handlePossibleIntersection(*previous, *next);
+                }
+            }
+        }
+        if (!pointEdges.empty()) {
+            reportEventPoint(eventPoint, pointEdges);
+        }
+        sweepLine.clear();
+        sweepPositions.clear();
+    }
+
+public:
+    SelfIntersectionSweep() : output(nullptr) {}
+
+    /**
+     * @brief Encontra todos os pontos onde arestas do polígono se cruzam, se tocam ou se sobrepõem
+     * @param polygonVertices Polígono fechado implicitamente
+     * @param intersections Interseções encontradas (substituídas), ordenadas por par de arestas
+     * @return true se o polígono é simples (nenhuma interseção)
+     *
+     * Arestas de comprimento zero (vértices repetidos em sequência) são
+     * ignoradas e não quebram a adjacência das vizinhas.
+     */
+    bool findIntersections(const std::vector<Point2D>& polygonVertices, std::vector<SelfIntersection>& intersections) {
+        intersections.clear();
+        const size_t vertexCount = polygonVertices.size();
+        if (vertexCount < 3) {
+            return true;
+        }
+
+        output = &intersections;
+        nextEdge.assign(vertexCount, vertexCount);
+        edgeEnds.resize(vertexCount);
+        eventStorage.clear();
+        collinearRuns.clear();
+        runEdges.clear();
+        sortedEvents.clear();
+        eventQueue = std::priority_queue<SweepEvent*, std::vector<SweepEvent*>, EventQueueOrder>();
+
+        std::vector<LineToggle> toggles;
+        toggles.reserve(2 * vertexCount);
+        size_t firstEdge = vertexCount;
+        size_t previousEdge = vertexCount;
+        for (size_t edgeIndex = 0; edgeIndex < vertexCount; ++edgeIndex) {
+            const Point2D& start = polygonVertices[edgeIndex];
+            const Point2D& end = polygonVertices[(edgeIndex + 1) % vertexCount];
+            edgeEnds[edgeIndex] = end;
+            if (start == end) {
+                continue;
+            }
+            if (previousEdge < vertexCount) {
+                nextEdge[previousEdge] = edgeIndex;
+            } else {
+                firstEdge = edgeIndex;
+            }
+            previousEdge = edgeIndex;
+
+            ToggleEdge leftEnd;
+            leftEnd.edgeIndex = edgeIndex;
+            leftEnd.isStart = true;
+            ToggleEdge rightEnd = leftEnd;
+            rightEnd.isStart = false;
+            LineToggle::appendEdge(start, end, leftEnd, rightEnd, toggles);
+        }
+        if (previousEdge < vertexCount && previousEdge != firstEdge) {
+            nextEdge[previousEdge] = firstEdge;
+        }
+        resolveCollinearEdges(toggles);
+
+        sweep();
+        sortedEvents.clear();
+        eventStorage.clear();
+        collinearRuns.clear();
+        runEdges.clear();
+        output = nullptr;
+
+        // O mesmo par volta a ser vizinho depois de uma divisão
+        std::sort(intersections.begin(), intersections.end());
+        intersections.erase(std::unique(intersections.begin(), intersections.end()), intersections.end());
+        return intersections.empty();
+    }
+
+    /**
+     * @brief Divide o polígono em peças sem cruzamentos que cobrem a mesma região par-ímpar
+     * @return Um anel por região externa; buracos ficam ligados ao contorno por pontes
+     */
+    static std::vector<std::vector<Point2D> > splitIntoSimplePieces(const std::vector<Point2D>& polygonVertices) {
+        PolygonBooleanSweep booleanSweep;
+        return booleanSweep.compute(polygonVertices, std::vector<Point2D>(), BooleanOperation::UNION);
+    }
+};
+
+#endif // SELF_INTERSECTION_H
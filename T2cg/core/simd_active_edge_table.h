@@ -0,0 +1,203 @@
+/**
+ * @file simd_active_edge_table.h
+ * @brief AET em layout de estrutura de arrays (SoA) com avanço vetorizado
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SIMD_ACTIVE_EDGE_TABLE_H
+#define SIMD_ACTIVE_EDGE_TABLE_H
+
+#include "data_structures.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_ACTIVE_EDGE_TABLE_SSE2
+#endif
+
+/**
+ * @class SoAActiveEdgeTable
+ * @brief AET com as faixas currentX, inverseSlope, maximumY e windingDirection em vetores separados
+ *
+ * O passo currentX += inverseSlope e a busca por arestas expiradas percorrem
+ * faixas contíguas, processadas com AVX2 (4 doubles / 8 ints por instrução)
+ * ou SSE2 (2 doubles / 4 ints) conforme as flags de compilação, com laço
+ * escalar para o restante e para arquiteturas sem SIMD.
+ * As arestas são mantidas ordenadas por currentX (inserção ordenada e
+ * passada de inserção local após cada avanço).
+ */
+class SoAActiveEdgeTable {
+private:
+    std::vector<double> currentXLane;
+    std::vector<double> inverseSlopeLane;
+    std::vector<int> maximumYLane;
+    std::vector<int> windingDirectionLane;
+
+    /**
+     * @brief Índice da primeira aresta com maximumY <= scanLine (ou size() se nenhuma)
+     */
+    size_t findFirstExpired(int scanLine) const {
+        const size_t edgeCount = maximumYLane.size();
+        const int* maximumY = maximumYLane.data();
+        size_t edgeIndex = 0;
+        
+#if defined(__AVX2__)
+        const __m256i scanLineVector = _mm256_set1_epi32(scanLine);
+        for (; edgeIndex + 8 <= edgeCount; edgeIndex += 8) {
+            __m256i maximumYVector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maximumY + edgeIndex));
+            // maximumY > scanLine significa aresta ainda ativa
+            __m256i stillActive = _mm256_cmpgt_epi32(maximumYVector, scanLineVector);
+            if (_mm256_movemask_epi8(stillActive) != -1) {
+                break;
+            }
+        }
+#elif defined(SIMD_ACTIVE_EDGE_TABLE_SSE2)
+        const __m128i scanLineVector = _mm_set1_epi32(scanLine);
+        for (; edgeIndex + 4 <= edgeCount; edgeIndex += 4) {
+            __m128i maximumYVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maximumY + edgeIndex));
+            __m128i stillActive = _mm_cmpgt_epi32(maximumYVector, scanLineVector);
+            if (_mm_movemask_epi8(stillActive) != 0xFFFF) {
+                break;
+            }
+        }
+#endif
+        for (; edgeIndex < edgeCount; ++edgeIndex) {
+            if (maximumY[edgeIndex] <= scanLine) {
+                return edgeIndex;
+            }
+        }
+        
+        return edgeCount;
+    }
+
+public:
+    size_t size() const {
+        return currentXLane.size();
+    }
+
+    bool empty() const {
+        return currentXLane.empty();
+    }
+
+    void clear() {
+        currentXLane.clear();
+        inverseSlopeLane.clear();
+        maximumYLane.clear();
+        windingDirectionLane.clear();
+    }
+
+    double getCurrentX(size_t edgeIndex) const {
+        return currentXLane[edgeIndex];
+    }
+
+    int getWindingDirection(size_t edgeIndex) const {
+        return windingDirectionLane[edgeIndex];
+    }
+
+    /**
+     * @brief Insere uma aresta mantendo a ordenação por currentX
+     */
+    void insert(const EdgeData& edge) {
+        size_t insertIndex = static_cast<size_t>(
+            std::upper_bound(currentXLane.begin(), currentXLane.end(), edge.currentX) - currentXLane.begin());
+        
+        currentXLane.insert(currentXLane.begin() + insertIndex, edge.currentX);
+        inverseSlopeLane.insert(inverseSlopeLane.begin() + insertIndex, edge.inverseSlope);
+        maximumYLane.insert(maximumYLane.begin() + insertIndex, edge.maximumY);
+        windingDirectionLane.insert(windingDirectionLane.begin() + insertIndex, edge.windingDirection);
+    }
+
+    /**
+     * @brief Avança todas as arestas para a próxima scanline (currentX += inverseSlope)
+     */
+    void advance() {
+        const size_t edgeCount = currentXLane.size();
+        double* currentX = currentXLane.data();
+        const double* inverseSlope = inverseSlopeLane.data();
+        size_t edgeIndex = 0;
+        
+#if defined(__AVX2__)
+        for (; edgeIndex + 4 <= edgeCount; edgeIndex += 4) {
+            __m256d xVector = _mm256_loadu_pd(currentX + edgeIndex);
+            __m256d slopeVector = _mm256_loadu_pd(inverseSlope + edgeIndex);
+            _mm256_storeu_pd(currentX + edgeIndex, _mm256_add_pd(xVector, slopeVector));
+        }
+#elif defined(SIMD_ACTIVE_EDGE_TABLE_SSE2)
+        for (; edgeIndex + 2 <= edgeCount; edgeIndex += 2) {
+            __m128d xVector = _mm_loadu_pd(currentX + edgeIndex);
+            __m128d slopeVector = _mm_loadu_pd(inverseSlope + edgeIndex);
+            _mm_storeu_pd(currentX + edgeIndex, _mm_add_pd(xVector, slopeVector));
+        }
+#endif
+        for (; edgeIndex < edgeCount; ++edgeIndex) {
+            currentX[edgeIndex] += inverseSlope[edgeIndex];
+        }
+    }
+
+    /**
+     * @brief Remove as arestas com maximumY <= scanLine, preservando a ordem
+     *
+     * A varredura vetorizada localiza a primeira aresta expirada; na maioria
+     * das scanlines nenhuma expira e a compactação nem começa.
+     */
+    void retire(int scanLine) {
+        const size_t edgeCount = maximumYLane.size();
+        size_t writeIndex = findFirstExpired(scanLine);
+        if (writeIndex == edgeCount) {
+            return;
+        }
+        
+        for (size_t readIndex = writeIndex + 1; readIndex < edgeCount; ++readIndex) {
+            if (maximumYLane[readIndex] > scanLine) {
+                currentXLane[writeIndex] = currentXLane[readIndex];
+                inverseSlopeLane[writeIndex] = inverseSlopeLane[readIndex];
+                maximumYLane[writeIndex] = maximumYLane[readIndex];
+                windingDirectionLane[writeIndex] = windingDirectionLane[readIndex];
+                writeIndex++;
+            }
+        }
+        
+        currentXLane.resize(writeIndex);
+        inverseSlopeLane.resize(writeIndex);
+        maximumYLane.resize(writeIndex);
+        windingDirectionLane.resize(writeIndex);
+    }
+
+    /**
+     * @brief Restaura a ordenação por currentX após o avanço (passada de inserção)
+     */
+    void restoreOrder() {
+        const size_t edgeCount = currentXLane.size();
+        
+        for (size_t edgeIndex = 1; edgeIndex < edgeCount; ++edgeIndex) {
+            if (!(currentXLane[edgeIndex] < currentXLane[edgeIndex - 1])) {
+                continue;
+            }
+            
+            double displacedX = currentXLane[edgeIndex];
+            double displacedSlope = inverseSlopeLane[edgeIndex];
+            int displacedMaximumY = maximumYLane[edgeIndex];
+            int displacedWinding = windingDirectionLane[edgeIndex];
+            size_t targetIndex = edgeIndex;
+            
+            while (targetIndex > 0 && displacedX < currentXLane[targetIndex - 1]) {
+                currentXLane[targetIndex] = currentXLane[targetIndex - 1];
+                inverseSlopeLane[targetIndex] = inverseSlopeLane[targetIndex - 1];
+                maximumYLane[targetIndex] = maximumYLane[targetIndex - 1];
+                windingDirectionLane[targetIndex] = windingDirectionLane[targetIndex - 1];
+                targetIndex--;
+            }
+            
+            currentXLane[targetIndex] = displacedX;
+            inverseSlopeLane[targetIndex] = displacedSlope;
+            maximumYLane[targetIndex] = displacedMaximumY;
+            windingDirectionLane[targetIndex] = displacedWinding;
+        }
+    }
+};
+
+#endif // SIMD_ACTIVE_EDGE_TABLE_H
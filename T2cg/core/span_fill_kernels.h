@@ -0,0 +1,250 @@
+/**
+ * @file span_fill_kernels.h
+ * @brief Kernels vetorizados para preencher uma sequência de pixels (valor constante, cor interpolada ou composição alpha)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SPAN_FILL_KERNELS_H
+#define SPAN_FILL_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SPAN_FILL_KERNELS_SSE2
+#endif
+
+/**
+ * @class SpanFillKernels
+ * @brief Escrita de spans com stores largos alinhados (AVX2 32 bytes / SSE2 16 bytes)
+ *
+ * O kernel é escolhido em tempo de compilação pelo tamanho do PixelType
+ * (8, 16 ou 32 bits). O início do span é escrito pixel a pixel até alinhar
+ * o destino, o miolo com stores alinhados e o final novamente escalar.
+ */
+class SpanFillKernels {
+private:
+#if defined(__AVX2__)
+    typedef __m256i VectorType;
+    static const size_t VECTOR_BYTES = 32;
+
+    static VectorType broadcast(std::uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+    static VectorType broadcast(std::uint16_t value) { return _mm256_set1_epi16(static_cast<short>(value)); }
+    static VectorType broadcast(std::uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+    static void storeAligned(void* destination, VectorType value) {
+        _mm256_store_si256(static_cast<VectorType*>(destination), value);
+    }
+#elif defined(SPAN_FILL_KERNELS_SSE2)
+    typedef __m128i VectorType;
+    static const size_t VECTOR_BYTES = 16;
+
+    static VectorType broadcast(std::uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+    static VectorType broadcast(std::uint16_t value) { return _mm_set1_epi16(static_cast<short>(value)); }
+    static VectorType broadcast(std::uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+    static void storeAligned(void* destination, VectorType value) {
+        _mm_store_si128(static_cast<VectorType*>(destination), value);
+    }
+#endif
+
+public:
+    /**
+     * @brief Escreve pixelCount cópias de value a partir de destination
+     * @tparam PixelType uint8_t, uint16_t ou uint32_t
+     */
+    template <typename PixelType>
+    static void fill(PixelType* destination, size_t pixelCount, PixelType value) {
+        static_assert(sizeof(PixelType) == 1 || sizeof(PixelType) == 2 || sizeof(PixelType) == 4,
+                      "SpanFillKernels suporta pixels de 8, 16 ou 32 bits");
+        
+#if defined(__AVX2__) || defined(SPAN_FILL_KERNELS_SSE2)
+        const size_t pixelsPerVector = VECTOR_BYTES / sizeof(PixelType);
+        
+        // Spans curtos não compensam o alinhamento
+        if (pixelCount >= 2 * pixelsPerVector) {
+            while ((reinterpret_cast<std::uintptr_t>(destination) & (VECTOR_BYTES - 1)) != 0) {
+                *destination++ = value;
+                pixelCount--;
+            }
+            
+            const VectorType broadcastValue = broadcast(value);
+            while (pixelCount >= pixelsPerVector) {
+                storeAligned(destination, broadcastValue);
+                destination += pixelsPerVector;
+                pixelCount -= pixelsPerVector;
+            }
+        }
+#endif
+        while (pixelCount > 0) {
+            *destination++ = value;
+            pixelCount--;
+        }
+    }
+
+    /**
+     * @brief Escreve pixels de 32 bits com três canais interpolados linearmente
+     *
+     * Os canais estão em ponto fixo 16.16 na escala 0 - 255; o canal i vai
+     * para o byte i do pixel e o byte 3 recebe 0xFF. Cada pixel soma
+     * channelStep ao canal; start e start + (pixelCount - 1) * step devem
+     * estar dentro de [0, 256 << 16). O miolo processa 8 (AVX2) ou 4 (SSE2)
+     * pixels por iteração.
+     */
+    static void interpolateRGB32(std::uint32_t* destination, size_t pixelCount,
+                                 const std::int32_t channelStart[3], const std::int32_t channelStep[3]) {
+        std::int32_t channel0 = channelStart[0];
+        std::int32_t channel1 = channelStart[1];
+        std::int32_t channel2 = channelStart[2];
+        
+#if defined(__AVX2__)
+        if (pixelCount >= 8) {
+            const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            __m256i lanes0 = _mm256_add_epi32(_mm256_set1_epi32(channel0),
+                                              _mm256_mullo_epi32(laneIndex, _mm256_set1_epi32(channelStep[0])));
+            __m256i lanes1 = _mm256_add_epi32(_mm256_set1_epi32(channel1),
+                                              _mm256_mullo_epi32(laneIndex, _mm256_set1_epi32(channelStep[1])));
+            __m256i lanes2 = _mm256_add_epi32(_mm256_set1_epi32(channel2),
+                                              _mm256_mullo_epi32(laneIndex, _mm256_set1_epi32(channelStep[2])));
+            const __m256i step0 = _mm256_set1_epi32(channelStep[0] * 8);
+            const __m256i step1 = _mm256_set1_epi32(channelStep[1] * 8);
+            const __m256i step2 = _mm256_set1_epi32(channelStep[2] * 8);
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+            size_t vectorPixels = pixelCount & ~static_cast<size_t>(7);
+            
+            for (size_t pixelIndex = 0; pixelIndex < vectorPixels; pixelIndex += 8) {
+                __m256i pixels = _mm256_or_si256(alpha, _mm256_srli_epi32(lanes0, 16));
+                pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(_mm256_srli_epi32(lanes1, 16), 8));
+                pixels = _mm256_or_si256(pixels, _mm256_slli_epi32(_mm256_srli_epi32(lanes2, 16), 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + pixelIndex), pixels);
+                
+                lanes0 = _mm256_add_epi32(lanes0, step0);
+                lanes1 = _mm256_add_epi32(lanes1, step1);
+                lanes2 = _mm256_add_epi32(lanes2, step2);
+            }
+            
+            destination += vectorPixels;
+            pixelCount -= vectorPixels;
+            channel0 += channelStep[0] * static_cast<std::int32_t>(vectorPixels);
+            channel1 += channelStep[1] * static_cast<std::int32_t>(vectorPixels);
+            channel2 += channelStep[2] * static_cast<std::int32_t>(vectorPixels);
+        }
+#elif defined(SPAN_FILL_KERNELS_SSE2)
+        if (pixelCount >= 4) {
+            __m128i lanes0 = _mm_setr_epi32(channel0, channel0 + channelStep[0],
+                                            channel0 + 2 * channelStep[0], channel0 + 3 * channelStep[0]);
+            __m128i lanes1 = _mm_setr_epi32(channel1, channel1 + channelStep[1],
+                                            channel1 + 2 * channelStep[1], channel1 + 3 * channelStep[1]);
+            __m128i lanes2 = _mm_setr_epi32(channel2, channel2 + channelStep[2],
+                                            channel2 + 2 * channelStep[2], channel2 + 3 * channelStep[2]);
+            const __m128i step0 = _mm_set1_epi32(channelStep[0] * 4);
+            const __m128i step1 = _mm_set1_epi32(channelStep[1] * 4);
+            const __m128i step2 = _mm_set1_epi32(channelStep[2] * 4);
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            size_t vectorPixels = pixelCount & ~static_cast<size_t>(3);
+            
+            for (size_t pixelIndex = 0; pixelIndex < vectorPixels; pixelIndex += 4) {
+                __m128i pixels = _mm_or_si128(alpha, _mm_srli_epi32(lanes0, 16));
+                pixels = _mm_or_si128(pixels, _mm_slli_epi32(_mm_srli_epi32(lanes1, 16), 8));
+                pixels = _mm_or_si128(pixels, _mm_slli_epi32(_mm_srli_epi32(lanes2, 16), 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + pixelIndex), pixels);
+                
+                lanes0 = _mm_add_epi32(lanes0, step0);
+                lanes1 = _mm_add_epi32(lanes1, step1);
+                lanes2 = _mm_add_epi32(lanes2, step2);
+            }
+            
+            destination += vectorPixels;
+            pixelCount -= vectorPixels;
+            channel0 += channelStep[0] * static_cast<std::int32_t>(vectorPixels);
+            channel1 += channelStep[1] * static_cast<std::int32_t>(vectorPixels);
+            channel2 += channelStep[2] * static_cast<std::int32_t>(vectorPixels);
+        }
+#endif
+        while (pixelCount > 0) {
+            *destination++ = 0xFF000000u | static_cast<std::uint32_t>(channel0 >> 16) |
+                             (static_cast<std::uint32_t>(channel1 >> 16) << 8) |
+                             (static_cast<std::uint32_t>(channel2 >> 16) << 16);
+            channel0 += channelStep[0];
+            channel1 += channelStep[1];
+            channel2 += channelStep[2];
+            pixelCount--;
+        }
+    }
+
+    /**
+     * @brief Compõe uma cor pré-multiplicada sobre pixels de 32 bits (operador "over")
+     *
+     * Cada byte do destino vira source + destino * inverseAlpha / 255, com
+     * divisão por 255 exata ((t + 128 + ((t + 128) >> 8)) >> 8). source já
+     * está pré-multiplicado e na ordem de bytes do destino, com o alpha no
+     * byte 3; inverseAlpha = 255 - alpha. O miolo processa 8 (AVX2) ou 4
+     * (SSE2) pixels por iteração, em canais de 16 bits.
+     */
+    static void blendPremultipliedRGBA32(std::uint32_t* destination, size_t pixelCount,
+                                         std::uint32_t premultipliedSource, std::uint32_t inverseAlpha) {
+#if defined(__AVX2__)
+        if (pixelCount >= 8) {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i source = _mm256_set1_epi32(static_cast<int>(premultipliedSource));
+            const __m256i inverse = _mm256_set1_epi16(static_cast<short>(inverseAlpha));
+            const __m256i rounding = _mm256_set1_epi16(128);
+            size_t vectorPixels = pixelCount & ~static_cast<size_t>(7);
+            
+            for (size_t pixelIndex = 0; pixelIndex < vectorPixels; pixelIndex += 8) {
+                __m256i* address = reinterpret_cast<__m256i*>(destination + pixelIndex);
+                __m256i pixels = _mm256_loadu_si256(address);
+                
+                __m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pixels, zero), inverse), rounding);
+                __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pixels, zero), inverse), rounding);
+                low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+                high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+                
+                _mm256_storeu_si256(address, _mm256_adds_epu8(_mm256_packus_epi16(low, high), source));
+            }
+            
+            destination += vectorPixels;
+            pixelCount -= vectorPixels;
+        }
+#elif defined(SPAN_FILL_KERNELS_SSE2)
+        if (pixelCount >= 4) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i source = _mm_set1_epi32(static_cast<int>(premultipliedSource));
+            const __m128i inverse = _mm_set1_epi16(static_cast<short>(inverseAlpha));
+            const __m128i rounding = _mm_set1_epi16(128);
+            size_t vectorPixels = pixelCount & ~static_cast<size_t>(3);
+            
+            for (size_t pixelIndex = 0; pixelIndex < vectorPixels; pixelIndex += 4) {
+                __m128i* address = reinterpret_cast<__m128i*>(destination + pixelIndex);
+                __m128i pixels = _mm_loadu_si128(address);
+                
+                __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), inverse), rounding);
+                __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), inverse), rounding);
+                low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+                high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+                
+                _mm_storeu_si128(address, _mm_adds_epu8(_mm_packus_epi16(low, high), source));
+            }
+            
+            destination += vectorPixels;
+            pixelCount -= vectorPixels;
+        }
+#endif
+        while (pixelCount > 0) {
+            std::uint32_t pixel = *destination;
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                std::uint32_t scaled = ((pixel >> shift) & 0xFF) * inverseAlpha + 128;
+                scaled = (scaled + (scaled >> 8)) >> 8;
+                result |= std::min<std::uint32_t>(255, scaled + ((premultipliedSource >> shift) & 0xFF)) << shift;
+            }
+            *destination++ = result;
+            pixelCount--;
+        }
+    }
+};
+
+#endif // SPAN_FILL_KERNELS_H
@@ -0,0 +1,320 @@
+/**
+ * @file span_shaders.h
+ * @brief Shaders de span (cor sólida, gradientes, padrão e xadrez) passados como parâmetro de template
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SPAN_SHADERS_H
+#define SPAN_SHADERS_H
+
+#include "data_structures.h"
+#include "cpu_framebuffer.h"
+#include "span_fill_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Um shader de span é qualquer tipo com
+ *
+ *     void shadeSpan(PixelType* rowPixels, int scanLine, int startX, int endX) const;
+ *
+ * que escreve os pixels [startX, endX] da linha rowPixels. O tipo do shader
+ * é parâmetro de template do destino (BasicShadedSpanSink), então não há
+ * chamada virtual nem ponteiro de função por pixel. Os valores ao longo de x
+ * são calculados incrementalmente: as divisões e raízes ficam no construtor
+ * (tabelas de cores já empacotadas) ou no início do span.
+ */
+
+/**
+ * @brief Interpola linearmente duas cores (t em [0, 1])
+ */
+inline ColorRGB mixColors(const ColorRGB& startColor, const ColorRGB& endColor, double t) {
+    float weight = static_cast<float>(t);
+    return ColorRGB(startColor.redComponent + (endColor.redComponent - startColor.redComponent) * weight,
+                    startColor.greenComponent + (endColor.greenComponent - startColor.greenComponent) * weight,
+                    startColor.blueComponent + (endColor.blueComponent - startColor.blueComponent) * weight);
+}
+
+/**
+ * @class FlatColorShader
+ * @brief Cor sólida: o span inteiro sai em uma chamada a SpanFillKernels::fill
+ */
+template <typename PixelFormat>
+class FlatColorShader {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+
+private:
+    PixelType packedColor;
+
+public:
+    explicit FlatColorShader(const ColorRGB& color) : packedColor(PixelFormat::pack(color)) {}
+
+    void shadeSpan(PixelType* rowPixels, int, int startX, int endX) const {
+        SpanFillKernels::fill(rowPixels + startX, static_cast<size_t>(endX - startX + 1), packedColor);
+    }
+};
+
+/**
+ * @class LinearGradientShader
+ * @brief Gradiente linear entre dois pontos, com as cores fora do segmento estendidas
+ *
+ * A posição na rampa é uma função afim de (x, y); ela é guardada em ponto
+ * fixo 48.16 em unidades de entrada da tabela e, ao longo do span, avança
+ * com uma soma por pixel. Cada entrada da tabela já está empacotada no
+ * formato do framebuffer.
+ */
+template <typename PixelFormat>
+class LinearGradientShader {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+    static const int RAMP_SIZE = 256;
+
+private:
+    std::vector<PixelType> packedRamp;
+    double rampPerX;          // Entradas da tabela por pixel em x
+    double rampPerY;
+    double rampAtOrigin;      // Posição na tabela no centro do pixel (0, 0)
+
+public:
+    /**
+     * @param startPoint Ponto com startColor (t = 0)
+     * @param endPoint Ponto com endColor (t = 1)
+     */
+    LinearGradientShader(const Point2D& startPoint, const Point2D& endPoint,
+                         const ColorRGB& startColor, const ColorRGB& endColor)
+        : packedRamp(RAMP_SIZE), rampPerX(0.0), rampPerY(0.0), rampAtOrigin(0.0) {
+        for (int entryIndex = 0; entryIndex < RAMP_SIZE; ++entryIndex) {
+            packedRamp[entryIndex] = PixelFormat::pack(
+                mixColors(startColor, endColor, static_cast<double>(entryIndex) / (RAMP_SIZE - 1)));
+        }
+        
+        double deltaX = endPoint.coordinateX - startPoint.coordinateX;
+        double deltaY = endPoint.coordinateY - startPoint.coordinateY;
+        double lengthSquared = deltaX * deltaX + deltaY * deltaY;
+        if (lengthSquared == 0.0) {
+            return;
+        }
+        
+        // t = ((p - start) . (end - start)) / |end - start|^2, escalado para a tabela
+        double scale = (RAMP_SIZE - 1) / lengthSquared;
+        rampPerX = deltaX * scale;
+        rampPerY = deltaY * scale;
+        rampAtOrigin = ((0.5 - startPoint.coordinateX) * deltaX + (0.5 - startPoint.coordinateY) * deltaY) * scale;
+    }
+
+    void shadeSpan(PixelType* rowPixels, int scanLine, int startX, int endX) const {
+        const double fixedScale = 65536.0;
+        // +0.5 entrada: truncar o acumulador arredonda para a entrada mais próxima
+        std::int64_t rampPosition = static_cast<std::int64_t>(
+            std::floor((rampAtOrigin + rampPerX * startX + rampPerY * scanLine + 0.5) * fixedScale));
+        const std::int64_t rampStep = static_cast<std::int64_t>(std::floor(rampPerX * fixedScale + 0.5));
+        const std::int64_t lastEntry = RAMP_SIZE - 1;
+        const PixelType* ramp = packedRamp.data();
+        
+        PixelType* pixel = rowPixels + startX;
+        PixelType* spanEnd = rowPixels + endX + 1;
+        for (; pixel != spanEnd; ++pixel) {
+            std::int64_t entryIndex = std::min(std::max(rampPosition >> 16, std::int64_t(0)), lastEntry);
+            *pixel = ramp[entryIndex];
+            rampPosition += rampStep;
+        }
+    }
+};
+
+/**
+ * @class RadialGradientShader
+ * @brief Gradiente radial: startColor no centro, endColor a partir do raio
+ *
+ * A tabela é indexada pela distância ao quadrado normalizada (d² / r²), com
+ * a raiz embutida na construção da tabela. Ao longo do span d² é um
+ * polinômio de grau 2 em x e avança por diferenças finitas: duas somas por
+ * pixel, sem divisão nem raiz.
+ */
+template <typename PixelFormat>
+class RadialGradientShader {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+    static const int RAMP_SIZE = 4096;
+
+private:
+    std::vector<PixelType> packedRamp;
+    double centerX;
+    double centerY;
+    double rampPerDistanceSquared;
+
+public:
+    RadialGradientShader(const Point2D& center, int radius,
+                         const ColorRGB& startColor, const ColorRGB& endColor)
+        : packedRamp(RAMP_SIZE), centerX(center.coordinateX), centerY(center.coordinateY),
+          rampPerDistanceSquared(0.0) {
+        for (int entryIndex = 0; entryIndex < RAMP_SIZE; ++entryIndex) {
+            double normalizedDistance = std::sqrt(static_cast<double>(entryIndex) / (RAMP_SIZE - 1));
+            packedRamp[entryIndex] = PixelFormat::pack(mixColors(startColor, endColor, normalizedDistance));
+        }
+        
+        if (radius > 0) {
+            rampPerDistanceSquared = (RAMP_SIZE - 1) / (static_cast<double>(radius) * radius);
+        }
+    }
+
+    void shadeSpan(PixelType* rowPixels, int scanLine, int startX, int endX) const {
+        double offsetX = startX + 0.5 - centerX;
+        double offsetY = scanLine + 0.5 - centerY;
+        
+        // +0.5 entrada para que o truncamento arredonde
+        double rampPosition = (offsetX * offsetX + offsetY * offsetY) * rampPerDistanceSquared + 0.5;
+        double rampStep = (2.0 * offsetX + 1.0) * rampPerDistanceSquared;
+        const double rampStepIncrement = 2.0 * rampPerDistanceSquared;
+        const double lastEntry = RAMP_SIZE - 1;
+        const PixelType* ramp = packedRamp.data();
+        
+        PixelType* pixel = rowPixels + startX;
+        PixelType* spanEnd = rowPixels + endX + 1;
+        for (; pixel != spanEnd; ++pixel) {
+            // Arredondamentos acumulados podem deixar a posição levemente negativa no centro
+            *pixel = ramp[static_cast<int>(std::min(std::max(rampPosition, 0.0), lastEntry))];
+            rampPosition += rampStep;
+            rampStep += rampStepIncrement;
+        }
+    }
+};
+
+/**
+ * @class TiledPatternShader
+ * @brief Bitmap repetido em x e y a partir de uma origem
+ *
+ * O texel inicial é calculado uma vez por span (módulo); ao longo do span
+ * basta avançar o índice e voltar a zero no fim da linha do padrão.
+ */
+template <typename PixelFormat>
+class TiledPatternShader {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+
+private:
+    std::vector<PixelType> packedTexels;
+    int patternWidth;
+    int patternHeight;
+    int originX;
+    int originY;
+
+    static int wrap(int value, int period) {
+        int remainder = value % period;
+        return remainder < 0 ? remainder + period : remainder;
+    }
+
+public:
+    /**
+     * @param texels Cores do padrão, linha a linha (width * height)
+     */
+    TiledPatternShader(int width, int height, const std::vector<ColorRGB>& texels,
+                       int patternOriginX = 0, int patternOriginY = 0)
+        : patternWidth(std::max(1, width)), patternHeight(std::max(1, height)),
+          originX(patternOriginX), originY(patternOriginY) {
+        packedTexels.resize(static_cast<size_t>(patternWidth) * patternHeight, PixelFormat::pack(ColorRGB()));
+        size_t texelCount = std::min(packedTexels.size(), texels.size());
+        for (size_t texelIndex = 0; texelIndex < texelCount; ++texelIndex) {
+            packedTexels[texelIndex] = PixelFormat::pack(texels[texelIndex]);
+        }
+    }
+
+    void shadeSpan(PixelType* rowPixels, int scanLine, int startX, int endX) const {
+        const PixelType* patternRow = packedTexels.data() +
+            static_cast<size_t>(wrap(scanLine - originY, patternHeight)) * patternWidth;
+        int texelX = wrap(startX - originX, patternWidth);
+        
+        PixelType* pixel = rowPixels + startX;
+        PixelType* spanEnd = rowPixels + endX + 1;
+        for (; pixel != spanEnd; ++pixel) {
+            *pixel = patternRow[texelX];
+            if (++texelX == patternWidth) {
+                texelX = 0;
+            }
+        }
+    }
+};
+
+/**
+ * @class CheckerboardShader
+ * @brief Xadrez de duas cores com células quadradas
+ *
+ * Dentro de uma célula a cor é constante, então o span é dividido nas
+ * fronteiras das células e cada trecho é escrito com SpanFillKernels::fill.
+ */
+template <typename PixelFormat>
+class CheckerboardShader {
+public:
+    typedef typename PixelFormat::PixelType PixelType;
+
+private:
+    PixelType packedColors[2];
+    int cellSize;
+    int originX;
+    int originY;
+
+    static int floorDivide(int value, int divisor) {
+        int quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+public:
+    CheckerboardShader(int size, const ColorRGB& firstColor, const ColorRGB& secondColor,
+                       int boardOriginX = 0, int boardOriginY = 0)
+        : cellSize(std::max(1, size)), originX(boardOriginX), originY(boardOriginY) {
+        packedColors[0] = PixelFormat::pack(firstColor);
+        packedColors[1] = PixelFormat::pack(secondColor);
+    }
+
+    void shadeSpan(PixelType* rowPixels, int scanLine, int startX, int endX) const {
+        int cellColumn = floorDivide(startX - originX, cellSize);
+        int parity = (cellColumn + floorDivide(scanLine - originY, cellSize)) & 1;
+        int runStart = startX;
+        int runEnd = std::min(originX + (cellColumn + 1) * cellSize - 1, endX);
+        
+        while (runStart <= endX) {
+            SpanFillKernels::fill(rowPixels + runStart, static_cast<size_t>(runEnd - runStart + 1),
+                                  packedColors[parity]);
+            parity ^= 1;
+            runStart = runEnd + 1;
+            runEnd = std::min(runEnd + cellSize, endX);
+        }
+    }
+};
+
+/**
+ * @class BasicShadedSpanSink
+ * @brief Destino de spans que escreve em um BasicCpuFramebuffer através de um shader de span
+ *
+ * A cor recebida em emitSpan é ignorada: os pixels vêm do shader. Com
+ * FlatColorShader o custo é o mesmo do BasicFramebufferSpanSink.
+ */
+template <typename PixelFormat, typename SpanShader>
+class BasicShadedSpanSink {
+private:
+    BasicCpuFramebuffer<PixelFormat>& framebuffer;
+    const SpanShader& spanShader;
+
+public:
+    BasicShadedSpanSink(BasicCpuFramebuffer<PixelFormat>& target, const SpanShader& shader)
+        : framebuffer(target), spanShader(shader) {}
+
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+        if (scanLine < 0 || scanLine >= framebuffer.getHeight()) {
+            return;
+        }
+        
+        startX = std::max(startX, 0);
+        endX = std::min(endX, framebuffer.getWidth() - 1);
+        if (startX > endX) {
+            return;
+        }
+        
+        spanShader.shadeSpan(framebuffer.getRow(scanLine), scanLine, startX, endX);
+    }
+};
+
+#endif // SPAN_SHADERS_H
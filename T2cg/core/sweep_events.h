@@ -0,0 +1,383 @@
+/**
+ * @file sweep_events.h
+ * @brief Eventos, ordens e retas de suporte comuns às varreduras de arestas (booleanas e autointerseções)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SWEEP_EVENTS_H
+#define SWEEP_EVENTS_H
+
+#include "data_structures.h"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+/**
+ * @struct SweepPoint
+ * @brief Ponto da varredura em double, ordenado por x e depois por y
+ */
+struct SweepPoint {
+    double x;
+    double y;
+
+    bool operator==(const SweepPoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const SweepPoint& other) const { return !(*this == other); }
+    bool operator<(const SweepPoint& other) const { return x < other.x || (x == other.x && y < other.y); }
+};
+
+/**
+ * @brief Duas vezes a área com sinal do triângulo (p0, p1, p2); positiva no sentido anti-horário
+ */
+inline double signedArea(const SweepPoint& p0, const SweepPoint& p1, const SweepPoint& p2) {
+    return (p0.x - p2.x) * (p1.y - p2.y) - (p1.x - p2.x) * (p0.y - p2.y);
+}
+
+/**
+ * @struct ExactSweepPoint
+ * @brief Ponto racional exato (numeratorX / denominator, numeratorY / denominator), com denominator > 0
+ *
+ * Extremos de aresta têm denominador 1; o cruzamento de duas arestas de
+ * extremos inteiros tem como denominador o produto vetorial das direções.
+ * Para coordenadas de até 2^25 em módulo, numeradores e produtos cabem em
+ * __int128 e todas as comparações e orientações são exatas, então pontos
+ * que coincidem de fato (três arestas pelo mesmo cruzamento, por exemplo)
+ * são sempre iguais, seja qual for o par de arestas que os calculou.
+ */
+struct ExactSweepPoint {
+    __int128 numeratorX;
+    __int128 numeratorY;
+    long long denominator;
+
+    static ExactSweepPoint fromPoint(const Point2D& point) {
+        ExactSweepPoint exactPoint;
+        exactPoint.numeratorX = point.coordinateX;
+        exactPoint.numeratorY = point.coordinateY;
+        exactPoint.denominator = 1;
+        return exactPoint;
+    }
+
+    /**
+     * @brief Divisão com arredondamento para baixo e resto em [0, divisor)
+     */
+    static __int128 floorDivide(__int128 numerator, long long divisor, __int128& remainder) {
+        __int128 quotient = numerator / divisor;
+        remainder = numerator - quotient * divisor;
+        if (remainder < 0) {
+            --quotient;
+            remainder += divisor;
+        }
+        return quotient;
+    }
+
+    /**
+     * @brief Compara n1 / d1 com n2 / d2 (d1, d2 > 0): -1, 0 ou 1
+     *
+     * As partes inteiras são comparadas primeiro, e os restos (menores que os
+     * denominadores) só então são multiplicados em cruz, sem estourar __int128.
+     */
+    static int compareRatios(__int128 n1, long long d1, __int128 n2, long long d2) {
+        if (d1 == d2) {
+            return (n1 > n2) - (n1 < n2);
+        }
+        // Um dos lados inteiro (o caso comum): o produto cruzado cabe em __int128
+        if (d1 == 1 || d2 == 1) {
+            __int128 cross1 = n1 * d2;
+            __int128 cross2 = n2 * d1;
+            return (cross1 > cross2) - (cross1 < cross2);
+        }
+        __int128 r1 = 0;
+        __int128 r2 = 0;
+        __int128 q1 = floorDivide(n1, d1, r1);
+        __int128 q2 = floorDivide(n2, d2, r2);
+        if (q1 != q2) {
+            return q1 < q2 ? -1 : 1;
+        }
+        __int128 cross1 = r1 * d2;
+        __int128 cross2 = r2 * d1;
+        return (cross1 > cross2) - (cross1 < cross2);
+    }
+
+    /**
+     * @brief Ordem da varredura: -1, 0 ou 1 comparando x e depois y
+     */
+    int compare(const ExactSweepPoint& other) const {
+        int comparison = compareRatios(numeratorX, denominator, other.numeratorX, other.denominator);
+        return comparison != 0 ? comparison
+                               : compareRatios(numeratorY, denominator, other.numeratorY, other.denominator);
+    }
+
+    bool operator==(const ExactSweepPoint& other) const { return compare(other) == 0; }
+    bool operator!=(const ExactSweepPoint& other) const { return compare(other) != 0; }
+    bool operator<(const ExactSweepPoint& other) const { return compare(other) < 0; }
+
+    bool hasSameX(const ExactSweepPoint& other) const {
+        return compareRatios(numeratorX, denominator, other.numeratorX, other.denominator) == 0;
+    }
+
+    bool isBelowPoint(const ExactSweepPoint& other) const {
+        return compareRatios(numeratorY, denominator, other.numeratorY, other.denominator) < 0;
+    }
+
+    bool isIntegral() const {
+        return numeratorX % denominator == 0 && numeratorY % denominator == 0;
+    }
+
+    /**
+     * @brief Ponto inteiro mais próximo (empates para cima)
+     */
+    Point2D rounded() const {
+        __int128 remainder = 0;
+        return Point2D(static_cast<int>(floorDivide(2 * numeratorX + denominator, 2 * denominator, remainder)),
+                       static_cast<int>(floorDivide(2 * numeratorY + denominator, 2 * denominator, remainder)));
+    }
+
+    SweepPoint toSweepPoint() const {
+        SweepPoint point = { static_cast<double>(numeratorX) / static_cast<double>(denominator),
+                             static_cast<double>(numeratorY) / static_cast<double>(denominator) };
+        return point;
+    }
+};
+
+/**
+ * @brief Sinal da área com sinal do triângulo (start, end, p): 1 se p está à esquerda de start -> end
+ */
+inline int exactOrientation(const Point2D& start, const Point2D& end, const Point2D& p) {
+    long long area = (static_cast<long long>(end.coordinateX) - start.coordinateX) *
+                     (static_cast<long long>(p.coordinateY) - start.coordinateY) -
+                     (static_cast<long long>(end.coordinateY) - start.coordinateY) *
+                     (static_cast<long long>(p.coordinateX) - start.coordinateX);
+    return (area > 0) - (area < 0);
+}
+
+inline int exactOrientation(const Point2D& start, const Point2D& end, const ExactSweepPoint& p) {
+    if (p.denominator == 1) {
+        return exactOrientation(start, end, Point2D(static_cast<int>(p.numeratorX), static_cast<int>(p.numeratorY)));
+    }
+    __int128 deltaX = static_cast<long long>(end.coordinateX) - start.coordinateX;
+    __int128 deltaY = static_cast<long long>(end.coordinateY) - start.coordinateY;
+    __int128 offsetX = p.numeratorX - static_cast<__int128>(start.coordinateX) * p.denominator;
+    __int128 offsetY = p.numeratorY - static_cast<__int128>(start.coordinateY) * p.denominator;
+    __int128 area = deltaX * offsetY - deltaY * offsetX;
+    return (area > 0) - (area < 0);
+}
+
+/**
+ * @brief Ponto de cruzamento das retas de suporte de a0-a1 e b0-b1 (não paralelas), exato
+ */
+inline ExactSweepPoint exactLineIntersection(const Point2D& a0, const Point2D& a1, const Point2D& b0, const Point2D& b1) {
+    long long directionAX = static_cast<long long>(a1.coordinateX) - a0.coordinateX;
+    long long directionAY = static_cast<long long>(a1.coordinateY) - a0.coordinateY;
+    long long directionBX = static_cast<long long>(b1.coordinateX) - b0.coordinateX;
+    long long directionBY = static_cast<long long>(b1.coordinateY) - b0.coordinateY;
+    long long offsetX = static_cast<long long>(b0.coordinateX) - a0.coordinateX;
+    long long offsetY = static_cast<long long>(b0.coordinateY) - a0.coordinateY;
+
+    long long denominator = directionAX * directionBY - directionAY * directionBX;
+    long long parameter = offsetX * directionBY - offsetY * directionBX;
+    if (denominator < 0) {
+        denominator = -denominator;
+        parameter = -parameter;
+    }
+
+    ExactSweepPoint point;
+    point.numeratorX = static_cast<__int128>(a0.coordinateX) * denominator + static_cast<__int128>(directionAX) * parameter;
+    point.numeratorY = static_cast<__int128>(a0.coordinateY) * denominator + static_cast<__int128>(directionAY) * parameter;
+    point.denominator = denominator;
+    return point;
+}
+
+/**
+ * @struct BasicSweepEvent
+ * @brief Extremo de uma parte de aresta na varredura
+ * @tparam EventData Dados próprios de cada varredura (paridades, trecho de origem), herdados pelo evento
+ *
+ * Uma aresta dividida vira partes com extremos racionais exatos, e cada
+ * parte guarda a aresta de extremos inteiros que a contém (supportLeft,
+ * supportRight). As orientações usam essa aresta, não os extremos da parte,
+ * então a posição relativa de duas partes não muda com as divisões.
+ */
+template <typename EventData>
+struct BasicSweepEvent : public EventData {
+    ExactSweepPoint point;
+    BasicSweepEvent* otherEvent;    // Outro extremo da parte
+    Point2D supportLeft;            // Aresta original, do extremo esquerdo para o direito
+    Point2D supportRight;
+    size_t eventId;                 // Ordem de criação, critério de desempate
+    bool isLeft;
+
+    /**
+     * @brief true se a aresta passa abaixo de p
+     */
+    bool isBelow(const ExactSweepPoint& p) const {
+        return exactOrientation(supportLeft, supportRight, p) > 0;
+    }
+
+    bool isAbove(const ExactSweepPoint& p) const {
+        return !isBelow(p);
+    }
+
+    /**
+     * @brief true se p está no intervalo (ordem da varredura) da parte
+     */
+    bool containsInRange(const ExactSweepPoint& p) const {
+        const ExactSweepPoint& leftPoint = isLeft ? point : otherEvent->point;
+        const ExactSweepPoint& rightPoint = isLeft ? otherEvent->point : point;
+        return !(p < leftPoint) && !(rightPoint < p);
+    }
+};
+
+/**
+ * @class BasicSweepOrder
+ * @brief Ordem da fila de eventos e da linha de varredura para eventos do tipo Event
+ *
+ * Todas as comparações são exatas, então a linha de varredura nunca recusa
+ * uma parte por ordem inconsistente.
+ */
+template <typename Event>
+class BasicSweepOrder {
+public:
+    /**
+     * @brief Ordem da fila: true se e1 deve ser processado depois de e2
+     */
+    static bool isProcessedAfter(const Event* e1, const Event* e2) {
+        int comparison = e1->point.compare(e2->point);
+        if (comparison != 0) {
+            return comparison > 0;
+        }
+        // Mesmo ponto: extremos direitos antes dos esquerdos
+        if (e1->isLeft != e2->isLeft) {
+            return e1->isLeft;
+        }
+        // Mesmo ponto e mesmo tipo: a aresta de baixo antes
+        int orientation = exactOrientation(e1->supportLeft, e1->supportRight, e2->otherEvent->point);
+        if (orientation != 0) {
+            return orientation < 0;
+        }
+        return e1->eventId > e2->eventId;
+    }
+
+    struct EventQueueOrder {
+        bool operator()(const Event* e1, const Event* e2) const {
+            return isProcessedAfter(e1, e2);
+        }
+    };
+
+    /**
+     * @brief Ordem da linha de varredura (eventos esquerdos): true se a parte de le1 fica abaixo da de le2
+     */
+    struct SegmentOrder {
+        bool operator()(const Event* le1, const Event* le2) const {
+            if (le1 == le2) {
+                return false;
+            }
+
+            int leftOrientation = exactOrientation(le1->supportLeft, le1->supportRight, le2->point);
+            int rightOrientation = exactOrientation(le1->supportLeft, le1->supportRight, le2->otherEvent->point);
+            if (leftOrientation != 0 || rightOrientation != 0) {
+                // Não colineares
+                if (le1->point == le2->point) {
+                    return rightOrientation > 0;
+                }
+                if (le1->point.hasSameX(le2->point)) {
+                    return le1->point.isBelowPoint(le2->point);
+                }
+                // Compara o extremo esquerdo da parte inserida por último com a reta da outra
+                if (isProcessedAfter(le1, le2)) {
+                    return le2->isAbove(le1->point);
+                }
+                return leftOrientation > 0;
+            }
+
+            // Colineares: apenas um critério consistente
+            if (le1->point == le2->point) {
+                return le1->eventId < le2->eventId;
+            }
+            return isProcessedAfter(le1, le2);
+        }
+    };
+};
+
+/**
+ * @struct BasicLineToggle
+ * @brief Extremo de uma aresta na sua reta de suporte (coordenadas inteiras exatas)
+ * @tparam ToggleData Dados próprios de cada varredura (paridade, índice da aresta), herdados pelo extremo
+ *
+ * As arestas são agrupadas pela reta (direção reduzida e deslocamento
+ * inteiros) e cada grupo é percorrido ao longo da reta, de modo que arestas
+ * sobrepostas são resolvidas sem ponto flutuante.
+ */
+template <typename ToggleData>
+struct BasicLineToggle : public ToggleData {
+    long long directionX;    // Direção reduzida pelo mdc, apontando para o extremo direito
+    long long directionY;
+    long long lineOffset;    // Identifica a reta entre as paralelas
+    long long parameter;     // Posição ao longo da reta
+    Point2D point;
+
+    bool isSamePosition(const BasicLineToggle& other) const {
+        return directionX == other.directionX && directionY == other.directionY &&
+               lineOffset == other.lineOffset && parameter == other.parameter;
+    }
+
+    /**
+     * @brief Registra os dois extremos da aresta (start != end) na sua reta de suporte
+     * @param leftData Dados do extremo esquerdo (menor x, depois menor y)
+     * @param rightData Dados do extremo direito
+     */
+    static void appendEdge(Point2D start, Point2D end, const ToggleData& leftData, const ToggleData& rightData,
+                           std::vector<BasicLineToggle>& toggles) {
+        if (end.coordinateX < start.coordinateX ||
+            (end.coordinateX == start.coordinateX && end.coordinateY < start.coordinateY)) {
+            std::swap(start, end);
+        }
+
+        long long deltaX = static_cast<long long>(end.coordinateX) - start.coordinateX;
+        long long deltaY = static_cast<long long>(end.coordinateY) - start.coordinateY;
+        long long divisor = std::gcd(deltaX, deltaY);
+
+        BasicLineToggle toggle;
+        toggle.directionX = deltaX / divisor;
+        toggle.directionY = deltaY / divisor;
+        toggle.lineOffset = toggle.directionX * start.coordinateY - toggle.directionY * start.coordinateX;
+
+        static_cast<ToggleData&>(toggle) = leftData;
+        toggle.point = start;
+        toggle.parameter = toggle.directionX * start.coordinateX + toggle.directionY * start.coordinateY;
+        toggles.push_back(toggle);
+
+        static_cast<ToggleData&>(toggle) = rightData;
+        toggle.point = end;
+        toggle.parameter = toggle.directionX * end.coordinateX + toggle.directionY * end.coordinateY;
+        toggles.push_back(toggle);
+    }
+
+    /**
+     * @brief Ordena os extremos e chama visitPosition(first, last) para cada posição distinta de cada reta
+     *
+     * [first, last) são os extremos que caem na mesma posição, em ordem ao
+     * longo da reta; retas diferentes são visitadas uma depois da outra.
+     */
+    template <typename PositionVisitor>
+    static void forEachPosition(std::vector<BasicLineToggle>& toggles, PositionVisitor visitPosition) {
+        std::sort(toggles.begin(), toggles.end(), [](const BasicLineToggle& a, const BasicLineToggle& b) {
+            if (a.directionX != b.directionX) return a.directionX < b.directionX;
+            if (a.directionY != b.directionY) return a.directionY < b.directionY;
+            if (a.lineOffset != b.lineOffset) return a.lineOffset < b.lineOffset;
+            return a.parameter < b.parameter;
+        });
+
+        size_t toggleIndex = 0;
+        while (toggleIndex < toggles.size()) {
+            size_t nextIndex = toggleIndex + 1;
+            while (nextIndex < toggles.size() && toggles[nextIndex].isSamePosition(toggles[toggleIndex])) {
+                ++nextIndex;
+            }
+            visitPosition(toggles.cbegin() + toggleIndex, toggles.cbegin() + nextIndex);
+            toggleIndex = nextIndex;
+        }
+    }
+};
+
+#endif // SWEEP_EVENTS_H
@@ -0,0 +1,370 @@
+/**
+ * @file sweep_renderer.h
+ * @brief Varredura única de todos os polígonos salvos com eliminação de sobrescrita (overdraw)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef SWEEP_RENDERER_H
+#define SWEEP_RENDERER_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "polygon_manager.h"
+#include "cpu_framebuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct PolygonTaggedEdge
+ * @brief Aresta inteira marcada com o índice do polígono (na ordem de salvamento)
+ */
+struct PolygonTaggedEdge : public FixedEdgeData {
+    int polygonIndex;
+
+    PolygonTaggedEdge(const FixedEdgeData& edge, int polygon) : FixedEdgeData(edge), polygonIndex(polygon) {}
+};
+
+typedef BasicCompactEdgeTable<PolygonTaggedEdge> TaggedCompactEdgeTable;
+
+/**
+ * @struct SweepStatistics
+ * @brief Contadores de escrita de pixels da última varredura
+ */
+struct SweepStatistics {
+    std::uint64_t painterPixelWrites;    // Escritas se cada polígono fosse preenchido por inteiro (pintor)
+    std::uint64_t visiblePixelWrites;    // Escritas efetivas: apenas o polígono do topo de cada span
+    std::uint64_t emittedSpans;
+
+    SweepStatistics() : painterPixelWrites(0), visiblePixelWrites(0), emittedSpans(0) {}
+
+    /**
+     * @brief Quantas vezes, em média, o algoritmo do pintor escreveria cada pixel visível
+     */
+    double overdrawFactor() const {
+        return visiblePixelWrites == 0 ? 0.0 
+            : static_cast<double>(painterPixelWrites) / static_cast<double>(visiblePixelWrites);
+    }
+};
+
+/**
+ * @class ScanlineSweepRenderer
+ * @brief Preenche todos os polígonos salvos em uma única varredura com AET compartilhada
+ *
+ * Todas as arestas entram em uma só ET, marcadas com o índice do polígono.
+ * Em cada scanline a AET ordenada é percorrida da esquerda para a direita
+ * atualizando o estado dentro/fora do polígono de cada aresta pela regra de
+ * preenchimento do algoritmo (paridade em EVEN_ODD, winding em NONZERO); em
+ * cada intervalo entre cruzamentos apenas o polígono interno de maior índice
+ * (o último salvo, que fica por cima) é emitido. Cada pixel é escrito no
+ * máximo uma vez por quadro. Usa as arestas inteiras (INTEGER_DDA), então o
+ * resultado é idêntico ao preenchimento sequencial nesse modo, com a mesma
+ * regra de preenchimento.
+ *
+ * Se o polígono do topo é translúcido, o intervalo emite, de baixo para
+ * cima, o primeiro polígono opaco abaixo dele e todos os translúcidos
+ * internos acima deste, o que preserva a composição do pintor.
+ */
+class ScanlineSweepRenderer {
+private:
+    PolygonFillAlgorithm fillAlgorithm;
+    TaggedCompactEdgeTable edgeTable;
+    FixedCompactEdgeTable polygonEdgeTable;    // Arestas de um polígono antes da marcação
+    std::vector<ColorRGB> polygonColors;
+    std::vector<std::uint8_t> polygonIsOpaque;
+    std::vector<int> visibleStack;             // Polígonos emitidos em um intervalo translúcido, do topo para baixo
+    std::vector<std::uint64_t> insideMask;     // Bit por polígono (1 = dentro)
+    std::vector<int> windingNumbers;           // Winding por polígono (FillRule::NONZERO)
+    int insideCount;
+    int topmostInside;                         // Maior índice com bit ligado, ou -1
+    SweepStatistics lastStatistics;
+
+    /**
+     * @brief Alterna o estado dentro/fora do polígono e mantém o índice do polígono do topo
+     */
+    void togglePolygon(int polygonIndex) {
+        std::uint64_t bit = std::uint64_t(1) << (polygonIndex & 63);
+        std::uint64_t& word = insideMask[polygonIndex >> 6];
+        word ^= bit;
+        
+        if (word & bit) {
+            insideCount++;
+            topmostInside = std::max(topmostInside, polygonIndex);
+            return;
+        }
+        
+        insideCount--;
+        if (polygonIndex != topmostInside) {
+            return;
+        }
+        
+        // O polígono do topo saiu: procura o próximo bit ligado abaixo dele
+        topmostInside = -1;
+        for (int wordIndex = polygonIndex >> 6; wordIndex >= 0 && insideCount > 0; --wordIndex) {
+            std::uint64_t remaining = insideMask[wordIndex];
+            if (wordIndex == (polygonIndex >> 6)) {
+                remaining &= bit - 1;
+            }
+            if (remaining != 0) {
+                int highestBit = 63;
+                while (!(remaining >> highestBit)) {
+                    highestBit--;
+                }
+                topmostInside = wordIndex * 64 + highestBit;
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Aplica o cruzamento da aresta ao polígono dela, conforme a regra de preenchimento
+     *
+     * EVEN_ODD alterna a paridade; NONZERO soma o winding e só muda o estado
+     * quando ele sai de zero ou volta a zero.
+     */
+    void crossEdge(const PolygonTaggedEdge& edge) {
+        if (fillAlgorithm.getFillRule() == FillRule::NONZERO) {
+            int& windingNumber = windingNumbers[edge.polygonIndex];
+            bool wasInside = windingNumber != 0;
+            windingNumber += edge.windingDirection;
+            if (wasInside == (windingNumber != 0)) {
+                return;
+            }
+        }
+        togglePolygon(edge.polygonIndex);
+    }
+
+    /**
+     * @brief Monta a ET compartilhada com as arestas de todos os polígonos preenchidos
+     *
+     * As arestas de cada polígono vêm de PolygonFillAlgorithm::buildFixedEdgeTable
+     * (vértices 24.8 quando existem), que cuida do winding, das arestas
+     * horizontais e do recorte das que ficam fora da janela; aqui elas só
+     * recebem o índice do polígono.
+     */
+    void buildSharedEdgeTable(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, int maxHeight, int maxWidth) {
+        edgeTable.clear();
+        polygonColors.clear();
+        polygonIsOpaque.clear();
+        
+        for (const PolygonManager::SavedPolygon& savedPolygon : savedPolygons) {
+            if (!savedPolygon.isFilled || savedPolygon.vertices.size() < 3) {
+                continue;
+            }
+            
+            int polygonIndex = static_cast<int>(polygonColors.size());
+            polygonColors.push_back(savedPolygon.configuration.fillColor);
+            polygonIsOpaque.push_back(savedPolygon.configuration.fillColor.isOpaque() ? 1 : 0);
+            
+            if (savedPolygon.hasSubpixelGeometry()) {
+                fillAlgorithm.buildFixedEdgeTable(savedPolygon.subpixelVertices, fillAlgorithm.getClipTop(), maxHeight,
+                                                  polygonEdgeTable, maxWidth);
+            } else {
+                fillAlgorithm.buildFixedEdgeTable(savedPolygon.vertices, maxHeight, polygonEdgeTable, maxWidth);
+            }
+            for (const FixedEdgeData& edge : polygonEdgeTable.edges) {
+                PolygonFillAlgorithm::appendCompactEdge(edgeTable, PolygonTaggedEdge(edge, polygonIndex));
+            }
+        }
+        
+        fillAlgorithm.radixSortByMinimumY(edgeTable);
+    }
+
+    /**
+     * @brief Emite o intervalo cujo polígono do topo é translúcido: do opaco mais alto até o topo
+     */
+    template <typename SpanSink>
+    void emitTranslucentInterval(int currentScanLine, int startX, int endX, SpanSink& spanSink) {
+        visibleStack.clear();
+        for (int wordIndex = topmostInside >> 6; wordIndex >= 0; --wordIndex) {
+            std::uint64_t remaining = insideMask[wordIndex];
+            if (wordIndex == (topmostInside >> 6) && (topmostInside & 63) != 63) {
+                remaining &= (std::uint64_t(1) << ((topmostInside & 63) + 1)) - 1;
+            }
+            
+            bool reachedOpaque = false;
+            for (int bitIndex = 63; bitIndex >= 0 && remaining != 0; --bitIndex) {
+                if (!((remaining >> bitIndex) & 1)) {
+                    continue;
+                }
+                remaining &= ~(std::uint64_t(1) << bitIndex);
+                
+                int polygonIndex = wordIndex * 64 + bitIndex;
+                visibleStack.push_back(polygonIndex);
+                if (polygonIsOpaque[polygonIndex]) {
+                    reachedOpaque = true;
+                    break;
+                }
+            }
+            if (reachedOpaque) {
+                break;
+            }
+        }
+        
+        for (size_t stackIndex = visibleStack.size(); stackIndex > 0; --stackIndex) {
+            spanSink.emitSpan(currentScanLine, startX, endX, polygonColors[visibleStack[stackIndex - 1]]);
+            lastStatistics.emittedSpans++;
+        }
+        lastStatistics.visiblePixelWrites += static_cast<std::uint64_t>(endX - startX + 1) * (visibleStack.size() - 1);
+    }
+
+    /**
+     * @brief Resolve uma scanline: emite apenas os spans do polígono visível em cada intervalo
+     */
+    template <typename SpanSink>
+    void resolveScanLine(const std::vector<PolygonTaggedEdge>& activeEdgeTable, 
+                         int currentScanLine, 
+                         int maxWidth,
+                         SpanSink& spanSink) {
+        int pendingPolygon = -1;
+        int pendingStartX = 0;
+        int pendingEndX = -1;
+        
+        auto flushPending = [&]() {
+            if (pendingPolygon >= 0) {
+                spanSink.emitSpan(currentScanLine, pendingStartX, pendingEndX, polygonColors[pendingPolygon]);
+                lastStatistics.emittedSpans++;
+                pendingPolygon = -1;
+            }
+        };
+        
+        size_t edgeIndex = 0;
+        while (edgeIndex < activeEdgeTable.size()) {
+            int crossingX = activeEdgeTable[edgeIndex].currentX;
+            
+            // Aplica todos os cruzamentos nesta mesma posição
+            while (edgeIndex < activeEdgeTable.size() && activeEdgeTable[edgeIndex].currentX == crossingX) {
+                crossEdge(activeEdgeTable[edgeIndex]);
+                edgeIndex++;
+            }
+            
+            if (insideCount == 0 || edgeIndex == activeEdgeTable.size()) {
+                continue;
+            }
+            
+            // Intervalo [crossingX, próximo cruzamento - 1], recortado à janela
+            int startX = std::max(crossingX, 0);
+            int endX = std::min(activeEdgeTable[edgeIndex].currentX - 1, maxWidth - 1);
+            if (startX > endX) {
+                continue;
+            }
+            
+            std::uint64_t intervalWidth = static_cast<std::uint64_t>(endX - startX + 1);
+            lastStatistics.painterPixelWrites += intervalWidth * static_cast<std::uint64_t>(insideCount);
+            lastStatistics.visiblePixelWrites += intervalWidth;
+            
+            int topPolygon = topmostInside;
+            if (!polygonIsOpaque[topPolygon]) {
+                flushPending();
+                emitTranslucentInterval(currentScanLine, startX, endX, spanSink);
+                continue;
+            }
+            
+            if (topPolygon == pendingPolygon && startX == pendingEndX + 1) {
+                pendingEndX = endX;
+            } else {
+                flushPending();
+                pendingPolygon = topPolygon;
+                pendingStartX = startX;
+                pendingEndX = endX;
+            }
+        }
+        
+        flushPending();
+    }
+
+public:
+    ScanlineSweepRenderer() : insideCount(0), topmostInside(-1) {}
+
+    /**
+     * @brief Acesso ao algoritmo para configurar a regra de preenchimento e a ordenação da AET
+     */
+    PolygonFillAlgorithm& getFillAlgorithm() {
+        return fillAlgorithm;
+    }
+
+    /**
+     * @brief Estatísticas de overdraw da última chamada a renderSavedPolygons
+     */
+    const SweepStatistics& getStatistics() const {
+        return lastStatistics;
+    }
+
+    /**
+     * @brief Preenche os polígonos salvos em uma única varredura, com a regra de preenchimento de getFillAlgorithm()
+     * @param savedPolygons Polígonos salvos, em ordem de pintura
+     * @param maxHeight Altura máxima da área de desenho
+     * @param maxWidth Largura máxima da área de desenho
+     * @param spanSink Receptor dos spans visíveis
+     */
+    template <typename SpanSink>
+    void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, 
+                             int maxHeight,
+                             int maxWidth,
+                             SpanSink& spanSink) {
+        lastStatistics = SweepStatistics();
+        buildSharedEdgeTable(savedPolygons, maxHeight, maxWidth);
+        if (edgeTable.edges.empty()) {
+            return;
+        }
+        
+        // Cada aresta é cruzada uma vez por scanline, então paridades e winding voltam a zero sozinhos
+        insideMask.assign((polygonColors.size() + 63) / 64, 0);
+        windingNumbers.assign(polygonColors.size(), 0);
+        insideCount = 0;
+        topmostInside = -1;
+        
+        std::vector<PolygonTaggedEdge>& activeEdgeTable = edgeTable.activeEdges;
+        activeEdgeTable.clear();
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= maxHeight) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() && 
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                fillAlgorithm.insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                nextEdgeIndex++;
+            }
+            
+            resolveScanLine(activeEdgeTable, currentScanLine, maxWidth, spanSink);
+            
+            currentScanLine++;
+            
+            for (PolygonTaggedEdge& edge : activeEdgeTable) {
+                edge.advance();
+            }
+            
+            fillAlgorithm.restoreActiveEdgeOrder(activeEdgeTable);
+            
+            activeEdgeTable.erase(
+                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(), 
+                    [currentScanLine](const PolygonTaggedEdge& edge) { 
+                        return edge.maximumY <= currentScanLine; 
+                    }),
+                activeEdgeTable.end()
+            );
+        }
+    }
+
+    /**
+     * @brief Preenche os polígonos salvos diretamente em um framebuffer de CPU
+     */
+    template <typename PixelFormat>
+    void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, 
+                             BasicCpuFramebuffer<PixelFormat>& framebuffer) {
+        BasicFramebufferSpanSink<PixelFormat> spanSink(framebuffer);
+        renderSavedPolygons(savedPolygons, framebuffer.getHeight(), framebuffer.getWidth(), spanSink);
+    }
+};
+
+#endif // SWEEP_RENDERER_H
@@ -0,0 +1,396 @@
+/**
+ * @file tile_rasterizer.h
+ * @brief Rasterização multithread dos polígonos salvos com binning em tiles (sort-middle)
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef TILE_RASTERIZER_H
+#define TILE_RASTERIZER_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include "polygon_manager.h"
+#include "cpu_framebuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct TileSpan
+ * @brief Trecho de span dentro de uma coluna de tiles, com o polígono de origem
+ */
+struct TileSpan {
+    int scanLine;
+    int startX;
+    int endX;    // Inclusivo
+    std::uint32_t binnedIndex;
+};
+
+/**
+ * @class TileSpanSink
+ * @brief Destino de spans que distribui cada span de uma linha de tiles pelas colunas que ele cruza
+ *
+ * Os trechos entram na lista de cada coluna na ordem de emissão, então a
+ * ordem dos polígonos dentro de cada tile é preservada.
+ */
+class TileSpanSink {
+private:
+    std::vector<std::vector<TileSpan> >& columnSpans;
+    int tileSize;
+    int clipRight;
+    std::uint32_t binnedIndex;
+
+public:
+    TileSpanSink(std::vector<std::vector<TileSpan> >& target, int tileEdge, int maxWidth)
+        : columnSpans(target), tileSize(tileEdge), clipRight(maxWidth - 1), binnedIndex(0) {}
+
+    void setPolygon(std::uint32_t polygonIndex) {
+        binnedIndex = polygonIndex;
+    }
+
+    void emitSpan(int scanLine, int startX, int endX, const ColorRGB&) {
+        startX = std::max(startX, 0);
+        endX = std::min(endX, clipRight);
+        for (int tileColumn = startX / tileSize; startX <= endX; ++tileColumn) {
+            int columnEnd = std::min(endX, (tileColumn + 1) * tileSize - 1);
+            TileSpan span = { scanLine, startX, columnEnd, binnedIndex };
+            columnSpans[tileColumn].push_back(span);
+            startX = columnEnd + 1;
+        }
+    }
+};
+
+/**
+ * @class TileBinnedRasterizer
+ * @brief Preenche os polígonos salvos em duas etapas: binning em tiles e varredura por tile
+ *
+ * 1. Binning: as arestas de cada polígono são distribuídas pelas linhas de
+ *    tiles que cruzam, e o polígono é anotado em cada linha de tiles que a
+ *    sua caixa envolvente toca, na ordem em que foi salvo.
+ * 2. Varredura: os workers pegam linhas de tiles livres e fazem uma única
+ *    passada da AET por polígono da linha, em ordem de salvamento, guardando
+ *    os spans por coluna de tiles. Depois cada tile é escrito de uma vez, com
+ *    os spans na ordem dos polígonos (a sobreposição do pintor é preservada)
+ *    e os seus pixels em L1/L2. Cada linha de tiles é escrita por uma única
+ *    thread, e nenhuma aresta é percorrida mais de uma vez por linha.
+ *
+ * Usa as arestas inteiras (INTEGER_DDA), cuja semeadura no topo do tile é exata;
+ * polígonos importados em 24.8 são varridos a partir de subpixelVertices.
+ */
+class TileBinnedRasterizer {
+private:
+    struct BinnedPolygon {
+        size_t savedIndex;
+        int firstTileRow;
+        bool hasSubpixelGeometry;
+        std::vector<std::vector<EdgeSegment>> rowSegments;
+        std::vector<std::vector<SubpixelEdgeSegment>> rowSubpixelSegments;    // Usado no lugar de rowSegments se hasSubpixelGeometry
+
+        size_t getRowCount() const {
+            return hasSubpixelGeometry ? rowSubpixelSegments.size() : rowSegments.size();
+        }
+
+        bool isRowEmpty(size_t rowOffset) const {
+            return hasSubpixelGeometry ? rowSubpixelSegments[rowOffset].empty() : rowSegments[rowOffset].empty();
+        }
+    };
+
+    PolygonFillAlgorithm fillAlgorithm;
+    int tileSize;
+    unsigned int workerCount;
+    std::vector<BinnedPolygon> binnedPolygons;
+    std::vector<std::vector<std::uint32_t>> tileRowBins;
+    std::vector<FixedCompactEdgeTable> workerEdgeTables;
+    std::vector<std::vector<std::vector<TileSpan>>> workerColumnSpans;    // Por worker, uma lista por coluna de tiles
+
+    /**
+     * @brief Executa task(índice, worker) para todos os índices em [0, taskCount) usando os workers
+     */
+    template <typename Task>
+    void runParallel(int taskCount, Task&& task) const {
+        std::atomic<int> nextTask(0);
+        auto worker = [&](unsigned int workerIndex) {
+            for (int taskIndex = nextTask.fetch_add(1); taskIndex < taskCount; taskIndex = nextTask.fetch_add(1)) {
+                task(taskIndex, workerIndex);
+            }
+        };
+        
+        unsigned int threadCount = std::min(workerCount, static_cast<unsigned int>(std::max(taskCount, 1)));
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (unsigned int threadIndex = 1; threadIndex < threadCount; ++threadIndex) {
+            threads.emplace_back(worker, threadIndex);
+        }
+        worker(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Distribui as arestas de um polígono pelas linhas de tiles que elas cruzam
+     */
+    void binPolygonEdges(const std::vector<Point2D>& polygonVertices, int maxHeight, BinnedPolygon& binned) const {
+        for (std::vector<EdgeSegment>& segments : binned.rowSegments) {
+            segments.clear();
+        }
+        
+        int minimumY = polygonVertices[0].coordinateY;
+        int maximumY = polygonVertices[0].coordinateY;
+        for (const Point2D& vertex : polygonVertices) {
+            minimumY = std::min(minimumY, vertex.coordinateY);
+            maximumY = std::max(maximumY, vertex.coordinateY);
+        }
+        
+        int firstScanLine = std::max(minimumY, 0);
+        int lastScanLine = std::min(maximumY, maxHeight) - 1;
+        if (firstScanLine > lastScanLine) {
+            binned.rowSegments.resize(0);
+            return;
+        }
+        
+        binned.firstTileRow = firstScanLine / tileSize;
+        binned.rowSegments.resize(static_cast<size_t>(lastScanLine / tileSize - binned.firstTileRow + 1));
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const Point2D& currentVertex = polygonVertices[vertexIndex];
+            const Point2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            if (currentVertex.coordinateY == nextVertex.coordinateY) {
+                continue;
+            }
+            
+            EdgeSegment segment = (currentVertex.coordinateY < nextVertex.coordinateY) 
+                ? EdgeSegment(currentVertex, nextVertex, 1) 
+                : EdgeSegment(nextVertex, currentVertex, -1);
+            
+            // A aresta cobre as scanlines [top.y, bottom.y - 1]
+            int segmentFirst = std::max(segment.topVertex.coordinateY, firstScanLine);
+            int segmentLast = std::min(segment.bottomVertex.coordinateY - 1, lastScanLine);
+            for (int tileRow = segmentFirst / tileSize; tileRow <= segmentLast / tileSize && segmentFirst <= segmentLast; ++tileRow) {
+                binned.rowSegments[tileRow - binned.firstTileRow].push_back(segment);
+            }
+        }
+    }
+
+    /**
+     * @brief Versão 24.8 de binPolygonEdges (polígonos importados com subpixelVertices)
+     */
+    void binSubpixelPolygonEdges(const std::vector<SubpixelPoint2D>& polygonVertices, int maxHeight, BinnedPolygon& binned) const {
+        for (std::vector<SubpixelEdgeSegment>& segments : binned.rowSubpixelSegments) {
+            segments.clear();
+        }
+        
+        int minimumY = polygonVertices[0].fixedY;
+        int maximumY = polygonVertices[0].fixedY;
+        for (const SubpixelPoint2D& vertex : polygonVertices) {
+            minimumY = std::min(minimumY, vertex.fixedY);
+            maximumY = std::max(maximumY, vertex.fixedY);
+        }
+        
+        int firstScanLine = std::max(PolygonFillAlgorithm::firstSubpixelScanLine(minimumY), 0);
+        int lastScanLine = std::min(PolygonFillAlgorithm::firstSubpixelScanLine(maximumY), maxHeight) - 1;
+        if (firstScanLine > lastScanLine) {
+            binned.rowSubpixelSegments.resize(0);
+            return;
+        }
+        
+        binned.firstTileRow = firstScanLine / tileSize;
+        binned.rowSubpixelSegments.resize(static_cast<size_t>(lastScanLine / tileSize - binned.firstTileRow + 1));
+        
+        for (size_t vertexIndex = 0; vertexIndex < polygonVertices.size(); ++vertexIndex) {
+            const SubpixelPoint2D& currentVertex = polygonVertices[vertexIndex];
+            const SubpixelPoint2D& nextVertex = polygonVertices[(vertexIndex + 1) % polygonVertices.size()];
+            if (currentVertex.fixedY == nextVertex.fixedY) {
+                continue;
+            }
+            
+            SubpixelEdgeSegment segment = (currentVertex.fixedY < nextVertex.fixedY) 
+                ? SubpixelEdgeSegment(currentVertex, nextVertex, 1) 
+                : SubpixelEdgeSegment(nextVertex, currentVertex, -1);
+            
+            // A aresta cobre as scanlines cujo centro fica em [top.y, bottom.y)
+            int segmentFirst = std::max(PolygonFillAlgorithm::firstSubpixelScanLine(segment.topVertex.fixedY), firstScanLine);
+            int segmentLast = std::min(PolygonFillAlgorithm::firstSubpixelScanLine(segment.bottomVertex.fixedY) - 1, lastScanLine);
+            for (int tileRow = segmentFirst / tileSize; tileRow <= segmentLast / tileSize && segmentFirst <= segmentLast; ++tileRow) {
+                binned.rowSubpixelSegments[tileRow - binned.firstTileRow].push_back(segment);
+            }
+        }
+    }
+
+    /**
+     * @brief Colunas [minimumX, maximumX) que contêm o polígono salvo (pixels inteiros)
+     */
+    static void getHorizontalExtent(const PolygonManager::SavedPolygon& savedPolygon, int& minimumX, int& maximumX) {
+        if (savedPolygon.hasSubpixelGeometry()) {
+            int minimumFixedX = savedPolygon.subpixelVertices[0].fixedX;
+            int maximumFixedX = savedPolygon.subpixelVertices[0].fixedX;
+            for (const SubpixelPoint2D& vertex : savedPolygon.subpixelVertices) {
+                minimumFixedX = std::min(minimumFixedX, vertex.fixedX);
+                maximumFixedX = std::max(maximumFixedX, vertex.fixedX);
+            }
+            minimumX = minimumFixedX >> SubpixelPoint2D::FRACTION_BITS;
+            maximumX = (maximumFixedX + SubpixelPoint2D::ONE_PIXEL - 1) >> SubpixelPoint2D::FRACTION_BITS;
+            return;
+        }
+        
+        minimumX = savedPolygon.vertices[0].coordinateX;
+        maximumX = savedPolygon.vertices[0].coordinateX;
+        for (const Point2D& vertex : savedPolygon.vertices) {
+            minimumX = std::min(minimumX, vertex.coordinateX);
+            maximumX = std::max(maximumX, vertex.coordinateX);
+        }
+    }
+
+public:
+    /**
+     * @param tileEdge Lado do tile em pixels
+     * @param threadCount Número de workers (0 = número de núcleos da máquina)
+     */
+    TileBinnedRasterizer(int tileEdge = 64, unsigned int threadCount = 0) 
+        : tileSize(std::max(8, tileEdge)), workerCount(1) {
+        setWorkerCount(threadCount);
+    }
+
+    /**
+     * @brief Acesso ao algoritmo para configurar ordenação da AET e regra de preenchimento
+     */
+    PolygonFillAlgorithm& getFillAlgorithm() {
+        return fillAlgorithm;
+    }
+
+    /**
+     * @brief Define o número de workers (0 = número de núcleos da máquina)
+     */
+    void setWorkerCount(unsigned int threadCount) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workerCount = threadCount;
+    }
+
+    int getTileSize() const {
+        return tileSize;
+    }
+
+    /**
+     * @brief Preenche todos os polígonos salvos marcados como preenchidos
+     * @param savedPolygons Polígonos salvos, em ordem de pintura
+     * @param framebuffer Framebuffer de destino
+     */
+    template <typename PixelFormat>
+    void renderSavedPolygons(const std::vector<PolygonManager::SavedPolygon>& savedPolygons, 
+                             BasicCpuFramebuffer<PixelFormat>& framebuffer) {
+        const int maxWidth = framebuffer.getWidth();
+        const int maxHeight = framebuffer.getHeight();
+        if (maxWidth <= 0 || maxHeight <= 0) {
+            return;
+        }
+        
+        const int tileColumns = (maxWidth + tileSize - 1) / tileSize;
+        const int tileRows = (maxHeight + tileSize - 1) / tileSize;
+        
+        // Etapa 1a: arestas de cada polígono por linha de tiles (independente por polígono)
+        std::vector<size_t> filledIndices;
+        for (size_t savedIndex = 0; savedIndex < savedPolygons.size(); ++savedIndex) {
+            if (savedPolygons[savedIndex].isFilled && savedPolygons[savedIndex].vertices.size() >= 3) {
+                filledIndices.push_back(savedIndex);
+            }
+        }
+        
+        binnedPolygons.resize(filledIndices.size());
+        runParallel(static_cast<int>(filledIndices.size()), [&](int binnedIndex, unsigned int) {
+            BinnedPolygon& binned = binnedPolygons[binnedIndex];
+            binned.savedIndex = filledIndices[binnedIndex];
+            const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[binned.savedIndex];
+            binned.hasSubpixelGeometry = savedPolygon.hasSubpixelGeometry();
+            if (binned.hasSubpixelGeometry) {
+                binSubpixelPolygonEdges(savedPolygon.subpixelVertices, maxHeight, binned);
+            } else {
+                binPolygonEdges(savedPolygon.vertices, maxHeight, binned);
+            }
+        });
+        
+        // Etapa 1b: listas de polígonos por linha de tiles, em ordem de salvamento
+        tileRowBins.resize(static_cast<size_t>(tileRows));
+        for (std::vector<std::uint32_t>& bin : tileRowBins) {
+            bin.clear();
+        }
+        
+        std::vector<typename PixelFormat::PixelType> packedColors(binnedPolygons.size());
+        std::vector<PremultipliedColor> premultipliedColors(binnedPolygons.size());
+        for (size_t binnedIndex = 0; binnedIndex < binnedPolygons.size(); ++binnedIndex) {
+            const BinnedPolygon& binned = binnedPolygons[binnedIndex];
+            const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[binned.savedIndex];
+            packedColors[binnedIndex] = PixelFormat::pack(savedPolygon.configuration.fillColor);
+            premultipliedColors[binnedIndex] = PremultipliedColor::fromColor(savedPolygon.configuration.fillColor);
+            if (premultipliedColors[binnedIndex].isTransparent()) {
+                continue;
+            }
+            
+            int minimumX = 0;
+            int maximumX = 0;
+            getHorizontalExtent(savedPolygon, minimumX, maximumX);
+            if (std::max(minimumX, 0) > std::min(maximumX, maxWidth) - 1) {
+                continue;
+            }
+            
+            for (size_t rowOffset = 0; rowOffset < binned.getRowCount(); ++rowOffset) {
+                if (!binned.isRowEmpty(rowOffset)) {
+                    tileRowBins[binned.firstTileRow + rowOffset].push_back(static_cast<std::uint32_t>(binnedIndex));
+                }
+            }
+        }
+        
+        // Etapa 2: uma passada por polígono em cada linha de tiles, depois a escrita tile a tile
+        workerEdgeTables.resize(workerCount);
+        workerColumnSpans.resize(workerCount);
+        runParallel(tileRows, [&](int tileRow, unsigned int workerIndex) {
+            const std::vector<std::uint32_t>& bin = tileRowBins[tileRow];
+            if (bin.empty()) {
+                return;
+            }
+            
+            int tileTop = tileRow * tileSize;
+            int tileBottom = std::min(tileTop + tileSize, maxHeight);
+            
+            std::vector<std::vector<TileSpan>>& columnSpans = workerColumnSpans[workerIndex];
+            columnSpans.resize(static_cast<size_t>(tileColumns));
+            for (std::vector<TileSpan>& spans : columnSpans) {
+                spans.clear();
+            }
+            
+            TileSpanSink spanSink(columnSpans, tileSize, maxWidth);
+            FixedCompactEdgeTable& edgeTable = workerEdgeTables[workerIndex];
+            for (std::uint32_t binnedIndex : bin) {
+                const BinnedPolygon& binned = binnedPolygons[binnedIndex];
+                const PolygonManager::SavedPolygon& savedPolygon = savedPolygons[binned.savedIndex];
+                
+                if (binned.hasSubpixelGeometry) {
+                    fillAlgorithm.buildFixedEdgeTable(binned.rowSubpixelSegments[tileRow - binned.firstTileRow], 
+                                                      tileTop, tileBottom, edgeTable);
+                } else {
+                    fillAlgorithm.buildFixedEdgeTable(binned.rowSegments[tileRow - binned.firstTileRow], 
+                                                      tileTop, tileBottom, edgeTable);
+                }
+                spanSink.setPolygon(binnedIndex);
+                fillAlgorithm.scanConvertFixedEdgeTable(edgeTable, savedPolygon.configuration.fillColor, 
+                                                        tileBottom, maxWidth, spanSink);
+            }
+            
+            for (const std::vector<TileSpan>& spans : columnSpans) {
+                for (const TileSpan& span : spans) {
+                    if (premultipliedColors[span.binnedIndex].isOpaque()) {
+                        framebuffer.fillSpan(span.scanLine, span.startX, span.endX, packedColors[span.binnedIndex]);
+                    } else {
+                        framebuffer.blendSpan(span.scanLine, span.startX, span.endX, premultipliedColors[span.binnedIndex]);
+                    }
+                }
+            }
+        });
+    }
+};
+
+#endif // TILE_RASTERIZER_H
@@ -0,0 +1,388 @@
+/**
+ * @file trapezoid_sweep.h
+ * @brief Varredura ET/AET que agrupa spans consecutivos do mesmo par de arestas em trapézios
+ * @author Sistema de Preenchimento ET/AET
+ * @date 2025
+ */
+
+#ifndef TRAPEZOID_SWEEP_H
+#define TRAPEZOID_SWEEP_H
+
+#include "data_structures.h"
+#include "polygon_fill_algorithm.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct TrapezoidCorners
+ * @brief Cantos geométricos de um trapézio (y cresce para baixo, em pixels)
+ */
+struct TrapezoidCorners {
+    double topY;
+    double bottomY;
+    double topLeftX;
+    double topRightX;
+    double bottomLeftX;
+    double bottomRightX;
+};
+
+/**
+ * @struct ScanlineTrapezoid
+ * @brief Registro compacto de um trapézio: faixa de scanlines e o par de arestas
+ *
+ * As arestas são guardadas no estado da primeira scanline, então os spans
+ * podem ser refeitos exatamente com o mesmo DDA inteiro (emitSpans) ou a
+ * geometria pode ser recuperada para desenhar dois triângulos (getCorners).
+ * Cada scanline y em [firstScanLine, lastScanLine] cobre o span
+ * [leftEdge.currentX, rightEdge.currentX - 1], possivelmente vazio.
+ */
+struct ScanlineTrapezoid {
+    int firstScanLine;
+    int lastScanLine;          // Inclusive
+    FixedEdgeData leftEdge;
+    FixedEdgeData rightEdge;
+
+    ScanlineTrapezoid(int scanLine, const FixedEdgeData& left, const FixedEdgeData& right)
+        : firstScanLine(scanLine), lastScanLine(scanLine), leftEdge(left), rightEdge(right) {}
+
+    int getScanLineCount() const {
+        return lastScanLine - firstScanLine + 1;
+    }
+
+    /**
+     * @brief X exato da aresta na altura y, a partir do estado do DDA na scanline edgeScanLine
+     *
+     * A interseção com o centro da scanline vale currentX - errorTerm / D + 0.5
+     * e a inclinação dx/dy vale stepWhole + stepError / D.
+     */
+    static double edgeXAt(const FixedEdgeData& edge, int edgeScanLine, double y) {
+        double denominator = static_cast<double>(edge.errorDenominator);
+        double centerX = edge.currentX - edge.errorTerm / denominator + 0.5;
+        double inverseSlope = edge.stepWhole + edge.stepError / denominator;
+        return centerX + (y - (edgeScanLine + 0.5)) * inverseSlope;
+    }
+
+    /**
+     * @brief Cantos do trapézio cobrindo as linhas de pixels [firstScanLine, lastScanLine + 1)
+     */
+    TrapezoidCorners getCorners() const {
+        TrapezoidCorners corners;
+        corners.topY = firstScanLine;
+        corners.bottomY = lastScanLine + 1;
+        corners.topLeftX = edgeXAt(leftEdge, firstScanLine, corners.topY);
+        corners.topRightX = edgeXAt(rightEdge, firstScanLine, corners.topY);
+        corners.bottomLeftX = edgeXAt(leftEdge, firstScanLine, corners.bottomY);
+        corners.bottomRightX = edgeXAt(rightEdge, firstScanLine, corners.bottomY);
+        return corners;
+    }
+
+    /**
+     * @brief Refaz os spans do trapézio (recortados em [0, maxWidth - 1]) em um destino de spans
+     */
+    template <typename SpanSink>
+    void emitSpans(const ColorRGB& fillColor, int maxWidth, SpanSink& spanSink) const {
+        FixedEdgeData left = leftEdge;
+        FixedEdgeData right = rightEdge;
+        
+        for (int scanLine = firstScanLine; scanLine <= lastScanLine; ++scanLine) {
+            int x1 = std::max(left.currentX, 0);
+            int x2 = std::min(right.currentX - 1, maxWidth - 1);
+            if (x1 <= x2) {
+                spanSink.emitSpan(scanLine, x1, x2, fillColor);
+            }
+            
+            left.advance();
+            right.advance();
+        }
+    }
+};
+
+/**
+ * @class TrapezoidSpanAdapter
+ * @brief Destino de trapézios que repassa os spans equivalentes a um destino de spans
+ *
+ * Permite usar a saída em trapézios com os destinos de CPU existentes
+ * (framebuffer, lotes, contadores) sem mudar o resultado.
+ */
+template <typename SpanSink>
+class TrapezoidSpanAdapter {
+private:
+    SpanSink& spanSink;
+    int maxWidth;
+
+public:
+    TrapezoidSpanAdapter(SpanSink& sink, int width) : spanSink(sink), maxWidth(width) {}
+
+    void emitTrapezoid(const ScanlineTrapezoid& trapezoid, const ColorRGB& fillColor) {
+        trapezoid.emitSpans(fillColor, maxWidth, spanSink);
+    }
+};
+
+/**
+ * @struct TrapezoidEdge
+ * @brief Aresta inteira com identificador estável (posição na ET) para reconhecer pares
+ */
+struct TrapezoidEdge : public FixedEdgeData {
+    int edgeId;
+
+    TrapezoidEdge(const FixedEdgeData& edge, int identifier) : FixedEdgeData(edge), edgeId(identifier) {}
+};
+
+typedef BasicCompactEdgeTable<TrapezoidEdge> TrapezoidEdgeTable;
+
+/**
+ * @class TrapezoidSweep
+ * @brief Varredura ET/AET inteira que emite trapézios em vez de spans
+ *
+ * Em cada scanline os pares de arestas (par-ímpar ou não-zero, conforme a
+ * regra do algoritmo) são os mesmos do INTEGER_DDA. Enquanto a AET não
+ * muda (nenhuma aresta entra, sai ou troca de posição) todos os pares
+ * apenas se estendem; nos eventos, os pares que continuam com as mesmas
+ * duas arestas seguem abertos e só os demais são fechados e emitidos.
+ * O resultado é uma decomposição em trapézios (triangulação barata com
+ * dois triângulos por trapézio) cujos spans são idênticos aos do
+ * INTEGER_DDA.
+ */
+class TrapezoidSweep {
+private:
+    struct OpenTrapezoid {
+        int leftEdgeId;
+        int rightEdgeId;
+        ScanlineTrapezoid trapezoid;
+        
+        OpenTrapezoid(int leftId, int rightId, const ScanlineTrapezoid& openedTrapezoid)
+            : leftEdgeId(leftId), rightEdgeId(rightId), trapezoid(openedTrapezoid) {}
+    };
+
+    PolygonFillAlgorithm fillAlgorithm;
+    FixedCompactEdgeTable fixedEdgeTable;
+    TrapezoidEdgeTable edgeTable;
+    std::vector<OpenTrapezoid> openTrapezoids;
+    std::vector<OpenTrapezoid> nextOpenTrapezoids;
+    std::vector<int> openIndexByLeftEdge;      // Posição em openTrapezoids do par aberto por aresta esquerda
+    std::vector<size_t> scanLinePairs;          // Índices na AET: esquerda, direita, esquerda, ...
+    std::uint64_t emittedTrapezoidCount;
+    std::uint64_t coveredScanLineCount;
+
+    static bool isDegeneratePair(const FixedEdgeData& leftEdge, const FixedEdgeData& rightEdge) {
+        // Duas verticais na mesma coluna (ex.: arestas recolhidas fora da janela) nunca cobrem pixels
+        return leftEdge.currentX == rightEdge.currentX &&
+               leftEdge.stepWhole == 0 && leftEdge.stepError == 0 &&
+               rightEdge.stepWhole == 0 && rightEdge.stepError == 0;
+    }
+
+    /**
+     * @brief Pares de arestas da scanline corrente conforme a regra de preenchimento
+     */
+    void collectScanLinePairs() {
+        const std::vector<TrapezoidEdge>& activeEdgeTable = edgeTable.activeEdges;
+        scanLinePairs.clear();
+        
+        if (fillAlgorithm.getFillRule() == FillRule::NONZERO) {
+            int windingNumber = 0;
+            size_t spanStartIndex = 0;
+            for (size_t edgeIndex = 0; edgeIndex < activeEdgeTable.size(); ++edgeIndex) {
+                int previousWinding = windingNumber;
+                windingNumber += activeEdgeTable[edgeIndex].windingDirection;
+                
+                if (previousWinding == 0) {
+                    spanStartIndex = edgeIndex;
+                } else if (windingNumber == 0) {
+                    scanLinePairs.push_back(spanStartIndex);
+                    scanLinePairs.push_back(edgeIndex);
+                }
+            }
+            return;
+        }
+        
+        for (size_t edgeIndex = 0; edgeIndex + 1 < activeEdgeTable.size(); edgeIndex += 2) {
+            scanLinePairs.push_back(edgeIndex);
+            scanLinePairs.push_back(edgeIndex + 1);
+        }
+    }
+
+    template <typename TrapezoidSink>
+    void closeTrapezoid(OpenTrapezoid& openTrapezoid, int lastScanLine,
+                        const ColorRGB& fillColor, TrapezoidSink& trapezoidSink) {
+        openTrapezoid.trapezoid.lastScanLine = lastScanLine;
+        emittedTrapezoidCount++;
+        coveredScanLineCount += static_cast<std::uint64_t>(openTrapezoid.trapezoid.getScanLineCount());
+        trapezoidSink.emitTrapezoid(openTrapezoid.trapezoid, fillColor);
+    }
+
+    template <typename TrapezoidSink>
+    void closeAllTrapezoids(int lastScanLine, const ColorRGB& fillColor, TrapezoidSink& trapezoidSink) {
+        for (OpenTrapezoid& openTrapezoid : openTrapezoids) {
+            closeTrapezoid(openTrapezoid, lastScanLine, fillColor, trapezoidSink);
+        }
+        openTrapezoids.clear();
+    }
+
+    /**
+     * @brief Após um evento da AET, mantém os pares que continuam e troca os demais
+     *
+     * Os pares ficam ordenados da esquerda para a direita nas duas listas;
+     * um par aberto que reaparece é reconhecido pela aresta esquerda e os
+     * abertos pulados até ele são fechados na scanline anterior.
+     */
+    template <typename TrapezoidSink>
+    void updateOpenTrapezoids(int scanLine, const ColorRGB& fillColor, TrapezoidSink& trapezoidSink) {
+        const std::vector<TrapezoidEdge>& activeEdgeTable = edgeTable.activeEdges;
+        collectScanLinePairs();
+        nextOpenTrapezoids.clear();
+        size_t openIndex = 0;
+        
+        for (size_t pairIndex = 0; pairIndex < scanLinePairs.size(); pairIndex += 2) {
+            const TrapezoidEdge& leftEdge = activeEdgeTable[scanLinePairs[pairIndex]];
+            const TrapezoidEdge& rightEdge = activeEdgeTable[scanLinePairs[pairIndex + 1]];
+            
+            size_t matchIndex = static_cast<size_t>(openIndexByLeftEdge[leftEdge.edgeId]);
+            bool isContinued = matchIndex >= openIndex && matchIndex < openTrapezoids.size() &&
+                               openTrapezoids[matchIndex].leftEdgeId == leftEdge.edgeId &&
+                               openTrapezoids[matchIndex].rightEdgeId == rightEdge.edgeId;
+            
+            if (isContinued) {
+                for (; openIndex < matchIndex; ++openIndex) {
+                    closeTrapezoid(openTrapezoids[openIndex], scanLine - 1, fillColor, trapezoidSink);
+                }
+                nextOpenTrapezoids.push_back(openTrapezoids[matchIndex]);
+                openIndex = matchIndex + 1;
+            } else if (!isDegeneratePair(leftEdge, rightEdge)) {
+                nextOpenTrapezoids.push_back(OpenTrapezoid(leftEdge.edgeId, rightEdge.edgeId,
+                                                           ScanlineTrapezoid(scanLine, leftEdge, rightEdge)));
+            } else {
+                continue;
+            }
+            
+            openIndexByLeftEdge[leftEdge.edgeId] = static_cast<int>(nextOpenTrapezoids.size() - 1);
+        }
+        
+        for (; openIndex < openTrapezoids.size(); ++openIndex) {
+            closeTrapezoid(openTrapezoids[openIndex], scanLine - 1, fillColor, trapezoidSink);
+        }
+        
+        openTrapezoids.swap(nextOpenTrapezoids);
+    }
+
+public:
+    TrapezoidSweep() : emittedTrapezoidCount(0), coveredScanLineCount(0) {}
+
+    /**
+     * @brief Acesso ao algoritmo para escolher a regra de preenchimento e a ordenação da AET
+     */
+    PolygonFillAlgorithm& getFillAlgorithm() {
+        return fillAlgorithm;
+    }
+
+    /**
+     * @brief Trapézios emitidos pela última varredura
+     */
+    std::uint64_t getEmittedTrapezoidCount() const {
+        return emittedTrapezoidCount;
+    }
+
+    /**
+     * @brief Soma das alturas dos trapézios da última varredura (spans equivalentes, inclusive vazios)
+     */
+    std::uint64_t getCoveredScanLineCount() const {
+        return coveredScanLineCount;
+    }
+
+    /**
+     * @brief Varre o polígono e emite um trapézio por intervalo de cada par de arestas
+     * @param trapezoidSink Destino com emitTrapezoid(const ScanlineTrapezoid&, const ColorRGB&)
+     */
+    template <typename TrapezoidSink>
+    void sweepPolygon(const std::vector<Point2D>& polygonVertices,
+                      const ColorRGB& fillColor,
+                      int maxHeight,
+                      int maxWidth,
+                      TrapezoidSink& trapezoidSink) {
+        emittedTrapezoidCount = 0;
+        coveredScanLineCount = 0;
+        
+        if (polygonVertices.size() < 3) {
+            return;
+        }
+        
+        fillAlgorithm.buildFixedEdgeTable(polygonVertices, maxHeight, fixedEdgeTable, maxWidth);
+        if (fixedEdgeTable.edges.empty()) {
+            return;
+        }
+        
+        edgeTable.clear();
+        edgeTable.firstScanLine = fixedEdgeTable.firstScanLine;
+        edgeTable.lastScanLine = fixedEdgeTable.lastScanLine;
+        for (size_t edgeIndex = 0; edgeIndex < fixedEdgeTable.edges.size(); ++edgeIndex) {
+            edgeTable.edges.push_back(TrapezoidEdge(fixedEdgeTable.edges[edgeIndex], static_cast<int>(edgeIndex)));
+        }
+        openIndexByLeftEdge.assign(edgeTable.edges.size(), -1);
+        openTrapezoids.clear();
+        
+        std::vector<TrapezoidEdge>& activeEdgeTable = edgeTable.activeEdges;
+        activeEdgeTable.clear();
+        size_t nextEdgeIndex = 0;
+        int currentScanLine = edgeTable.firstScanLine;
+        bool hasActiveEdgeEvent = false;
+        
+        while (nextEdgeIndex < edgeTable.edges.size() || !activeEdgeTable.empty()) {
+            
+            if (activeEdgeTable.empty()) {
+                currentScanLine = std::max(currentScanLine, edgeTable.edges[nextEdgeIndex].minimumY);
+            }
+            
+            if (currentScanLine >= maxHeight) {
+                break;
+            }
+            
+            while (nextEdgeIndex < edgeTable.edges.size() &&
+                   edgeTable.edges[nextEdgeIndex].minimumY <= currentScanLine) {
+                fillAlgorithm.insertActiveEdge(activeEdgeTable, edgeTable.edges[nextEdgeIndex]);
+                nextEdgeIndex++;
+                hasActiveEdgeEvent = true;
+            }
+            
+            if (hasActiveEdgeEvent) {
+                updateOpenTrapezoids(currentScanLine, fillColor, trapezoidSink);
+                hasActiveEdgeEvent = false;
+            }
+            
+            currentScanLine++;
+            
+            for (TrapezoidEdge& edge : activeEdgeTable) {
+                edge.advance();
+            }
+            
+            bool isStillOrdered = std::is_sorted(activeEdgeTable.begin(), activeEdgeTable.end(),
+                [](const TrapezoidEdge& edge1, const TrapezoidEdge& edge2) {
+                    return edge1.currentX < edge2.currentX;
+                });
+            if (!isStillOrdered) {
+                fillAlgorithm.restoreActiveEdgeOrder(activeEdgeTable);
+                hasActiveEdgeEvent = true;
+            }
+            
+            size_t activeEdgeCount = activeEdgeTable.size();
+            activeEdgeTable.erase(
+                std::remove_if(activeEdgeTable.begin(), activeEdgeTable.end(),
+                    [currentScanLine](const TrapezoidEdge& edge) {
+                        return edge.maximumY <= currentScanLine;
+                    }),
+                activeEdgeTable.end()
+            );
+            if (activeEdgeTable.size() != activeEdgeCount) {
+                hasActiveEdgeEvent = true;
+            }
+            
+            // Sem arestas ativas a próxima scanline pode saltar: fecha tudo aqui
+            if (activeEdgeTable.empty()) {
+                closeAllTrapezoids(currentScanLine - 1, fillColor, trapezoidSink);
+            }
+        }
+        
+        closeAllTrapezoids(currentScanLine - 1, fillColor, trapezoidSink);
+    }
+};
+
+#endif // TRAPEZOID_SWEEP_H
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstring>
 
 // Includes dos módulos (usando 'core')
 #include "core/data_structures.h"
@@ -15,6 +16,7 @@
 #include "core/event_handler.h"
 #include "core/scene_manager.h"
 #include "core/application_context.h"
+#include "core/fill_benchmark.h"
 
 // Variáveis Globais de Shader
 PFNGLCREATESHADERPROC glCreateShader = NULL;
@@ -60,14 +62,15 @@ void display() {
                                             app->polygonManager.isPolygonCurrentlyClosed());
         
         if (app->polygonManager.canBeFilled() && app->applicationState == ApplicationState::POLYGON_FILLED) {
-             app->graphicsRenderer.fillPolygon(app->polygonManager.getVertices(), 
-                                               app->polygonManager.getCurrentFillColor(), 
-                                               app->windowDimensions->height, 
-                                               app->windowDimensions->width);
+            app->graphicsRenderer.fillEditedPolygon(app->polygonManager.getVertices(), 
+                                                    app->polygonManager.getCurrentFillColor(), 
+                                                    app->windowDimensions->height, 
+                                                    app->windowDimensions->width);
         }
         
         app->graphicsRenderer.renderPolygonVertices(app->polygonManager.getVertices(), 
                                                     app->polygonManager.getVisualConfiguration().showVertices);
+        app->graphicsRenderer.renderSelfIntersections(app->polygonManager.getSelfIntersections());
         
         // === RENDERIZA UI NO MODO 2D ===
         app->uiManager.render();
@@ -118,6 +121,7 @@ void reshape(int w, int h) {
         app->eventHandler->updateWindowDimensions(app->windowDimensions);
     }
     
+    app->graphicsRenderer.invalidateRasterCache();
     app->uiManager.updateLayout(w, h);
     glViewport(0, 0, w, h);
     glutPostRedisplay();
@@ -228,6 +232,14 @@ void passiveMotion(int x, int y) {
 }
 
 int main(int argc, char** argv) {
+    // Modo benchmark: mede o preenchimento ET/AET sem abrir janela
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        if (std::strcmp(argv[argIndex], "--benchmark") == 0) {
+            PolygonFillBenchmark().run();
+            return 0;
+        }
+    }
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);